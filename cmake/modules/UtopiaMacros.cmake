@@ -6,6 +6,8 @@ find_package(Boost 1.67 REQUIRED
 
 # --- HDF5 ---
 find_package(HDF5 1.10 REQUIRED COMPONENTS C HL)
+# zlib is used directly for compressing chunks in parallel
+find_package(ZLIB REQUIRED)
 include(RegisterHDF5)
 
 # --- Armadillo ---
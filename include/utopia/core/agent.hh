@@ -177,6 +177,15 @@ public:
         _pos = _pos_new;
     }
 
+    /// Update the position and swap the state buffers
+    /** Like update(), but the state is committed via
+     *  StateContainer::swap_buffers() instead of being copied.
+     */
+    void swap_buffers () {
+        Entity<Self, Traits>::swap_buffers();
+        _pos = _pos_new;
+    }
+
 protected:
     /// Set the position buffer of the (synchronously updated) agent
     /** This function allows befriended classes to set the position of this
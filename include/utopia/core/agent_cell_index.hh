@@ -0,0 +1,236 @@
+#ifndef UTOPIA_CORE_AGENT_CELL_INDEX_HH
+#define UTOPIA_CORE_AGENT_CELL_INDEX_HH
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <boost/range/iterator_range.hpp>
+
+#include "types.hh"
+
+
+namespace Utopia {
+/**
+ * \addtogroup AgentManager
+ * \{
+ */
+
+/// An index relating the agents of an AgentManager to the cells of a
+/// CellManager they are located in
+/** The index stores the agents bucketed by the cell they reside in, with the
+ *  buckets being contiguous in memory. This allows to efficiently query the
+ *  agents within a cell or within the neighborhood of a cell, which is needed
+ *  for models in which agents interact with a cell-based environment.
+ *
+ *  The index is built via a counting sort over the agents, which has linear
+ *  complexity in the number of agents and cells. It is *not* updated
+ *  automatically; call update() after agents were moved, added or removed,
+ *  e.g. once per iteration step after AgentManager::update_agents or
+ *  AgentManager::apply_scheduled_changes. Until then, queries throw, as the
+ *  index detects such changes via AgentManager::num_modifications.
+ *
+ *  \note  Both managers are expected to live in the same physical space. The
+ *         index holds references to the managers, which need to outlive it.
+ *
+ *  \tparam AgentManager  The type of the agent manager
+ *  \tparam CellManager   The type of the cell manager
+ */
+template<class AgentManager, class CellManager>
+class AgentCellIndex {
+public:
+    /// The type of the managed agents
+    using Agent = typename AgentManager::Agent;
+
+    /// The type of the managed cells
+    using Cell = typename CellManager::Cell;
+
+    /// The type of the container holding the bucketed agents
+    using BucketContainer = AgentContainer<Agent>;
+
+    /// The type of the range of agents within a single cell
+    using AgentRange =
+        boost::iterator_range<typename BucketContainer::const_iterator>;
+
+private:
+    /// The agent manager
+    const AgentManager& _am;
+
+    /// The cell manager
+    const CellManager& _cm;
+
+    /// The agents, sorted by the ID of the cell they are located in
+    BucketContainer _agents;
+
+    /// For cell ID i, the agents reside in [_offsets[i], _offsets[i+1])
+    std::vector<std::size_t> _offsets;
+
+    /// Buffer for the cell IDs of the agents, in order of the agent manager
+    std::vector<IndexType> _cell_ids;
+
+    /// The number of modifications of the agent manager at the last update
+    std::size_t _num_modifications;
+
+public:
+    /// Construct the index and build it for the current agent positions
+    AgentCellIndex (const AgentManager& am, const CellManager& cm)
+    :
+        _am(am),
+        _cm(cm),
+        _agents(),
+        _offsets(),
+        _cell_ids(),
+        _num_modifications(0)
+    {
+        update();
+    }
+
+    /// Rebuild the index from the current agent positions
+    void update () {
+        const auto& agents = _am.agents();
+        const auto& grid = *_cm.grid();
+        const auto num_cells = _cm.cells().size();
+
+        // Determine the cell of each agent and count the agents per cell
+        _cell_ids.resize(agents.size());
+        _offsets.assign(num_cells + 1, 0);
+
+        for (std::size_t i = 0; i < agents.size(); i++) {
+            _cell_ids[i] = grid.cell_at(agents[i]->position());
+            ++_offsets[_cell_ids[i] + 1];
+        }
+
+        // Compute the bucket offsets as the cumulative sum of the counts
+        for (std::size_t i = 1; i < _offsets.size(); i++) {
+            _offsets[i] += _offsets[i - 1];
+        }
+
+        // Place the agents into their buckets, preserving their order
+        _agents.resize(agents.size());
+        std::vector<std::size_t> insert_pos(_offsets.begin(),
+                                            _offsets.end() - 1);
+        for (std::size_t i = 0; i < agents.size(); i++) {
+            _agents[insert_pos[_cell_ids[i]]++] = agents[i];
+        }
+
+        _num_modifications = _am.num_modifications();
+    }
+
+    /// Whether no agents were moved, added or removed since the last update
+    bool is_up_to_date () const {
+        return _num_modifications == _am.num_modifications();
+    }
+
+    /// The agents located in the cell with the given ID
+    AgentRange agents_in (const IndexType cell_id) const {
+        check_up_to_date();
+        if (cell_id + 1 >= _offsets.size()) {
+            throw std::invalid_argument("Cell ID " + std::to_string(cell_id)
+                + " is out of range of the agent-cell index! Was the index "
+                "built for this cell manager?");
+        }
+        return boost::make_iterator_range(
+            _agents.cbegin() + _offsets[cell_id],
+            _agents.cbegin() + _offsets[cell_id + 1]);
+    }
+
+    /// The agents located in the given cell
+    AgentRange agents_in (const Cell& cell) const {
+        return agents_in(cell.id());
+    }
+
+    /// The agents located in the given cell
+    AgentRange agents_in (const std::shared_ptr<Cell>& cell) const {
+        return agents_in(cell->id());
+    }
+
+    /// The number of agents located in the given cell
+    template<class CellRef>
+    std::size_t num_agents_in (const CellRef& cell) const {
+        return agents_in(cell).size();
+    }
+
+    /// The agents located in the neighboring cells of the given cell
+    /** The neighborhood is the one currently selected in the CellManager.
+     *
+     *  \param cell          The cell whose neighborhood is to be queried
+     *  \param include_cell  Whether to include the agents in `cell` itself
+     */
+    BucketContainer agents_in_neighborhood (const std::shared_ptr<Cell>& cell,
+                                            const bool include_cell = true)
+                                                                        const
+    {
+        BucketContainer nb_agents{};
+        agents_in_neighborhood(cell, nb_agents, include_cell);
+        return nb_agents;
+    }
+
+    /// The agents located in the neighboring cells of the given cell
+    /** Stores the agents in the given container instead of allocating a new
+     *  one, such that repeated queries can reuse its capacity.
+     *
+     *  \param cell          The cell whose neighborhood is to be queried
+     *  \param nb_agents     The container to store the agents in; cleared
+     *                       before
+     *  \param include_cell  Whether to include the agents in `cell` itself
+     */
+    void agents_in_neighborhood (const std::shared_ptr<Cell>& cell,
+                                 BucketContainer& nb_agents,
+                                 const bool include_cell = true) const
+    {
+        nb_agents.clear();
+
+        if (include_cell) {
+            const auto own = agents_in(cell);
+            nb_agents.insert(nb_agents.end(), own.begin(), own.end());
+        }
+
+        for (const auto& nb : _cm.neighbors_of(cell)) {
+            const auto nb_range = agents_in(nb);
+            nb_agents.insert(nb_agents.end(),
+                             nb_range.begin(), nb_range.end());
+        }
+    }
+
+    /// The cell the given agent is located in
+    /** \note  This uses the agent's *current* position, so for agents that
+     *         moved since the last update, the result may differ from the
+     *         bucket the agent is stored in.
+     */
+    const std::shared_ptr<Cell>& cell_of (const Agent& agent) const {
+        return _cm.cell_at(agent.position());
+    }
+
+    /// The cell the given agent is located in
+    const std::shared_ptr<Cell>& cell_of (const std::shared_ptr<Agent>& agent)
+                                                                        const
+    {
+        return cell_of(*agent);
+    }
+
+    /// All agents, sorted by the ID of the cell they are located in
+    const BucketContainer& agents () const {
+        check_up_to_date();
+        return _agents;
+    }
+
+private:
+    /// Throw if agents were moved, added or removed since the last update
+    void check_up_to_date () const {
+        if (not is_up_to_date()) {
+            throw std::runtime_error("The agent-cell index is outdated: "
+                "agents were moved, added or removed since it was last "
+                "updated! Call update() before querying it.");
+        }
+    }
+};
+
+// end group AgentManager
+/**
+ *  \}
+ */
+
+} // namespace Utopia
+
+#endif // UTOPIA_CORE_AGENT_CELL_INDEX_HH
@@ -2,12 +2,20 @@
 #define UTOPIA_CORE_AGENTMANAGER_HH
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "types.hh"
 #include "exceptions.hh"
 #include "agent.hh"
 #include "select.hh"
+#include "space_filling_curves.hh"
 
 namespace Utopia {
 /**
@@ -93,12 +101,36 @@ private:
     /// Storage container for agents
     AgentContainer<Agent> _agents;
 
+    /// Maps agent IDs to their index in the agents container
+    std::unordered_map<IndexType, std::size_t> _agent_idcs;
+
+    /// Agents to be added by the next call to apply_scheduled_changes
+    std::vector<std::pair<AgentState, SpaceVec>> _scheduled_births;
+
+    /// Agents to be removed by the next call to apply_scheduled_changes
+    AgentContainer<Agent> _scheduled_deaths;
+
     /// Function that will be used for moving agents, called by move_* methods
     MoveFunc _move_to_func;
 
     /// Function that will be used to prepare positions for adding an agent
     PosFunc _prepare_pos;
 
+    /// After how many calls to sort_agents_periodically the agents are sorted
+    const IndexType _sort_interval;
+
+    /// The number of spatial bins per dimension used for sorting; 0 for auto
+    const IndexType _sort_num_bins;
+
+    /// The number of calls to sort_agents_periodically so far
+    IndexType _num_sort_calls;
+
+    /// Counts changes of agent positions and of the set of agents
+    /** Mutable, as moving agents does not change the manager itself; atomic,
+     *  as agents may be moved from within parallel rule applications.
+     */
+    mutable std::atomic<std::size_t> _num_modifications;
+
 
 public:
     // -- Constructors --------------------------------------------------------
@@ -126,8 +158,15 @@ public:
         _rng(model.get_rng()),
         _space(model.get_space()),
         _agents(),
+        _agent_idcs(),
+        _scheduled_births(),
+        _scheduled_deaths(),
         _move_to_func(setup_move_to_func()),
-        _prepare_pos(setup_prepare_pos_func())
+        _prepare_pos(setup_prepare_pos_func()),
+        _sort_interval(get_as<IndexType>("sort_interval", _cfg, 0)),
+        _sort_num_bins(get_as<IndexType>("sort_num_bins", _cfg, 0)),
+        _num_sort_calls(0),
+        _num_modifications(0)
     {
         setup_agents();
         _log->info("AgentManager is all set up.");
@@ -152,8 +191,15 @@ public:
         _rng(model.get_rng()),
         _space(model.get_space()),
         _agents(),
+        _agent_idcs(),
+        _scheduled_births(),
+        _scheduled_deaths(),
         _move_to_func(setup_move_to_func()),
-        _prepare_pos(setup_prepare_pos_func())
+        _prepare_pos(setup_prepare_pos_func()),
+        _sort_interval(get_as<IndexType>("sort_interval", _cfg, 0)),
+        _sort_num_bins(get_as<IndexType>("sort_num_bins", _cfg, 0)),
+        _num_sort_calls(0),
+        _num_modifications(0)
     {
         setup_agents(initial_state);
         _log->info("AgentManager is all set up.");
@@ -195,12 +241,32 @@ public:
         return _id_counter;
     }
 
+    /// Whether an agent with the given ID is managed by this manager
+    bool contains_agent (const IndexType id) const {
+        return _agent_idcs.count(id) > 0;
+    }
+
+    /// Return the agent with the given ID
+    /** The lookup is a constant-time operation.
+     *
+     *  \throws std::invalid_argument If there is no agent with this ID
+     */
+    const std::shared_ptr<Agent>& agent_by_id (const IndexType id) const {
+        const auto it = _agent_idcs.find(id);
+
+        if (it == _agent_idcs.end()) {
+            throw std::invalid_argument("There is no agent with ID "
+                + std::to_string(id) + " in this manager!");
+        }
+        return _agents[it->second];
+    }
+
     // -- Public interface ----------------------------------------------------
     /// Move an agent to a new position in the space
     void move_to(const std::shared_ptr<Agent>& agent,
                  const SpaceVec& pos) const
     {
-        _move_to_func(*agent, pos);
+        move_to(*agent, pos);
     }
 
     /// Move an agent to a new position in the space
@@ -208,20 +274,33 @@ public:
                  const SpaceVec& pos) const
     {
         _move_to_func(agent, pos);
+        _num_modifications.fetch_add(1, std::memory_order_relaxed);
     }
 
     /// Move an agent relative to its current position
     void move_by(const std::shared_ptr<Agent>& agent,
                  const SpaceVec& move_vec) const
     {
-        _move_to_func(*agent, agent->position() + move_vec);
+        move_to(*agent, agent->position() + move_vec);
     }
 
     /// Move an agent relative to its current position
     void move_by(Agent& agent,
                  const SpaceVec& move_vec) const
     {
-        _move_to_func(agent, agent.position() + move_vec);
+        move_to(agent, agent.position() + move_vec);
+    }
+
+    /// The number of changes of agent positions or of the set of agents
+    /** This is increased by moving, adding, removing, and (synchronously)
+     *  updating agents. Structures derived from the agent positions, e.g. an
+     *  AgentCellIndex, can compare it to detect that they are outdated.
+     *
+     *  \note  Positions changed via Agent::set_pos directly, bypassing the
+     *         manager, are not counted.
+     */
+    std::size_t num_modifications() const {
+        return _num_modifications.load(std::memory_order_relaxed);
     }
 
 
@@ -240,7 +319,9 @@ public:
         _agents.emplace_back(
             std::make_shared<Agent>(_id_counter, state, _prepare_pos(pos))
         );
+        _agent_idcs.emplace(_id_counter, _agents.size() - 1);
         ++_id_counter;
+        ++_num_modifications;
 
         return _agents.back();
     }
@@ -306,21 +387,40 @@ public:
 
 
     /// Removes the given agent from the agent manager
+    /** This is a constant-time operation: the agent is looked up via its ID
+     *  and its place in the agents container is taken by the last agent.
+     *
+     *  \note  This does *not* preserve the order of the agents container. If
+     *         the order is relevant, use erase_agent_if instead.
+     *
+     *  \throws std::invalid_argument If the agent is not managed by this
+     *                                manager
+     */
     void remove_agent (const std::shared_ptr<Agent>& agent) {
         // Find the position in the agents container that belongs to the agent
-        const auto it = std::find(_agents.cbegin(), _agents.cend(), agent);
+        const auto it = _agent_idcs.find(agent->id());
 
-        if (it == _agents.cend()) {
+        if (it == _agent_idcs.end() or _agents[it->second] != agent) {
             throw std::invalid_argument("The given agent is not handled by "
                                         "this manager!");
         };
 
         _log->trace("Removing agent with ID {:d} ...", agent->id());
-        _agents.erase(it);
+        const auto idx = it->second;
+        _agent_idcs.erase(it);
+
+        // Move the last agent into the gap, if it is not the removed one
+        if (idx != _agents.size() - 1) {
+            _agents[idx] = std::move(_agents.back());
+            _agent_idcs[_agents[idx]->id()] = idx;
+        }
+        _agents.pop_back();
+        ++_num_modifications;
     }
 
     /// Remove agents if the given condition is met
-    /** Uses the erase-remove idiom
+    /** Uses the erase-remove idiom and thus preserves the order of the
+     *  remaining agents.
      *
      *  \tparam UnaryPredicate type of the UnaryPredicate
      *
@@ -334,6 +434,67 @@ public:
             std::remove_if(_agents.begin(), _agents.end(), condition),
             _agents.cend()
         );
+        rebuild_agent_idcs();
+        ++_num_modifications;
+    }
+
+    /// Schedule the creation of an agent
+    /** The agent is created with the next call to apply_scheduled_changes,
+     *  e.g. at the end of an iteration step. This allows to add agents while
+     *  iterating over the agents container.
+     *
+     *  \param state  The state of the agent that is to be added
+     *  \param pos    The position of the agent that is to be added; this is
+     *                checked (or mapped into space) already here
+     */
+    void schedule_add_agent (const AgentState& state, const SpaceVec& pos) {
+        _scheduled_births.emplace_back(state, _prepare_pos(pos));
+    }
+
+    /// Schedule the removal of an agent
+    /** The agent is removed with the next call to apply_scheduled_changes,
+     *  e.g. at the end of an iteration step. This allows to remove agents
+     *  while iterating over the agents container. Scheduling the same agent
+     *  multiple times is allowed.
+     *
+     *  \throws std::invalid_argument If the agent is not managed by this
+     *                                manager
+     */
+    void schedule_remove_agent (const std::shared_ptr<Agent>& agent) {
+        const auto it = _agent_idcs.find(agent->id());
+
+        if (it == _agent_idcs.end() or _agents[it->second] != agent) {
+            throw std::invalid_argument("The given agent is not handled by "
+                                        "this manager!");
+        };
+
+        _scheduled_deaths.push_back(agent);
+    }
+
+    /// Carry out the scheduled removals and additions of agents
+    /** First removes the scheduled agents, then adds the scheduled ones, in
+     *  the order they were scheduled in. Each removal and addition is a
+     *  constant-time operation; the order of the agents container is not
+     *  preserved.
+     */
+    void apply_scheduled_changes () {
+        for (const auto& agent : _scheduled_deaths) {
+            // Might have been scheduled multiple times
+            if (contains_agent(agent->id())) {
+                remove_agent(agent);
+            }
+        }
+
+        _agents.reserve(_agents.size() + _scheduled_births.size());
+        for (const auto& [state, pos] : _scheduled_births) {
+            add_agent(state, pos);
+        }
+
+        _log->debug("Applied {} scheduled removal(s) and {} scheduled "
+                    "addition(s) of agents.",
+                    _scheduled_deaths.size(), _scheduled_births.size());
+        _scheduled_deaths.clear();
+        _scheduled_births.clear();
     }
 
 
@@ -358,8 +519,150 @@ public:
         for (const auto& agent : _agents){
             agent->update();
         }
+        ++_num_modifications;
+    }
+
+    // .. Agent order .........................................................
+
+    /// Sort the agents container by the position of the agents in space
+    /** The space is divided into bins and the agents are ordered by the
+     *  position of their bin along a space-filling curve (the Hilbert curve in
+     *  two dimensions, the Z-order curve otherwise). Agents that are close in
+     *  space are thus close in the agents container, which makes iterating
+     *  over them while accessing their spatial neighbors more cache-friendly.
+     *  Within a bin, the previous order of the agents is preserved.
+     *
+     *  The agents keep their IDs and are not copied; only the order of the
+     *  pointers in the container changes, see agents().
+     *
+     *  \param num_bins  The number of bins per dimension. If 0, the
+     *                   `sort_num_bins` configuration entry is used; if that
+     *                   is 0 or not given, the number is chosen such that
+     *                   there are about as many bins as agents.
+     */
+    void sort_agents (IndexType num_bins = 0) {
+        const auto num_agents = _agents.size();
+        if (num_agents < 2) {
+            return;
+        }
+
+        if (num_bins == 0) {
+            num_bins = _sort_num_bins;
+        }
+        if (num_bins == 0) {
+            num_bins = std::ceil(std::pow(num_agents, 1. / dim));
+        }
+
+        // The side length of the curve needs to be a power of two
+        std::uint64_t side = 1;
+        while (side < num_bins) {
+            side *= 2;
+        }
+        std::uint64_t num_keys = 1;
+        for (DimType d = 0; d < dim; d++) {
+            num_keys *= side;
+        }
+
+        // Determine the position of each agent's bin along the curve
+        std::vector<std::uint64_t> keys(num_agents);
+        MultiIndexType<dim> bin;
+        for (std::size_t i = 0; i < num_agents; i++) {
+            const auto& pos = _agents[i]->position();
+            for (DimType d = 0; d < dim; d++) {
+                const double rel = std::clamp(pos[d] / _space->extent[d],
+                                              0., 1.);
+                bin[d] = std::min(IndexType(rel * num_bins), num_bins - 1);
+            }
+
+            if constexpr (dim == 2) {
+                keys[i] = hilbert_key(side, bin[0], bin[1]);
+            }
+            else {
+                keys[i] = morton_key(bin);
+            }
+        }
+
+        AgentContainer<Agent> sorted(num_agents);
+
+        if (num_keys <= 4 * num_agents) {
+            // Counting sort: count the agents per key, compute the offsets
+            // from the cumulative sum, and place the agents accordingly
+            std::vector<std::size_t> offsets(num_keys + 1, 0);
+            for (const auto key : keys) {
+                ++offsets[key + 1];
+            }
+            for (std::size_t k = 1; k < offsets.size(); k++) {
+                offsets[k] += offsets[k - 1];
+            }
+            for (std::size_t i = 0; i < num_agents; i++) {
+                sorted[offsets[keys[i]]++] = std::move(_agents[i]);
+            }
+        }
+        else {
+            // Too many (mostly empty) bins; sort the agent indices instead
+            std::vector<std::size_t> idcs(num_agents);
+            std::iota(idcs.begin(), idcs.end(), 0);
+            std::stable_sort(idcs.begin(), idcs.end(),
+                [&keys](const auto a, const auto b){
+                    return keys[a] < keys[b];
+                }
+            );
+            for (std::size_t i = 0; i < num_agents; i++) {
+                sorted[i] = std::move(_agents[idcs[i]]);
+            }
+        }
+
+        _agents = std::move(sorted);
+        rebuild_agent_idcs();
+        _log->debug("Sorted {} agents spatially, using {} bins per "
+                    "dimension.", num_agents, num_bins);
+    }
+
+    /// Sort the agents spatially if the configured interval has passed
+    /** Counts the calls to this method and invokes sort_agents on every
+     *  `sort_interval`-th call, as given by the configuration entry of that
+     *  name. Call this once per iteration step, e.g. after moving the agents.
+     *  If the interval is 0 (the default), the agents are never sorted.
+     *
+     *  \return Whether the agents were sorted
+     */
+    bool sort_agents_periodically () {
+        if (_sort_interval == 0) {
+            return false;
+        }
+
+        if (++_num_sort_calls % _sort_interval != 0) {
+            return false;
+        }
+        sort_agents();
+        return true;
+    }
+
+    /// After how many calls to sort_agents_periodically the agents are sorted
+    IndexType sort_interval () const {
+        return _sort_interval;
+    }
+
+    /// Return the indices of the agents in the container, ordered by ID
+    /** As the order of the agents container changes when agents are removed
+     *  or sorted, this can be used to write agent data in a consistent order,
+     *  without copying the container: the i-th agent by ID is
+     *  `agents()[idcs[i]]`.
+     */
+    std::vector<std::size_t> agent_idcs_by_id () const {
+        std::vector<std::size_t> idcs(_agents.size());
+        std::iota(idcs.begin(), idcs.end(), 0);
+
+        const auto by_id = [this](const auto a, const auto b){
+            return _agents[a]->id() < _agents[b]->id();
+        };
+        if (not std::is_sorted(idcs.begin(), idcs.end(), by_id)) {
+            std::sort(idcs.begin(), idcs.end(), by_id);
+        }
+        return idcs;
     }
 
+
     // .. Agent Selection .....................................................
     /// Select agents using the \ref Utopia::select_entities interface
     /** Returns a container of agents that were selected according to a certain
@@ -457,6 +760,16 @@ private:
                 % SpaceVec().imbue([this,&dist](){return dist(*this->_rng);}));
     }
 
+    /// Rebuild the map from agent IDs to indices in the agents container
+    void rebuild_agent_idcs () {
+        _agent_idcs.clear();
+        _agent_idcs.reserve(_agents.size());
+
+        for (std::size_t i = 0; i < _agents.size(); i++) {
+            _agent_idcs.emplace(_agents[i]->id(), i);
+        }
+    }
+
     // -- Setup functions -----------------------------------------------------
 
     /// Set up the agent manager configuration member
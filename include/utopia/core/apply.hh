@@ -2,8 +2,10 @@
 #define UTOPIA_CORE_APPLY_HH
 
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "bernoulli.hh"
 #include "parallel.hh"
 #include "state.hh"
 #include "zip.hh"
@@ -31,6 +33,16 @@ enum class Shuffle {
     off
 };
 
+/// Switch for how the new states of synchronously updated entities are stored
+/** This only applies to entities with a StateContainer<State, Update::sync>.
+ */
+enum class StateBuffer {
+    /// Copy the state cache into the current state
+    copy,
+    /// Swap the state buffers; only for rules that return the new state
+    swap
+};
+
 /// Helper class for checking rule signatures and return types
 /**
  *  This class checks if a rule can be invoked with the given arguments (note
@@ -413,16 +425,96 @@ apply_rule(const Utopia::ExecPolicy policy,
 }
 
 
+/// Apply a rule to each entity with a certain probability
+/** Each entity of the container is independently selected with the given
+ *  probability and the rule is applied to the selected entities, in the order
+ *  they appear in the container. The selection uses geometrically
+ *  distributed skips (see for_each_bernoulli_success), such that the number
+ *  of random numbers drawn is proportional to the number of selected entities
+ *  rather than to the size of the container. This makes it well-suited for
+ *  rare events like spontaneous state changes.
+ *
+ *  With Update::sync, the new states of all selected entities are computed
+ *  before any of them is set. With Update::async, the states are set
+ *  directly; void rules are only allowed in this mode.
+ *
+ *  \tparam mode Update mode for this rule; Update::sync or Update::async
+ *
+ *  \param rule         The function (object) to apply to the entities
+ *  \param cont_target  The container of entities
+ *  \param probability  The probability with which the rule is applied to an
+ *                      entity
+ *  \param rng          The random number generator used for the selection
+ */
+template<Update mode,
+         class Rule,
+         class ContTarget,
+         class RNG,
+         typename std::enable_if_t<mode != Update::manual, int> = 0,
+         typename std::enable_if_t<
+                    impl::entity_t<ContTarget>::mode
+                        == Update::manual, int> = 0>
+void apply_rule_with_probability(Rule&& rule,
+                                 const ContTarget& cont_target,
+                                 const double probability,
+                                 RNG&& rng)
+{
+    using State = typename impl::entity_t<ContTarget>::State;
+    using Entity = typename ContTarget::value_type;
+    constexpr bool void_rule = std::is_same_v<
+        std::invoke_result_t<Rule, const Entity&>, void>;
+
+    if constexpr (mode == Update::async) {
+        for_each_bernoulli_success(cont_target.size(), probability, rng,
+            [&](const std::size_t idx){
+                const auto& entity = cont_target[idx];
+                if constexpr (void_rule) {
+                    rule(entity);
+                }
+                else {
+                    entity->state = rule(entity);
+                }
+            }
+        );
+    }
+    else {
+        static_assert(not void_rule,
+                      "Cannot apply void rules in a synchronous update!");
+
+        // Compute the new states of the selected entities ...
+        std::vector<std::pair<std::size_t, State>> new_states;
+        for_each_bernoulli_success(cont_target.size(), probability, rng,
+            [&](const std::size_t idx){
+                new_states.emplace_back(idx, rule(cont_target[idx]));
+            }
+        );
+
+        // ... and then set them
+        for (auto& [idx, state] : new_states) {
+            cont_target[idx]->state = std::move(state);
+        }
+    }
+}
+
+
 // -- Synchronous state updates -----------------------------------------------
 /// Apply a rule synchronously on the state of all entities of a container
 /** Applies the rule function to each of the entities' states and
  *  stores the result in a buffer. Afterwards, it iterates over all
  *  entities again and applies the buffer to the actual state.
  *
+ *  With `buffer == StateBuffer::swap`, the buffer is not copied but swapped
+ *  with the actual state, which saves one state copy per entity. The rule
+ *  is then required to return the new state; afterwards, `state_new()` holds
+ *  the previous state of the entity.
+ *
+ *  \tparam buffer    How to commit the buffered states, see StateBuffer
+ *
  *  \param rule       An application rule, see \ref rule
  *  \param Container  A container with the entities upon whom rule is applied
  */
 template<
+    StateBuffer buffer=StateBuffer::copy,
     class Rule,
     class Container,
     bool sync=impl::entity_t<Container>::is_sync()>
@@ -448,10 +540,23 @@ std::enable_if_t<sync, void>
 
     // Let the entity update its state, moving it from the buffer state to the
     // actual state and potentially applying other updating operations
-    std::for_each(
-        std::begin(container), std::end(container),
-        [](const auto& entity){ entity->update(); }
-    );
+    if constexpr (buffer == StateBuffer::swap) {
+        static_assert(not std::is_same_v<ReturnType, void>,
+            "Swapping the state buffers requires a rule that returns the new "
+            "state, because state_new() holds the previous state after a "
+            "swap!");
+
+        std::for_each(
+            std::begin(container), std::end(container),
+            [](const auto& entity){ entity->swap_buffers(); }
+        );
+    }
+    else {
+        std::for_each(
+            std::begin(container), std::end(container),
+            [](const auto& entity){ entity->update(); }
+        );
+    }
 }
 
 
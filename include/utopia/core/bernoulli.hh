@@ -0,0 +1,83 @@
+#ifndef UTOPIA_CORE_BERNOULLI_HH
+#define UTOPIA_CORE_BERNOULLI_HH
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+
+
+namespace Utopia {
+/**
+ *  \addtogroup Rules
+ *  \{
+ */
+
+/// Invoke a function for each successful trial of a sequence of Bernoulli trials
+/** Performs `num_trials` independent Bernoulli trials with success
+ *  probability `probability` and calls `f` with the (zero-based) index of
+ *  each successful trial, in ascending order.
+ *
+ *  Instead of drawing one random number per trial, the number of failures
+ *  between two successes is drawn from a geometric distribution. Thus, only
+ *  about `num_trials * probability + 1` random numbers are drawn, which makes
+ *  this efficient for rare events on a large number of entities.
+ *
+ *  \param num_trials   The number of trials
+ *  \param probability  The success probability of a single trial
+ *  \param rng          The random number generator
+ *  \param f            A callable invoked with the index of each success
+ *
+ *  \throws std::invalid_argument If probability is outside of [0, 1]
+ */
+template<class RNG, class Func>
+void for_each_bernoulli_success (const std::size_t num_trials,
+                                 const double probability,
+                                 RNG&& rng,
+                                 Func&& f)
+{
+    if (probability < 0. or probability > 1.) {
+        throw std::invalid_argument("Probability for Bernoulli trials needs "
+            "to be in the interval [0., 1.]!");
+    }
+    else if (probability == 0.) {
+        return;
+    }
+    else if (probability == 1.) {
+        for (std::size_t i = 0; i < num_trials; i++) {
+            f(i);
+        }
+        return;
+    }
+
+    // The number of failures before the next success is geometrically
+    // distributed. It is drawn via inversion; log1p keeps this accurate for
+    // tiny probabilities, and comparing as floating point avoids overflow.
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    const double log_q = std::log1p(-probability);
+
+    std::size_t remaining = num_trials;
+    std::size_t idx = 0;
+    while (remaining > 0) {
+        const double num_failures =
+            std::floor(std::log(1. - uniform(rng)) / log_q);
+        if (not (num_failures < static_cast<double>(remaining))) {
+            break;
+        }
+
+        const auto skip = static_cast<std::size_t>(num_failures);
+        idx += skip;
+        f(idx);
+
+        remaining -= skip + 1;
+        ++idx;
+    }
+}
+
+/**
+ *  \} // endgroup Rules
+ */
+
+} // namespace Utopia
+
+#endif // UTOPIA_CORE_BERNOULLI_HH
@@ -2,9 +2,14 @@
 #define UTOPIA_CORE_CELL_MANAGER_HH
 
 #include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <random>
 #include <type_traits>
 #include <string_view>
 #include <unordered_set>
+#include <vector>
 
 #include <armadillo>
 
@@ -23,6 +28,28 @@ namespace Utopia {
  *  \{
  */
 
+namespace impl {
+/// Whether a cell state can be constructed from a parsed parameter struct
+/** This is the case if the state type defines a `Params` type that is
+ *  constructible from a `const DataIO::Config&` and if the state itself is
+ *  constructible from `(const Params&, RNG&)`.
+ */
+template<class State, class RNG, class = void>
+struct has_params_constructor : std::false_type {};
+
+template<class State, class RNG>
+struct has_params_constructor<State, RNG,
+                              std::void_t<typename State::Params>>
+:
+    std::bool_constant<
+        std::is_constructible_v<typename State::Params,
+                                const DataIO::Config&>
+        and std::is_constructible_v<State,
+                                    const typename State::Params&,
+                                    RNG&>>
+{};
+} // namespace impl
+
 /// Manages a physical space, its grid discretization, and cells on that grid
 /** This class implements a common interface for working with cells as a
  *  representation of volumes of physical space. A typical use case is the
@@ -718,17 +745,133 @@ private:
 
     /// Set up the cells container using an explicitly passed initial state
     CellContainer<Cell> setup_cells(const CellState& initial_state) const {
+        auto cont = make_cells([&](const IndexType){
+            return initial_state;
+        });
+        _log->info("Populated cell container with {:d} cells.", cont.size());
+
+        return cont;
+    }
+
+    /// Create the cells, using a single allocation for all of them
+    /** The cells are stored in one contiguous block; the returned pointers
+     *  share ownership of that block. The order of the cells within the block
+     *  is determined by the ``memory_order`` configuration entry, see
+     *  setup_memory_order. The returned container is always ordered by ID
+     *  and the states are always constructed in that order, such that the
+     *  memory order has no effect other than on the memory layout.
+     *
+     *  \param make_state  Callable returning the state for a given cell ID
+     */
+    template<class StateFunc>
+    CellContainer<Cell> make_cells(StateFunc&& make_state) const {
+        const auto num_cells = _grid->num_cells();
+        const auto order = setup_memory_order();
+
+        auto block = std::make_shared<std::vector<Cell>>();
+        block->reserve(num_cells);
+
+        // Construct the pointers, sharing ownership of the whole block
         CellContainer<Cell> cont;
+        if (not order) {
+            for (IndexType i=0; i<num_cells; i++) {
+                block->emplace_back(i, make_state(i));
+            }
+
+            cont.reserve(num_cells);
+            for (auto& cell : *block) {
+                cont.emplace_back(block, &cell);
+            }
+            return cont;
+        }
 
-        // Construct all the cells
-        for (IndexType i=0; i<_grid->num_cells(); i++) {
-            cont.emplace_back(std::make_shared<Cell>(i, initial_state));
+        std::vector<std::optional<CellState>> states(num_cells);
+        for (IndexType i=0; i<num_cells; i++) {
+            states[i].emplace(make_state(i));
         }
 
-        // Done. Shrink it.
-        cont.shrink_to_fit();
-        _log->info("Populated cell container with {:d} cells.", cont.size());
+        cont.resize(num_cells);
+        for (const auto id : *order) {
+            block->emplace_back(id, std::move(*states[id]));
+            cont[id] = std::shared_ptr<Cell>(block, &block->back());
+        }
+        return cont;
+    }
+
+    /// Determine the memory order of the cells from the configuration
+    /** Reads the optional ``memory_order`` entry, one of the keys of the
+     *  memory_order_map, and for the ``tiled`` order the ``tile_size``
+     *  entry (default: 8). Orders following a space-filling curve place the
+     *  neighbors of a cell close to it in memory, which benefits rules that
+     *  access the neighbors' states on large grids.
+     *
+     *  \return The cell IDs in the order they are to be stored in, or
+     *          nothing if the cells are to be stored in order of their IDs
+     */
+    std::optional<IndexContainer> setup_memory_order() const {
+        const auto name = get_as<std::string>("memory_order", _cfg,
+                                              "row_major");
+
+        const auto it = memory_order_map.find(name);
+        if (it == memory_order_map.end()) {
+            std::string keys;
+            for (const auto& kv : memory_order_map) {
+                keys += (keys.empty() ? "" : ", ") + kv.first;
+            }
+            throw std::invalid_argument("Invalid value for cell manager "
+                "'memory_order' argument: '" + name + "'! Allowed values: "
+                + keys);
+        }
+        if (it->second == MemoryOrder::row_major) {
+            return {};
+        }
+
+        _log->info("Storing cells in '{}' memory order ...", name);
+        return memory_order_of(*_grid, it->second,
+                               get_as<DistType>("tile_size", _cfg, 8));
+    }
+
+    /// Set up the cells from a cell state parameter struct, in parallel
+    /** The `cell_params` are parsed *once* into a `CellState::Params` object
+     *  from which all cell states are constructed. This happens in chunks of
+     *  cells, potentially in parallel (see \ref Parallel); each chunk uses its
+     *  own RNG which is seeded from a number drawn from the shared RNG and
+     *  the chunk index. The result thus does not depend on whether the setup
+     *  ran in parallel or not.
+     */
+    template<class Params>
+    CellContainer<Cell> setup_cells_from_params(const Params& params) const
+    {
+        const auto num_cells = _grid->num_cells();
+        constexpr IndexType chunk_size = 4096;
+        const auto num_chunks = (num_cells + chunk_size - 1) / chunk_size;
+
+        // Seed for the per-chunk RNGs, drawn from the shared RNG
+        const auto seed = static_cast<std::uint64_t>((*_rng)());
+
+        std::vector<std::optional<CellState>> states(num_cells);
+        std::vector<IndexType> chunks(num_chunks);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        std::for_each(ExecPolicy::par, chunks.begin(), chunks.end(),
+            [&](const IndexType chunk){
+                std::seed_seq seq{static_cast<std::uint32_t>(seed),
+                                  static_cast<std::uint32_t>(seed >> 32),
+                                  static_cast<std::uint32_t>(chunk)};
+                RNG rng(seq);
+
+                const auto end = std::min((chunk + 1) * chunk_size,
+                                          num_cells);
+                for (auto i = chunk * chunk_size; i < end; i++) {
+                    states[i].emplace(params, rng);
+                }
+            }
+        );
 
+        auto cont = make_cells([&](const IndexType i){
+            return std::move(*states[i]);
+        });
+        _log->info("Populated cell container with {:d} cells.", cont.size());
         return cont;
     }
 
@@ -745,6 +888,12 @@ private:
       * ``(const Config&, const std::shared_ptr<RNG>&)`` is supported,
       * that constructor is called instead.
       *
+      * If the CellState defines a ``Params`` type that is constructible from
+      * ``const Config&`` and the state is constructible from
+      * ``(const Params&, RNG&)``, the ``cell_params`` are parsed only once
+      * and the states are constructed in bulk, see setup_cells_from_params.
+      * This is the fastest way to set up a large number of cells.
+      *
       * \note   If the constructor for the cell state has an RNG available
       *         it is called anew for _each_ cell; otherwise, an initial state
       *         is constructed _once_ and used for all cells.
@@ -768,6 +917,21 @@ private:
             return setup_cells(CellState());
         }
 
+        // Can the parameters be parsed once and then used for all cells?
+        else if constexpr (impl::has_params_constructor<CellState,
+                                                        RNG>::value)
+        {
+            _log->info("Setting up cells using parameter struct ...");
+
+            if (not _cfg["cell_params"]) {
+                throw std::invalid_argument("CellManager is missing the "
+                    "configuration entry 'cell_params' to set up the cells' "
+                    "initial states!");
+            }
+            return setup_cells_from_params(
+                typename CellState::Params(_cfg["cell_params"]));
+        }
+
         // Is there a constructor available that allows passing the RNG?
         else if constexpr (std::is_constructible<CellState,
                                                  const Config&,
@@ -785,17 +949,10 @@ private:
             }
             const auto cell_params = _cfg["cell_params"];
 
-            // The cell container to be populated
-            CellContainer<Cell> cont;
-
             // Populate the container, creating the cell state anew each time
-            for (IndexType i=0; i<_grid->num_cells(); i++) {
-                cont.emplace_back(
-                    std::make_shared<Cell>(i, CellState(cell_params, _rng))
-                );
-            }
-            // Done. Shrink it.
-            cont.shrink_to_fit();
+            auto cont = make_cells([&](const IndexType){
+                return CellState(cell_params, _rng);
+            });
             _log->info("Populated cell container with {:d} cells.",
                        cont.size());
             return cont;
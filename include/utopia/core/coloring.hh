@@ -0,0 +1,489 @@
+#ifndef UTOPIA_CORE_COLORING_HH
+#define UTOPIA_CORE_COLORING_HH
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+
+#include "apply.hh"
+#include "grids/base.hh"
+#include "parallel.hh"
+#include "types.hh"
+#include "../data_io/cfg_utils.hh"
+
+
+namespace Utopia {
+/**
+ *  \addtogroup Rules
+ *  \{
+ */
+
+/// A partition of entities into color classes of mutually independent ones
+/** Two entities of the same color are guaranteed not to interact within the
+ *  chosen distance (see color_cells), such that a rule may be applied to all
+ *  entities of one color concurrently without any data races, even if it
+ *  reads or modifies the neighbors of an entity. Applying the rule color by
+ *  color thus retains the semantics of an asynchronous update; see
+ *  apply_rule_colored.
+ *
+ *  \tparam Element  The element type, e.g. a shared pointer to a cell or a
+ *                   vertex descriptor
+ */
+template<class Element>
+class Coloring {
+public:
+    /// The type of a single color class
+    using ColorClass = std::vector<Element>;
+
+private:
+    /// The elements of each color
+    std::vector<ColorClass> _classes;
+
+public:
+    /// Construct a coloring from its color classes
+    explicit Coloring (std::vector<ColorClass> classes)
+    :
+        _classes(std::move(classes))
+    {}
+
+    /// Construct a coloring from the elements and the color of each of them
+    /** \param elements  The elements to partition
+     *  \param colors    The color of each element, consecutive from zero
+     */
+    template<class Container>
+    Coloring (const Container& elements,
+              const std::vector<std::size_t>& colors)
+    :
+        _classes()
+    {
+        if (elements.size() != colors.size()) {
+            throw std::invalid_argument("Cannot construct a coloring from "
+                + std::to_string(elements.size()) + " elements and "
+                + std::to_string(colors.size()) + " colors!");
+        }
+
+        std::size_t num_colors = 0;
+        if (not colors.empty()) {
+            num_colors = *std::max_element(colors.begin(), colors.end()) + 1;
+        }
+
+        std::vector<std::size_t> counts(num_colors, 0);
+        for (const auto c : colors) {
+            ++counts[c];
+        }
+
+        _classes.resize(num_colors);
+        for (std::size_t c = 0; c < num_colors; ++c) {
+            _classes[c].reserve(counts[c]);
+        }
+
+        auto color = colors.begin();
+        for (const auto& element : elements) {
+            _classes[*color++].push_back(element);
+        }
+
+        // Drop colors that were not used
+        _classes.erase(std::remove_if(_classes.begin(), _classes.end(),
+                                      [](const auto& cls){
+                                          return cls.empty();
+                                      }),
+                       _classes.end());
+    }
+
+    /// The number of colors
+    std::size_t num_colors () const {
+        return _classes.size();
+    }
+
+    /// The total number of elements
+    std::size_t size () const {
+        return std::accumulate(_classes.begin(), _classes.end(),
+                               std::size_t(0),
+                               [](const auto sum, const auto& cls){
+                                   return sum + cls.size();
+                               });
+    }
+
+    /// The elements of the given color
+    const ColorClass& operator[] (const std::size_t color) const {
+        return _classes[color];
+    }
+
+    /// The elements of the given color
+    ColorClass& operator[] (const std::size_t color) {
+        return _classes[color];
+    }
+
+    /// Iterate over the color classes
+    auto begin () const { return _classes.begin(); }
+
+    /// Iterate over the color classes
+    auto end () const { return _classes.end(); }
+};
+
+
+namespace impl {
+
+/// Greedily color the indices 0..n-1 given their neighbors
+/** The indices are visited in ascending order and each one is assigned the
+ *  smallest color not used by any index within the given distance.
+ *
+ *  \param n             The number of indices
+ *  \param neighbors_of  Returns the neighbors of an index as a container of
+ *                       indices; the neighborhood needs to be symmetric.
+ *  \param distance      1 to separate neighbors, 2 to additionally separate
+ *                       indices with a common neighbor
+ */
+template<class NBFunc>
+std::vector<std::size_t> color_greedy (const std::size_t n,
+                                       NBFunc&& neighbors_of,
+                                       const unsigned distance)
+{
+    constexpr auto uncolored = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> colors(n, uncolored);
+
+    // For each color, the last index it was found to be in conflict with;
+    // this avoids clearing a set of used colors for every index
+    std::vector<std::size_t> used_by;
+
+    auto mark = [&](const std::size_t other) {
+        if (colors[other] != uncolored) {
+            used_by[colors[other]] = other;
+        }
+    };
+
+    for (std::size_t i = 0; i < n; ++i) {
+        // Mark the colors of the conflicting indices with i's neighbors ...
+        std::fill(used_by.begin(), used_by.end(), uncolored);
+        std::size_t marker = 0;
+
+        for (const auto nb : neighbors_of(i)) {
+            if (nb == i) {
+                continue;
+            }
+            mark(nb);
+
+            if (distance > 1) {
+                for (const auto nb2 : neighbors_of(nb)) {
+                    if (nb2 != i) {
+                        mark(nb2);
+                    }
+                }
+            }
+        }
+
+        // ... and take the first one that is not marked
+        while (marker < used_by.size() and used_by[marker] != uncolored) {
+            ++marker;
+        }
+        if (marker == used_by.size()) {
+            used_by.push_back(uncolored);
+        }
+        colors[i] = marker;
+    }
+
+    return colors;
+}
+
+/// Color a two-dimensional square grid by a pattern of its multi-indices
+/** Returns no coloring if the grid is periodic and its shape is not a
+ *  multiple of the period of the pattern, as the pattern then would not
+ *  fit across the boundary.
+ */
+template<class GridType>
+std::optional<std::vector<std::size_t>>
+color_square_grid (const GridType& grid, const unsigned distance)
+{
+    if constexpr (GridType::dim != 2) {
+        return {};
+    }
+    else {
+        const auto shape = grid.shape();
+        const auto r = get_as<DistType>("distance", grid.nb_params(), 1);
+
+        // The candidate patterns: the period in each dimension and the
+        // color as a function of the multi-index
+        using Pattern = std::pair<
+            std::size_t, std::function<std::size_t(std::size_t, std::size_t)>>;
+        std::vector<Pattern> patterns;
+
+        if (grid.nb_mode() == NBMode::empty) {
+            patterns.emplace_back(1, [](auto, auto){ return 0; });
+        }
+        else if (grid.nb_mode() == NBMode::vonNeumann and r == 1) {
+            if (distance == 1) {
+                // The checkerboard (red-black) pattern
+                patterns.emplace_back(2, [](auto x, auto y){
+                    return (x + y) % 2;
+                });
+            }
+            else {
+                // Diagonal stripes; same-colored cells are three steps apart
+                patterns.emplace_back(5, [](auto x, auto y){
+                    return (x + 2*y) % 5;
+                });
+            }
+        }
+
+        if (grid.nb_mode() == NBMode::vonNeumann
+            or grid.nb_mode() == NBMode::Moore)
+        {
+            // Blocks of p x p cells of distinct colors, where p exceeds the
+            // (Chebyshev) distance of interacting cells. As the von-Neumann
+            // neighborhood is contained in the Moore neighborhood of the
+            // same distance, this pattern is valid for both.
+            const std::size_t p = (distance == 1) ? r + 1 : 2*r + 1;
+            patterns.emplace_back(p, [p](auto x, auto y){
+                return (x % p) + p * (y % p);
+            });
+        }
+
+        for (const auto& [period, color_of] : patterns) {
+            if (grid.is_periodic()
+                and (shape[0] % period != 0 or shape[1] % period != 0))
+            {
+                continue;
+            }
+
+            std::vector<std::size_t> colors(grid.num_cells());
+            for (std::size_t id = 0; id < colors.size(); ++id) {
+                const auto midx = grid.midx_of(id);
+                colors[id] = color_of(midx[0], midx[1]);
+            }
+            return colors;
+        }
+        return {};
+    }
+}
+
+/// Throw if the distance of a coloring is not supported
+inline void check_coloring_distance (const unsigned distance) {
+    if (distance != 1 and distance != 2) {
+        throw std::invalid_argument("The distance of a coloring needs to be "
+            "1 or 2, but was " + std::to_string(distance) + "!");
+    }
+}
+
+} // namespace impl
+
+
+/// Partition the cells of a cell manager into independent sets
+/** Cells of the same color are guaranteed to not interact with each other
+ *  within the neighborhood of the cell manager's grid:
+ *
+ *    - With `distance == 1`, no two neighboring cells have the same color.
+ *      This suffices for rules that read the neighbors' states but only
+ *      modify the state of the cell they are applied to.
+ *    - With `distance == 2`, additionally no two cells with a common neighbor
+ *      have the same color. This is needed for rules that modify the states
+ *      of the neighbors, like the toppling of a sandpile.
+ *
+ *  For square grids with a von-Neumann or Moore neighborhood, the coloring
+ *  follows a regular pattern of the multi-indices, e.g. a checkerboard for
+ *  the von-Neumann neighborhood and blocks of 2x2 colors for the Moore
+ *  neighborhood. In periodic space, this is only possible if the grid shape
+ *  is a multiple of the pattern's period; otherwise, and for all other grids,
+ *  the cells are colored greedily by their IDs. The number of colors is then
+ *  bounded by one plus the number of interacting cells.
+ *
+ *  \param cm        The cell manager
+ *  \param distance  The interaction distance; 1 or 2, see above
+ *
+ *  \return The coloring of the cells, using the cell pointers of the manager
+ */
+template<class CellManager>
+auto color_cells (const CellManager& cm, const unsigned distance = 1) {
+    impl::check_coloring_distance(distance);
+
+    const auto& cells = cm.cells();
+    const auto& grid = *cm.grid();
+
+    std::optional<std::vector<std::size_t>> colors;
+    if (grid.structure() == GridStructure::square) {
+        colors = impl::color_square_grid(grid, distance);
+    }
+
+    if (not colors) {
+        colors = impl::color_greedy(
+            cells.size(),
+            [&grid](const std::size_t id){ return grid.neighbors_of(id); },
+            distance
+        );
+    }
+
+    return Coloring<typename std::decay_t<decltype(cells)>::value_type>(
+        cells, *colors);
+}
+
+/// Partition the vertices of a graph into independent sets
+/** The vertices are colored greedily in the order of their index, such that
+ *  no two adjacent vertices (`distance == 1`) or additionally no two vertices
+ *  with a common neighbor (`distance == 2`) have the same color. The
+ *  direction of edges is disregarded.
+ *
+ *  \param g         The graph; needs a vertex index property, as is the case
+ *                   for vertices stored in a boost::vecS container
+ *  \param distance  The interaction distance, see color_cells
+ *
+ *  \return The coloring of the vertex descriptors
+ */
+template<class Graph>
+auto color_vertices (const Graph& g, const unsigned distance = 1) {
+    impl::check_coloring_distance(distance);
+
+    using VertexDesc = typename boost::graph_traits<Graph>::vertex_descriptor;
+    const auto index = boost::get(boost::vertex_index, g);
+
+    std::vector<VertexDesc> vertices;
+    vertices.reserve(boost::num_vertices(g));
+    for (auto [v, v_end] = boost::vertices(g); v != v_end; ++v) {
+        vertices.push_back(*v);
+    }
+
+    // Collect the (undirected) adjacency once
+    std::vector<std::vector<std::size_t>> adjacent(vertices.size());
+    for (auto [e, e_end] = boost::edges(g); e != e_end; ++e) {
+        const std::size_t s = index[boost::source(*e, g)];
+        const std::size_t t = index[boost::target(*e, g)];
+        adjacent[s].push_back(t);
+        adjacent[t].push_back(s);
+    }
+
+    const auto colors = impl::color_greedy(
+        vertices.size(),
+        [&adjacent](const std::size_t i) -> const auto& {
+            return adjacent[i];
+        },
+        distance
+    );
+
+    return Coloring<VertexDesc>(vertices, colors);
+}
+
+
+/// Apply a rule asynchronously, color by color, without shuffling
+/** The rule is applied to all elements of one color using the given
+ *  execution policy before proceeding to the next color. As elements of the
+ *  same color do not interact (see color_cells), this may be done in
+ *  parallel while retaining the semantics of an asynchronous update.
+ *
+ *  If the rule returns a value, it is assigned to the state of the entity
+ *  the rule was applied to; this requires the elements to be (pointers to)
+ *  entities with manually updated states. For other elements, e.g. graph
+ *  vertices, the rule needs to return `void`.
+ *
+ *  \tparam shuffle  Shuffle::off for this overload
+ *
+ *  \param policy    The execution policy within a color
+ *  \param rule      The rule, invoked with a single element
+ *  \param coloring  The coloring of the elements
+ *
+ *  \warning The rule must not access any shared mutable state, like the
+ *           model's random number generator, if applied in parallel.
+ */
+template<Shuffle shuffle = Shuffle::on,
+         class Rule,
+         class Element,
+         typename std::enable_if_t<shuffle == Shuffle::off, int> = 0>
+void apply_rule_colored (const ExecPolicy policy,
+                         Rule&& rule,
+                         const Coloring<Element>& coloring)
+{
+    for (const auto& color_class : coloring) {
+        if constexpr (std::is_void_v<std::invoke_result_t<Rule,
+                                                          const Element&>>)
+        {
+            std::for_each(policy, color_class.begin(), color_class.end(),
+                          [&rule](const auto& element){ rule(element); });
+        }
+        else {
+            std::for_each(policy, color_class.begin(), color_class.end(),
+                          [&rule](const auto& element){
+                              element->state = rule(element);
+                          });
+        }
+    }
+}
+
+/// Apply a rule asynchronously, color by color, in random order
+/** Before applying the rule, the order of the colors and the order of the
+ *  elements within each color are shuffled. The latter only matters for
+ *  sequential policies, but is done regardless to keep the sequence of
+ *  random numbers drawn independent of the policy.
+ *
+ *  \tparam shuffle  Shuffle::on for this overload
+ *
+ *  \param policy    The execution policy within a color
+ *  \param rule      The rule, invoked with a single element
+ *  \param coloring  The coloring of the elements; its color classes are
+ *                   shuffled in place.
+ *  \param rng       The random number generator used for shuffling
+ *
+ *  \warning The rule must not access any shared mutable state, like the
+ *           model's random number generator, if applied in parallel.
+ */
+template<Shuffle shuffle = Shuffle::on,
+         class Rule,
+         class Element,
+         class RNG,
+         typename std::enable_if_t<shuffle == Shuffle::on, int> = 0>
+void apply_rule_colored (const ExecPolicy policy,
+                         Rule&& rule,
+                         Coloring<Element>& coloring,
+                         RNG&& rng)
+{
+    std::vector<std::size_t> order(coloring.num_colors());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    for (const auto color : order) {
+        auto& color_class = coloring[color];
+        std::shuffle(color_class.begin(), color_class.end(), rng);
+
+        if constexpr (std::is_void_v<std::invoke_result_t<Rule,
+                                                          const Element&>>)
+        {
+            std::for_each(policy, color_class.begin(), color_class.end(),
+                          [&rule](const auto& element){ rule(element); });
+        }
+        else {
+            std::for_each(policy, color_class.begin(), color_class.end(),
+                          [&rule](const auto& element){
+                              element->state = rule(element);
+                          });
+        }
+    }
+}
+
+/// Apply a rule asynchronously and color by color, sequentially
+/** \overload
+ */
+template<Shuffle shuffle = Shuffle::on, class Rule, class Element,
+         class... Args>
+void apply_rule_colored (Rule&& rule,
+                         Coloring<Element>& coloring,
+                         Args&&... args)
+{
+    apply_rule_colored<shuffle>(ExecPolicy::seq,
+                                std::forward<Rule>(rule),
+                                coloring,
+                                std::forward<Args>(args)...);
+}
+
+/**
+ *  \} // endgroup Rules
+ */
+
+} // namespace Utopia
+
+#endif // UTOPIA_CORE_COLORING_HH
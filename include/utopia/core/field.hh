@@ -0,0 +1,642 @@
+#ifndef UTOPIA_CORE_FIELD_HH
+#define UTOPIA_CORE_FIELD_HH
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parallel.hh"
+#include "types.hh"
+#include "../data_io/cfg_utils.hh"
+#include "grids.hh"
+
+
+namespace Utopia {
+/**
+ *  \addtogroup CellManager
+ *  \{
+ */
+
+/// How a Field treats the values beyond its boundary
+enum class FieldBoundary {
+    /// The field wraps around, like a periodic grid
+    periodic,
+    /// Beyond the boundary, all values equal the fixed boundary value
+    fixed
+};
+
+
+/// A dense scalar field on a two-dimensional square grid
+/** The field stores one value per cell in a contiguous array, indexed by the
+ *  cell IDs of the grid, i.e. with the first dimension running fastest. This
+ *  makes it a lightweight alternative to storing continuous quantities like
+ *  concentrations or heights within the cell states: updates touching all
+ *  cells, like diffusion, run over contiguous memory and can be vectorized by
+ *  the compiler rather than going through a rule per cell.
+ *
+ *  The stencil operations (map_vonNeumann, map_Moore, and the derived
+ *  laplacian, gradient, neighbor_sum, neighbor_min and neighbor_max) go
+ *  through the field row by row. Within a row, the interior cells access their
+ *  neighbors via fixed offsets, such that the loop over them is vectorizable
+ *  for simple operations; only the first and the last cell of a row need
+ *  special treatment. Given a parallel execution policy, the rows are
+ *  distributed among threads.
+ *
+ *  As the storage order equals that of the cell IDs, the values can be
+ *  written to a dataset created via Model::create_cm_dset directly, e.g.
+ *  `dset->write(field.values())`.
+ *
+ *  A field can also hold several replicas of the values, e.g. to advance an
+ *  ensemble of independent realizations of a model in lockstep. The values of
+ *  the replicas of a cell are stored next to each other, such that a stencil
+ *  operation treats all replicas in the same vectorizable loop. Use
+ *  Utopia::split_rng for independent random number streams per replica and
+ *  Model::create_cm_replica_dsets for the output.
+ *
+ *  \tparam T  The value type, typically `double`
+ */
+template<typename T>
+class Field {
+public:
+    /// The value type
+    using Value = T;
+
+    /// The type of the shape: the number of cells in each dimension
+    using Shape = std::array<std::size_t, 2>;
+
+private:
+    /// The number of cells in each dimension
+    Shape _shape;
+
+    /// The number of replicas of each value
+    std::size_t _num_replicas;
+
+    /// The values, indexed by cell ID, with the replicas running fastest
+    std::vector<T> _values;
+
+    /// The boundary condition
+    FieldBoundary _boundary;
+
+    /// The value beyond the boundary for FieldBoundary::fixed
+    T _boundary_value;
+
+    /// A row of boundary values, used as neighboring row of boundary rows
+    std::vector<T> _boundary_row;
+
+public:
+    /// Construct a field of the given shape
+    /** \param shape           The number of cells in each dimension
+     *  \param initial_value   The value of all cells
+     *  \param boundary        The boundary condition
+     *  \param boundary_value  The value beyond the boundary for a fixed
+     *                         boundary condition
+     *  \param num_replicas    The number of replicas of each value
+     */
+    Field (const Shape& shape,
+           const T initial_value = T{},
+           const FieldBoundary boundary = FieldBoundary::periodic,
+           const T boundary_value = T{},
+           const std::size_t num_replicas = 1)
+    :
+        _shape(shape),
+        _num_replicas(num_replicas),
+        _values(shape[0] * shape[1] * num_replicas, initial_value),
+        _boundary(boundary),
+        _boundary_value(boundary_value),
+        _boundary_row(shape[0] * num_replicas, boundary_value)
+    {
+        if (shape[0] == 0 or shape[1] == 0) {
+            throw std::invalid_argument("The shape of a field needs to be "
+                "positive in each dimension, but was ("
+                + std::to_string(shape[0]) + ", "
+                + std::to_string(shape[1]) + ")!");
+        }
+        if (num_replicas == 0) {
+            throw std::invalid_argument("A field needs at least one "
+                                        "replica!");
+        }
+    }
+
+    /// Construct a field on the cells of a grid
+    /** The field has the shape of the grid and, if the grid is periodic, a
+     *  periodic boundary condition. Otherwise, the values beyond the boundary
+     *  are fixed to `boundary_value`.
+     *
+     *  \param grid            A two-dimensional square grid, e.g. the one
+     *                         of a CellManager (see CellManager::grid)
+     *  \param initial_value   The value of all cells
+     *  \param boundary_value  The value beyond the boundary, if the grid is
+     *                         not periodic
+     *  \param num_replicas    The number of replicas of each value
+     */
+    template<class Space>
+    Field (const Grid<Space>& grid,
+           const T initial_value = T{},
+           const T boundary_value = T{},
+           const std::size_t num_replicas = 1)
+    :
+        Field(shape_of(grid), initial_value,
+              grid.is_periodic() ? FieldBoundary::periodic
+                                 : FieldBoundary::fixed,
+              boundary_value, num_replicas)
+    {}
+
+
+    // -- Access --------------------------------------------------------------
+
+    /// The number of cells in each dimension
+    const Shape& shape () const {
+        return _shape;
+    }
+
+    /// The number of cells
+    std::size_t num_cells () const {
+        return _shape[0] * _shape[1];
+    }
+
+    /// The number of replicas of each value
+    std::size_t num_replicas () const {
+        return _num_replicas;
+    }
+
+    /// The number of values, i.e. the number of cells times replicas
+    std::size_t size () const {
+        return _values.size();
+    }
+
+    /// The boundary condition
+    FieldBoundary boundary () const {
+        return _boundary;
+    }
+
+    /// The value beyond the boundary for a fixed boundary condition
+    const T& boundary_value () const {
+        return _boundary_value;
+    }
+
+    /// Set the boundary condition
+    void set_boundary (const FieldBoundary boundary,
+                       const T boundary_value = T{})
+    {
+        _boundary = boundary;
+        _boundary_value = boundary_value;
+        std::fill(_boundary_row.begin(), _boundary_row.end(), boundary_value);
+    }
+
+    /// The value at the given position in storage
+    /** For a field with a single replica, this is the cell ID; otherwise, the
+     *  position is `id * num_replicas() + replica`.
+     */
+    T& operator[] (const std::size_t pos) {
+        return _values[pos];
+    }
+
+    /// The value at the given position in storage
+    const T& operator[] (const std::size_t pos) const {
+        return _values[pos];
+    }
+
+    /// The value of the cell with the given multi-index
+    T& operator() (const std::size_t x,
+                   const std::size_t y,
+                   const std::size_t replica = 0)
+    {
+        return _values[(x + y * _shape[0]) * _num_replicas + replica];
+    }
+
+    /// The value of the cell with the given multi-index
+    const T& operator() (const std::size_t x,
+                         const std::size_t y,
+                         const std::size_t replica = 0) const
+    {
+        return _values[(x + y * _shape[0]) * _num_replicas + replica];
+    }
+
+    /// The value at a (possibly out-of-range) multi-index
+    /** Indices beyond the boundary are mapped according to the boundary
+     *  condition.
+     */
+    T at (const long x, const long y, const std::size_t replica = 0) const {
+        const long nx = _shape[0], ny = _shape[1];
+        if (x >= 0 and x < nx and y >= 0 and y < ny) {
+            return (*this)(x, y, replica);
+        }
+        if (_boundary == FieldBoundary::fixed) {
+            return _boundary_value;
+        }
+        return (*this)(((x % nx) + nx) % nx, ((y % ny) + ny) % ny, replica);
+    }
+
+    /// All values, in order of the cell IDs, the replicas running fastest
+    std::vector<T>& values () {
+        return _values;
+    }
+
+    /// All values, in order of the cell IDs, the replicas running fastest
+    const std::vector<T>& values () const {
+        return _values;
+    }
+
+    /// A copy of the values of a single replica, in order of the cell IDs
+    std::vector<T> replica_values (const std::size_t replica) const {
+        if (replica >= _num_replicas) {
+            throw std::invalid_argument("Cannot get the values of replica "
+                + std::to_string(replica) + " of a field with "
+                + std::to_string(_num_replicas) + " replica(s)!");
+        }
+
+        std::vector<T> values(num_cells());
+        for (std::size_t id = 0; id < values.size(); ++id) {
+            values[id] = _values[id * _num_replicas + replica];
+        }
+        return values;
+    }
+
+    /// Pointer to the contiguous values
+    T* data () {
+        return _values.data();
+    }
+
+    /// Pointer to the contiguous values
+    const T* data () const {
+        return _values.data();
+    }
+
+    auto begin () { return _values.begin(); }
+    auto end () { return _values.end(); }
+    auto begin () const { return _values.begin(); }
+    auto end () const { return _values.end(); }
+
+    /// Set all values
+    void fill (const T value) {
+        std::fill(_values.begin(), _values.end(), value);
+    }
+
+
+    // -- Exchange with entities ----------------------------------------------
+
+    /// Set the values from entities, e.g. the cells of a CellManager
+    /** With several replicas, all replicas of a cell are set to the value.
+     *
+     *  \param entities  The entities, in order of the cell IDs
+     *  \param get       Returns the value for an entity
+     */
+    template<class Container, class Getter>
+    void gather (const Container& entities, Getter&& get) {
+        check_size(entities.size());
+        auto value = _values.begin();
+        for (const auto& entity : entities) {
+            value = std::fill_n(value, _num_replicas, get(entity));
+        }
+    }
+
+    /// Pass the values to entities, e.g. the cells of a CellManager
+    /** \param entities  The entities, in order of the cell IDs
+     *  \param set       Invoked with each entity and its value
+     *  \param replica   The replica whose values are passed
+     */
+    template<class Container, class Setter>
+    void scatter (const Container& entities,
+                  Setter&& set,
+                  const std::size_t replica = 0) const
+    {
+        check_size(entities.size());
+        std::size_t pos = replica;
+        for (const auto& entity : entities) {
+            set(entity, _values[pos]);
+            pos += _num_replicas;
+        }
+    }
+
+
+    // -- Stencil operations --------------------------------------------------
+
+    /// Compute a value from each cell and its von-Neumann neighbors
+    /** With several replicas, the neighbors are those within the same
+     *  replica.
+     *
+     *  \param policy  The execution policy; rows are processed in parallel
+     *  \param out     The field to store the results in; needs to be of the
+     *                 same shape and number of replicas and must not be this
+     *                 field
+     *  \param op      Invoked as `op(center, left, right, down, up)`, where
+     *                 left and right are the neighbors in the first dimension
+     *                 and down and up those in the second dimension
+     */
+    template<typename R, class Op>
+    void map_vonNeumann (const ExecPolicy policy, Field<R>& out, Op&& op) const
+    {
+        check_output(out);
+        for_each_row(policy, [this, &out, &op](const std::size_t y){
+            const std::size_t nx = _shape[0], nr = _num_replicas;
+            const T* row = data() + y * nx * nr;
+            const T* down = neighbor_row(y, -1);
+            const T* up = neighbor_row(y, +1);
+            R* res = out.data() + y * nx * nr;
+
+            // The edge columns, whose neighbors depend on the boundary
+            for (std::size_t x = 0; x < nx; x += std::max<std::size_t>(nx-1, 1))
+            {
+                for (std::size_t r = 0, i = x * nr; r < nr; ++r, ++i) {
+                    res[i] = op(row[i],
+                                at(long(x) - 1, y, r), at(long(x) + 1, y, r),
+                                down[i], up[i]);
+                }
+            }
+
+            // The interior, which is accessed via fixed offsets only; the
+            // replicas of a cell are adjacent, so neighbors are nr apart
+            for (std::size_t i = nr; i + nr < nx * nr; ++i) {
+                res[i] = op(row[i], row[i-nr], row[i+nr], down[i], up[i]);
+            }
+        });
+    }
+
+    /// Compute a value from each cell and its von-Neumann neighbors
+    /** \see map_vonNeumann(const ExecPolicy, Field<R>&, Op&&) const
+     */
+    template<typename R, class Op>
+    void map_vonNeumann (Field<R>& out, Op&& op) const {
+        map_vonNeumann(ExecPolicy::seq, out, std::forward<Op>(op));
+    }
+
+    /// Compute a value from each cell and its Moore neighbors
+    /** \param policy  The execution policy; rows are processed in parallel
+     *  \param out     The field to store the results in; needs to be of the
+     *                 same shape and number of replicas and must not be this
+     *                 field
+     *  \param op      Invoked as `op(center, left, right, down, up,
+     *                 down_left, down_right, up_left, up_right)`, see
+     *                 map_vonNeumann
+     */
+    template<typename R, class Op>
+    void map_Moore (const ExecPolicy policy, Field<R>& out, Op&& op) const {
+        check_output(out);
+        for_each_row(policy, [this, &out, &op](const std::size_t y){
+            const std::size_t nx = _shape[0], nr = _num_replicas;
+            const T* row = data() + y * nx * nr;
+            const T* down = neighbor_row(y, -1);
+            const T* up = neighbor_row(y, +1);
+            R* res = out.data() + y * nx * nr;
+
+            // The edge columns, whose neighbors depend on the boundary
+            for (std::size_t x = 0; x < nx; x += std::max<std::size_t>(nx-1, 1))
+            {
+                const long l = long(x) - 1, r = long(x) + 1;
+                const long d = long(y) - 1, u = long(y) + 1;
+                for (std::size_t k = 0, i = x * nr; k < nr; ++k, ++i) {
+                    res[i] = op(row[i], at(l, y, k), at(r, y, k),
+                                down[i], up[i],
+                                at(l, d, k), at(r, d, k),
+                                at(l, u, k), at(r, u, k));
+                }
+            }
+
+            for (std::size_t i = nr; i + nr < nx * nr; ++i) {
+                res[i] = op(row[i], row[i-nr], row[i+nr], down[i], up[i],
+                            down[i-nr], down[i+nr], up[i-nr], up[i+nr]);
+            }
+        });
+    }
+
+    /// Compute a value from each cell and its Moore neighbors
+    /** \see map_Moore(const ExecPolicy, Field<R>&, Op&&) const
+     */
+    template<typename R, class Op>
+    void map_Moore (Field<R>& out, Op&& op) const {
+        map_Moore(ExecPolicy::seq, out, std::forward<Op>(op));
+    }
+
+    /// Compute the discrete Laplacian using the five-point stencil
+    /** The result is in units of the cell size, i.e. needs to be divided by
+     *  the squared cell size to obtain the Laplacian in units of space.
+     */
+    template<typename R>
+    void laplacian (const ExecPolicy policy, Field<R>& out) const {
+        map_vonNeumann(policy, out, [](const T c, const T l, const T r,
+                                       const T d, const T u)
+        {
+            return (l + r) + (d + u) - 4 * c;
+        });
+    }
+
+    /// Compute the discrete Laplacian using the five-point stencil
+    template<typename R>
+    void laplacian (Field<R>& out) const {
+        laplacian(ExecPolicy::seq, out);
+    }
+
+    /// Compute the gradient using central differences
+    /** The result is in units of the cell size, see laplacian.
+     *
+     *  \param policy  The execution policy
+     *  \param out_x   The derivative along the first dimension
+     *  \param out_y   The derivative along the second dimension
+     */
+    template<typename R>
+    void gradient (const ExecPolicy policy,
+                   Field<R>& out_x,
+                   Field<R>& out_y) const
+    {
+        map_vonNeumann(policy, out_x, [](const T, const T l, const T r,
+                                         const T, const T)
+        {
+            return (r - l) / 2;
+        });
+        map_vonNeumann(policy, out_y, [](const T, const T, const T,
+                                         const T d, const T u)
+        {
+            return (u - d) / 2;
+        });
+    }
+
+    /// Compute the gradient using central differences
+    template<typename R>
+    void gradient (Field<R>& out_x, Field<R>& out_y) const {
+        gradient(ExecPolicy::seq, out_x, out_y);
+    }
+
+    /// Compute the sum over the neighbors of each cell
+    /** \param policy   The execution policy
+     *  \param out      The field to store the results in
+     *  \param nb_mode  NBMode::vonNeumann or NBMode::Moore
+     */
+    template<typename R>
+    void neighbor_sum (const ExecPolicy policy,
+                       Field<R>& out,
+                       const NBMode nb_mode = NBMode::vonNeumann) const
+    {
+        reduce_neighbors(policy, out, nb_mode,
+            [](const T a, const T b){ return a + b; });
+    }
+
+    /// Compute the sum over the neighbors of each cell
+    template<typename R>
+    void neighbor_sum (Field<R>& out,
+                       const NBMode nb_mode = NBMode::vonNeumann) const
+    {
+        neighbor_sum(ExecPolicy::seq, out, nb_mode);
+    }
+
+    /// Compute the minimum over the neighbors of each cell
+    /** With a fixed boundary condition, the boundary value is taken into
+     *  account for the cells at the boundary.
+     *
+     *  \param policy   The execution policy
+     *  \param out      The field to store the results in
+     *  \param nb_mode  NBMode::vonNeumann or NBMode::Moore
+     */
+    template<typename R>
+    void neighbor_min (const ExecPolicy policy,
+                       Field<R>& out,
+                       const NBMode nb_mode = NBMode::vonNeumann) const
+    {
+        reduce_neighbors(policy, out, nb_mode,
+            [](const T a, const T b){ return std::min(a, b); });
+    }
+
+    /// Compute the minimum over the neighbors of each cell
+    template<typename R>
+    void neighbor_min (Field<R>& out,
+                       const NBMode nb_mode = NBMode::vonNeumann) const
+    {
+        neighbor_min(ExecPolicy::seq, out, nb_mode);
+    }
+
+    /// Compute the maximum over the neighbors of each cell
+    /** \see neighbor_min
+     */
+    template<typename R>
+    void neighbor_max (const ExecPolicy policy,
+                       Field<R>& out,
+                       const NBMode nb_mode = NBMode::vonNeumann) const
+    {
+        reduce_neighbors(policy, out, nb_mode,
+            [](const T a, const T b){ return std::max(a, b); });
+    }
+
+    /// Compute the maximum over the neighbors of each cell
+    template<typename R>
+    void neighbor_max (Field<R>& out,
+                       const NBMode nb_mode = NBMode::vonNeumann) const
+    {
+        neighbor_max(ExecPolicy::seq, out, nb_mode);
+    }
+
+private:
+    /// The shape of a grid, which needs to be a two-dimensional square grid
+    template<class Space>
+    static Shape shape_of (const Grid<Space>& grid) {
+        static_assert(Space::dim == 2,
+                      "A Field can only be constructed on a two-dimensional "
+                      "grid!");
+
+        if (grid.structure() != GridStructure::square) {
+            throw std::invalid_argument("A Field can only be constructed on "
+                "a square grid, but the grid structure is '"
+                + grid.structure_name() + "'!");
+        }
+        const auto shape = grid.shape();
+        return {shape[0], shape[1]};
+    }
+
+    /// Reduce over the neighbors of each cell with a binary operation
+    template<typename R, class BinaryOp>
+    void reduce_neighbors (const ExecPolicy policy,
+                           Field<R>& out,
+                           const NBMode nb_mode,
+                           BinaryOp&& f) const
+    {
+        if (nb_mode == NBMode::Moore) {
+            map_Moore(policy, out, [&f](const T, const T l, const T r,
+                                        const T d, const T u,
+                                        const T dl, const T dr,
+                                        const T ul, const T ur)
+            {
+                return f(f(f(l, r), f(d, u)), f(f(dl, dr), f(ul, ur)));
+            });
+            return;
+        }
+        else if (nb_mode != NBMode::vonNeumann) {
+            throw std::invalid_argument("Stencil operations on fields are "
+                "only available for the vonNeumann and Moore neighborhoods, "
+                "but got '" + nb_mode_to_string(nb_mode) + "'!");
+        }
+
+        map_vonNeumann(policy, out, [&f](const T, const T l, const T r,
+                                         const T d, const T u)
+        {
+            return f(f(l, r), f(d, u));
+        });
+    }
+
+    /// Invoke a function for each row index, possibly in parallel
+    template<class Func>
+    void for_each_row (const ExecPolicy policy, Func&& func) const {
+        if (policy == ExecPolicy::seq) {
+            for (std::size_t y = 0; y < _shape[1]; ++y) {
+                func(y);
+            }
+            return;
+        }
+
+        std::vector<std::size_t> rows(_shape[1]);
+        std::iota(rows.begin(), rows.end(), 0);
+        std::for_each(policy, rows.begin(), rows.end(), func);
+    }
+
+    /// The row adjacent to row y, taking into account the boundary
+    const T* neighbor_row (const std::size_t y, const int offset) const {
+        const std::size_t ny = _shape[1];
+        const bool beyond = (offset < 0) ? (y == 0) : (y + 1 == ny);
+
+        const std::size_t row_size = _shape[0] * _num_replicas;
+
+        if (not beyond) {
+            return data() + (y + offset) * row_size;
+        }
+        if (_boundary == FieldBoundary::fixed) {
+            return _boundary_row.data();
+        }
+        return data() + ((offset < 0) ? (ny - 1) : 0) * row_size;
+    }
+
+    /// Throw if the given number of entries does not match the cells
+    void check_size (const std::size_t num) const {
+        if (num != num_cells()) {
+            throw std::invalid_argument("Mismatch between the number of cells "
+                "of the field (" + std::to_string(num_cells()) + ") and the "
+                "number of given entries (" + std::to_string(num) + ")!");
+        }
+    }
+
+    /// Throw if a field cannot hold the output of a stencil operation
+    template<typename R>
+    void check_output (const Field<R>& out) const {
+        if (out.shape() != _shape or out.num_replicas() != _num_replicas) {
+            throw std::invalid_argument("The output field of a stencil "
+                "operation needs to be of the same shape and number of "
+                "replicas as the input!");
+        }
+        if (static_cast<const void*>(out.data())
+            == static_cast<const void*>(data()))
+        {
+            throw std::invalid_argument("The output field of a stencil "
+                "operation needs to be different from the input!");
+        }
+    }
+};
+
+/**
+ *  \} // endgroup CellManager
+ */
+
+} // namespace Utopia
+
+#endif // UTOPIA_CORE_FIELD_HH
@@ -5,5 +5,6 @@
 #include "grids/square.hh"
 #include "grids/triangular.hh"
 #include "grids/hexagonal.hh"
+#include "grids/memory_order.hh"
 
 #endif // UTOPIA_CORE_GRIDS_HH
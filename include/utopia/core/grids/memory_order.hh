@@ -0,0 +1,109 @@
+#ifndef UTOPIA_CORE_GRIDS_MEMORY_ORDER_HH
+#define UTOPIA_CORE_GRIDS_MEMORY_ORDER_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../types.hh"
+#include "../space_filling_curves.hh"
+
+namespace Utopia {
+/**
+ *  \addtogroup CellManager
+ *  \{
+ */
+
+/// The order in which cells are laid out in memory
+/** This does not affect the cell IDs or their multi-indices, only where the
+  * cells reside relative to each other. Orders following a space-filling
+  * curve place cells that are close in space close in memory, such that the
+  * neighbors of a cell are more likely to share its cache lines.
+  */
+enum class MemoryOrder {
+    /// In order of the cell IDs, i.e. row by row
+    row_major,
+    /// Row by row within square tiles, the tiles again being row by row
+    tiled,
+    /// Along the Z-order (Morton) curve, interleaving the index bits
+    morton,
+    /// Along the Hilbert curve; only available in two dimensions
+    hilbert
+};
+// NOTE When adding new memory orders, take care to update memory_order_map!
+
+/// A map from strings to memory order enum values
+const std::map<std::string, MemoryOrder> memory_order_map {
+    {"row_major",   MemoryOrder::row_major},
+    {"tiled",       MemoryOrder::tiled},
+    {"morton",      MemoryOrder::morton},
+    {"hilbert",     MemoryOrder::hilbert}
+};
+
+
+/// Determine the order in which the cells of a grid are laid out in memory
+/** \param grid       The grid discretization
+  * \param order      The memory order
+  * \param tile_size  The side length of the tiles for MemoryOrder::tiled
+  *
+  * \return The cell IDs in the order they are to be stored in
+  */
+template<class GridType>
+IndexContainer memory_order_of (const GridType& grid,
+                                const MemoryOrder order,
+                                const DistType tile_size = 8)
+{
+    IndexContainer ids(grid.num_cells());
+    std::iota(ids.begin(), ids.end(), 0);
+
+    if (order == MemoryOrder::row_major) {
+        return ids;
+    }
+    if (order == MemoryOrder::tiled and tile_size == 0) {
+        throw std::invalid_argument("The tile size of the tiled memory order "
+                                    "needs to be positive!");
+    }
+    if (order == MemoryOrder::hilbert and GridType::dim != 2) {
+        throw std::invalid_argument("The hilbert memory order is only "
+                                    "available for two-dimensional grids!");
+    }
+
+    const auto shape = grid.shape();
+    std::uint64_t n = 1;
+    while (n < shape.max()) {
+        n *= 2;
+    }
+
+    // Compute the position of each cell along the curve and sort by it
+    std::vector<std::uint64_t> keys(ids.size());
+    for (const auto id : ids) {
+        const auto midx = grid.midx_of(id);
+
+        if (order == MemoryOrder::tiled) {
+            keys[id] = tiled_key(midx, shape, tile_size);
+        }
+        else if (order == MemoryOrder::morton) {
+            keys[id] = morton_key(midx);
+        }
+        else if constexpr (GridType::dim == 2) {
+            keys[id] = hilbert_key(n, midx[0], midx[1]);
+        }
+    }
+
+    std::stable_sort(ids.begin(), ids.end(),
+        [&keys](const auto a, const auto b){ return keys[a] < keys[b]; }
+    );
+    return ids;
+}
+
+/**
+ *  \} // endgroup CellManager
+ */
+
+} // namespace Utopia
+
+#endif // UTOPIA_CORE_GRIDS_MEMORY_ORDER_HH
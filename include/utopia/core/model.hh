@@ -2,6 +2,10 @@
 #define UTOPIA_CORE_MODEL_HH
 
 #include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "exceptions.hh"
 #include "signal.hh"
@@ -9,9 +13,12 @@
 #include "logging.hh"
 #include "space.hh"
 #include "parallel.hh"
+#include "observables.hh"
 
 #include "../data_io/hdffile.hh"
 #include "../data_io/hdfgroup.hh"
+#include "../data_io/hdfvirtual.hh"
+#include "../data_io/hdfdelta.hh"
 #include "../data_io/cfg_utils.hh"
 #include "../data_io/monitor.hh"
 #include "../data_io/data_manager/data_manager.hh"
@@ -172,6 +179,15 @@ protected:
     /// Model-internal maximum time stamp
     const Time _time_max;
 
+    /// The separate file this model writes to, if its output is sharded
+    /** This is the case if the `shard_output` configuration entry is set;
+      * otherwise, this is a nullptr. See setup_shard_file for details.
+      */
+    const std::shared_ptr<DataIO::HDFFile> _shard_file;
+
+    /// The group in the parent's file that exposes the sharded output
+    const std::shared_ptr<DataGroup> _shard_target;
+
     /// The HDF group this model instance should write its data to
     const std::shared_ptr<DataGroup> _hdfgrp;
 
@@ -184,9 +200,53 @@ protected:
     /// How often to call write_data from iterate
     const Time _write_every;
 
+    /// How many time slices datasets buffer before writing them to the file
+    /** \note This only applies to datasets created via create_dset
+      */
+    const std::size_t _write_buffer_size;
+
+    /// Whether datasets compress their chunks in parallel, see create_dset
+    const bool _direct_chunk_write;
+
+    /// The datasets that buffer time slices; flushed in the epilog
+    std::vector<std::weak_ptr<DataSet>> _buffered_dsets;
+
+    /// Datasets in the shard file not yet exposed in the parent's file
+    /** They are exposed once they were created, see __link_shard_dsets
+      */
+    std::vector<std::weak_ptr<DataSet>> _unlinked_dsets;
+
+    /// The datasets to flush after writing once in SWMR mode
+    /** These are opened before the switch to SWMR mode and thus need to be
+      * told about it, see __start_swmr_write
+      */
+    std::vector<std::weak_ptr<DataSet>> _swmr_dsets;
+
+    /// Whether the output file supports single-writer/multiple-reader access
+    const bool _swmr;
+
+    /// Whether the switch to SWMR mode is still to happen after the next write
+    bool _swmr_pending;
+
+    /// Whether iterate_submodels iterates the submodels concurrently
+    const bool _parallel_submodels;
+
+    /// Serializes monitoring and data output of all models in the hierarchy
+    /** This is shared between all models, such that submodels iterated
+      * concurrently do not call into the HDF5 library or update the monitor
+      * entries at the same time.
+      */
+    const std::shared_ptr<std::mutex> _output_mutex;
+
     /// The monitor
     Monitor _monitor;
 
+    /// Named quantities computed at most once per time step
+    /** Observables registered here are invalidated upon each increment of
+      * time; see ObservableRegistry for details.
+      */
+    ObservableRegistry _observables;
+
     /// Manager object for handling data output; see \ref DataManager
     /** \note The data manager is always constructed, but only used if the
       *       ``_write_mode`` was set to WriteMode::managed.
@@ -221,6 +281,67 @@ private:
         return log;
     }
 
+    /// Returns the RNG to use for this model
+    /** Usually, this is the RNG shared with the parent model. If the parent
+      * iterates its submodels concurrently, sharing it would lead to data
+      * races; the model then uses an RNG of its own, which is seeded with a
+      * number drawn from the parent's RNG. This RNG is shared with the
+      * submodels of this model.
+      */
+    template<class Parent>
+    std::shared_ptr<RNG> setup_rng(const Parent& parent_model) const {
+        if (not parent_model.get_parallel_submodels()) {
+            return parent_model.get_rng();
+        }
+        return std::make_shared<RNG>((*parent_model.get_rng())());
+    }
+
+    /// Opens a separate output file for this model, if configured
+    /** If the `shard_output` entry is set, this model (and all its
+      * submodels) write their data to a file of their own, placed next to
+      * the parent's output file and named after the full name of the model;
+      * see DataIO::shard_file_path. This keeps the writes of different
+      * models apart, such that they do not contend for the same file and
+      * metadata cache. The output is exposed in the parent's file via
+      * virtual datasets, such that readers see the usual layout: datasets
+      * created via create_dset are linked as soon as they were written to
+      * for the first time, all others when the model is destroyed.
+      *
+      * \note  Unless the HDF5 library was built thread-safe, HDF5 calls of
+      *        different threads need to be serialized nevertheless.
+      *
+      * \return The shard file or nullptr, if output is not sharded
+      */
+    template<class Parent>
+    std::shared_ptr<DataIO::HDFFile>
+        setup_shard_file(const Parent& parent_model) const
+    {
+        if (not get_as<bool>("shard_output", _cfg, false)) {
+            return nullptr;
+        }
+        if (parent_model.get_swmr()) {
+            throw std::invalid_argument("Model '" + _name + "' cannot shard "
+                "its output: sharded output is exposed by creating virtual "
+                "datasets, which is not possible in SWMR mode!");
+        }
+
+        const auto path = DataIO::shard_file_path(
+            DataIO::get_file_path(parent_model.get_hdfgrp()->get_C_id()),
+            _full_name.substr(1) // without the leading separator
+        );
+        _log->info("Writing output to shard file {} ...", path);
+        return std::make_shared<DataIO::HDFFile>(path, "w");
+    }
+
+    /// The name of the shard file, by which the parent's file refers to it
+    /** This is the file name only, such that the shard is found relative to
+      * the parent's file.
+      */
+    std::string get_shard_file_name() const {
+        const auto path = _shard_file->get_path();
+        return path.substr(path.find_last_of('/') + 1);
+    }
+
     /// Constructs the Space from configuration or uses the default Space
     auto setup_space() const {
         if (_cfg["space"]) {
@@ -240,6 +361,63 @@ private:
     }
 
 
+    /// Adds the attributes describing the grid of a CellManager
+    /** These allow to associate data of individual cells with their
+      * position in space.
+      */
+    template<class Object, class CellManager>
+    void add_grid_attributes(Object& obj, const CellManager& cm) const {
+        // Denote the grid structure, size, etc.
+        const auto grid_structure = cm.grid()->structure_name();
+        obj.add_attribute("grid_structure", grid_structure);
+        obj.add_attribute("grid_shape", cm.grid()->shape());
+        obj.add_attribute("space_extent", cm.grid()->space()->extent);
+        obj.add_attribute("periodic_space", cm.grid()->space()->periodic);
+
+        if (grid_structure == "hexagonal") {
+            // ... some additional info is needed, which is dependent on the
+            // way the HexagonalGrid maps cells
+            obj.add_attribute("coordinate_mode", "offset");
+            obj.add_attribute("offset_mode", "even");
+            obj.add_attribute("pointy_top", true);
+        }
+
+        // The CellManager uses "column-style" index ordering, also called
+        // "Fortran-style". This is relevant for assigning the correct IDs.
+        obj.add_attribute("index_order", "F");
+    }
+
+    /// Adds the attributes marking a dataset as storing data of all cells
+    template<class CellManager>
+    void add_cm_dset_attributes(DataSet& dset,
+                                const CellManager& cm,
+                                const std::string& name) const
+    {
+        // Set attributes to mark this dataset as containing grid data
+        dset.add_attribute("content", "grid");
+        add_grid_attributes(dset, cm);
+
+        _log->debug("Added attributes to dataset '{}' to mark it as storing "
+                    "grid data.", name);
+
+        // Write additional attributes, if not specifically suppressed.
+        if (get_as<bool>("write_dim_labels_and_coords", _cfg, true)) {
+            // We know that the dimensions here refer to (time, cell ids).
+            // The time information is already added in create_dset; only need
+            // to add the ID information here
+            dset.add_attribute("dim_name__1", "ids");
+
+            // For ids, the dimensions are trivial
+            dset.add_attribute("coords_mode__ids", "range");
+            dset.add_attribute("coords__ids",
+                               std::vector<std::size_t>{cm.cells().size()});
+
+            _log->debug("Added cell ID dimension labels and coordinates to "
+                        "dataset '{}'.", name);
+        }
+    }
+
+
 public:
     // -- Constructor ---------------------------------------------------------
 
@@ -288,7 +466,7 @@ public:
              : get_as<Config>(_name, parent_model.get_cfg())),
 
         // Construct infrastructure objects using information from parent
-        _rng(parent_model.get_rng()),
+        _rng(setup_rng(parent_model)),
         _log(setup_logger(parent_model)),
 
         // Determine space and time
@@ -299,15 +477,33 @@ public:
                                  std::numeric_limits<Time>::max())),
 
         // Extract the other information from the parent model object
-        _hdfgrp(parent_model.get_hdfgrp()->open_group(_name)),
+        _shard_file(setup_shard_file(parent_model)),
+        _shard_target(_shard_file ? parent_model.get_hdfgrp()->open_group(_name)
+                                  : nullptr),
+        _hdfgrp(_shard_file ? _shard_file->open_group(
+                                DataIO::get_object_path(
+                                    _shard_target->get_C_id()))
+                            : parent_model.get_hdfgrp()->open_group(_name)),
         _write_start(get_as<Time>("write_start", _cfg,
                                   parent_model.get_write_start())),
         _write_every(get_as<Time>("write_every", _cfg,
                                   parent_model.get_write_every())),
+        _write_buffer_size(get_as<std::size_t>("write_buffer_size", _cfg,
+                                       parent_model.get_write_buffer_size())),
+        _direct_chunk_write(get_as<bool>("direct_chunk_write", _cfg,
+                                      parent_model.get_direct_chunk_write())),
+        _buffered_dsets{},
+        _unlinked_dsets{},
+        _swmr_dsets{},
+        _swmr(parent_model.get_swmr()),
+        _swmr_pending(_swmr),
+        _parallel_submodels(get_as<bool>("parallel_submodels", _cfg, false)),
+        _output_mutex(parent_model.get_output_mutex()),
 
         // Set up the monitor, using the parent model's monitor to place it in
         // a hierarchy equivalent to the model hierarchy
         _monitor(_name, parent_model.get_monitor()),
+        _observables(),
 
         // Default-construct the data maanger; only used if needed, see below.
         _datamanager()
@@ -323,6 +519,8 @@ public:
             _log->info("  write_start: {:7d}", _write_start);
             _log->info("  write_every: {:7d}", _write_every);
             _log->info("  #writes:     {:7d}", get_remaining_num_writes());
+            _log->info("  write_buffer_size: {:d}", _write_buffer_size);
+            _log->info("  direct_chunk_write: {}", _direct_chunk_write);
 
             // Store relevant info in base group attributes
             _hdfgrp->add_attribute("write_mode", "basic");
@@ -380,6 +578,35 @@ public:
         }
     }
 
+    /// Destructs a Model instance
+    /** If the output of this model is sharded, makes the remaining output,
+      * i.e. that not created via create_dset, available in the parent's file
+      * via virtual datasets and updates the attributes of those already
+      * linked; errors are only logged.
+      */
+    virtual ~Model () {
+        if (not _shard_file) {
+            return;
+        }
+
+        try {
+            for (const auto& weak_dset : _buffered_dsets) {
+                if (const auto dset = weak_dset.lock()) {
+                    dset->flush();
+                }
+            }
+
+            DataIO::link_virtual(*_hdfgrp, *_shard_target,
+                                 get_shard_file_name());
+            _log->info("Linked output shard {} into parent file.",
+                       get_shard_file_name());
+        }
+        catch (std::exception& e) {
+            _log->error("Failed to link output shard of model '{}': {}",
+                        _full_name, e.what());
+        }
+    }
+
 
 
     // -- Getters -------------------------------------------------------------
@@ -438,6 +665,31 @@ public:
         return _write_every;
     }
 
+    /// Return the number of time slices datasets buffer before writing
+    std::size_t get_write_buffer_size() const {
+        return _write_buffer_size;
+    }
+
+    /// Return whether datasets compress and write their chunks directly
+    bool get_direct_chunk_write() const {
+        return _direct_chunk_write;
+    }
+
+    /// Return whether the output file supports SWMR access
+    bool get_swmr() const {
+        return _swmr;
+    }
+
+    /// Return whether this model iterates its submodels concurrently
+    bool get_parallel_submodels() const {
+        return _parallel_submodels;
+    }
+
+    /// Return the mutex serializing the output of all models
+    std::shared_ptr<std::mutex> get_output_mutex() const {
+        return _output_mutex;
+    }
+
     /// return the datamanager
     DataManager get_datamanager() const {
         return _datamanager;
@@ -491,6 +743,11 @@ public:
         return _monitor;
     }
 
+    /// Return the registry of observables of this model
+    ObservableRegistry& get_observables() {
+        return _observables;
+    }
+
     /// Get the monitor manager of the root model
     std::shared_ptr<MonitorManager> get_monitor_manager() const {
         return _monitor.get_monitor_manager();
@@ -529,40 +786,53 @@ public:
         __perform_step();
         increment_time();
 
-        // -- Monitoring
-        /* If the model is at the first hierarchical level, check whether the
-         * monitor entries should be collected and emitted. This leads to a
-         * flag being set in the monitor manager, such that the submodels do
-         * not have to do the check against the timer as well and that all
-         * collected data stems from the same time step.
-         */
-        if (_level == 1) {
-            _monitor.get_monitor_manager()->check_timer();
-            __monitor();
-
-            // If enabled for this step, perform the emission of monitor data
-            // NOTE At this point, we can be sure that all submodels have
-            //      already run, because their iterate functions were called
-            //      in the perform_step of the level 1 model.
-            _monitor.get_monitor_manager()->emit_if_enabled();
-        }
-        else {
-            __monitor();
-        }
+        // Monitoring and data output may not happen concurrently to that of
+        // other models, see iterate_submodels. While holding the lock, this
+        // thread may not take on the step of another submodel, which would
+        // wait for the lock as well.
+        ParallelExecution::isolate([this](){
+            const std::lock_guard<std::mutex> output_lock(*_output_mutex);
+
+            // -- Monitoring
+            /* If the model is at the first hierarchical level, check whether
+             * the monitor entries should be collected and emitted. This leads
+             * to a flag being set in the monitor manager, such that the
+             * submodels do not have to do the check against the timer as
+             * well and that all collected data stems from the same time step.
+             */
+            if (_level == 1) {
+                _monitor.get_monitor_manager()->check_timer();
+                __monitor();
+
+                // If enabled for this step, emit the monitor data
+                // NOTE At this point, we can be sure that all submodels have
+                //      already run, because their iterate functions were
+                //      called in the perform_step of the level 1 model.
+                _monitor.get_monitor_manager()->emit_if_enabled();
+            }
+            else {
+                __monitor();
+            }
 
-        // -- Data output
-        if constexpr (_write_mode == WriteMode::basic) {
-            if (    (_time >= _write_start)
-                and (_time - _write_start) % _write_every == 0) {
+            // -- Data output
+            if constexpr (_write_mode == WriteMode::basic) {
+                if (    (_time >= _write_start)
+                    and (_time - _write_start) % _write_every == 0) {
+                    __write_data();
+                }
+            }
+            else if constexpr (_write_mode == WriteMode::manual) {
                 __write_data();
             }
-        }
-        else if constexpr (_write_mode == WriteMode::manual) {
-            __write_data();
-        }
-        else if constexpr (_write_mode == WriteMode::managed) {
-            _datamanager(static_cast<Derived&>(*this));
-        }
+            else if constexpr (_write_mode == WriteMode::managed) {
+                _datamanager(static_cast<Derived&>(*this));
+                __link_shard_dsets();
+
+                if (_swmr_pending) {
+                    __start_swmr_write();
+                }
+            }
+        });
 
         if (_level == 1) {
             _log->debug("Finished iteration: {:7d} / {:d}", _time, _time_max);
@@ -572,6 +842,85 @@ public:
         }
     }
 
+    /// Iterate the given submodels, concurrently if configured
+    /** Meant to be called from perform_step of a model that nests other
+     *  models. By default, the submodels are iterated sequentially, in the
+     *  given order. If the `parallel_submodels` entry of this model's
+     *  configuration is set, the submodels are iterated concurrently and
+     *  this function returns once all of them finished their step. If
+     *  parallel execution is enabled and the backend provides a thread pool,
+     *  each submodel step is a task in the configured task arena, see
+     *  ParallelExecution::run_tasks. Otherwise, each submodel is iterated on
+     *  a thread of its own.
+     *
+     *  Monitoring and data output of the submodels (and their submodels) are
+     *  serialized, while their perform_step runs concurrently. This requires
+     *  the submodels to be independent of each other within a step, i.e.
+     *  they may only interact before or after this call. Concurrently
+     *  iterated submodels use RNGs of their own, see setup_rng.
+     *
+     *  \warning Submodels iterated concurrently may not access the HDF5 file
+     *           from their perform_step, unless holding the lock of the
+     *           mutex returned by get_output_mutex.
+     *
+     *  If iterating a submodel throws, the exception is re-thrown after all
+     *  submodels finished their step.
+     *
+     *  \param submodels The submodels to iterate
+     */
+    template<class... Submodels>
+    void iterate_submodels (Submodels&... submodels) {
+        if (not _parallel_submodels or sizeof...(Submodels) < 2) {
+            (submodels.iterate(), ...);
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors;
+        std::mutex errors_mutex;
+        auto iterate = [&errors, &errors_mutex](auto& submodel) {
+            try {
+                submodel.iterate();
+            }
+            catch (...) {
+                const std::lock_guard<std::mutex> lock(errors_mutex);
+                errors.push_back(std::current_exception());
+            }
+        };
+
+        // Prefer the thread pool of the parallel backend over new threads
+        if (ParallelExecution::has_task_pool()) {
+            ParallelExecution::run_tasks([&iterate, &submodels](){
+                iterate(submodels);
+            }...);
+
+            if (not errors.empty()) {
+                std::rethrow_exception(errors.front());
+            }
+            return;
+        }
+
+        // Otherwise, iterate all but the first submodel on separate threads,
+        // the first one on this thread, then wait for all others to finish
+        std::vector<std::thread> threads;
+        threads.reserve(sizeof...(Submodels) - 1);
+
+        auto launch = [&](auto& first, auto&... others) {
+            (threads.emplace_back([&iterate, &others](){
+                iterate(others);
+            }), ...);
+            iterate(first);
+        };
+        launch(submodels...);
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (not errors.empty()) {
+            std::rethrow_exception(errors.front());
+        }
+    }
+
     /// Run the model from the current time to the maximum time
     /** This repeatedly calls the iterate method until the maximum time is
       * reached. Additionally, it calls the ``__write_data`` method to allow
@@ -660,6 +1009,94 @@ protected:
     void __write_data () {
         _log->trace("Calling write_data ...");
         impl().write_data();
+        __link_shard_dsets();
+
+        if (_swmr_pending) {
+            __start_swmr_write();
+        }
+    }
+
+    /// Expose the datasets of the shard file that were created by now
+    /** Creates virtual datasets in the parent's file for those datasets
+      * created via create_dset that were written to for the first time.
+      * As they map the whole time dimension, data written later on is
+      * visible as well, such that the parent's file is complete even if the
+      * model is not destroyed regularly.
+      */
+    void __link_shard_dsets () {
+        if (_unlinked_dsets.empty()) {
+            return;
+        }
+
+        const auto grp_path = DataIO::get_object_path(_hdfgrp->get_C_id());
+        bool linked = false;
+
+        for (auto it = _unlinked_dsets.begin(); it != _unlinked_dsets.end();)
+        {
+            const auto dset = it->lock();
+            if (dset and not dset->is_valid()) {
+                // Not created yet
+                ++it;
+                continue;
+            }
+
+            if (dset) {
+                const auto path = DataIO::get_object_path(dset->get_C_id());
+                DataIO::create_virtual_dataset(
+                    _shard_target->get_C_id(),
+                    path.substr(grp_path.size() + 1),
+                    dset->get_C_id(), get_shard_file_name()
+                );
+                linked = true;
+            }
+            it = _unlinked_dsets.erase(it);
+        }
+
+        if (linked) {
+            H5Fflush(_shard_target->get_C_id(), H5F_SCOPE_LOCAL);
+        }
+    }
+
+    /// Switch the output file to single-writer/multiple-reader (SWMR) mode
+    /** This happens after the first write of each model, as all datasets
+      * need to exist by then; buffered time slices are flushed for that
+      * purpose. The level 1 model, writing after its submodels, then
+      * performs the actual switch, after which readers can follow the
+      * output while the simulation is running.
+      *
+      * \note No further datasets, groups, or attributes can be created
+      *       afterwards; submodels need to write for the first time no
+      *       later than the level 1 model.
+      */
+    void __start_swmr_write () {
+        _swmr_pending = false;
+
+        for (const auto& weak_dset : _buffered_dsets) {
+            if (const auto dset = weak_dset.lock()) {
+                dset->flush();
+            }
+        }
+
+        if (_level == 1) {
+            _log->info("Switching output file to SWMR mode ...");
+            DataIO::start_swmr_write(_hdfgrp->get_C_id());
+        }
+
+        // Have the datasets flush after writing, such that readers see the
+        // data. For submodels, the switch only happens afterwards, but still
+        // before they write again.
+        for (const auto& weak_dset : _swmr_dsets) {
+            if (const auto dset = weak_dset.lock()) {
+                dset->set_swmr_flush(true);
+            }
+        }
+        if constexpr (_write_mode == WriteMode::managed) {
+            for (auto& [name, task] : _datamanager.get_tasks()) {
+                if (task->active_dataset) {
+                    task->active_dataset->set_swmr_flush(true);
+                }
+            }
+        }
     }
 
     /// Write the initial state
@@ -677,15 +1114,21 @@ protected:
         }
         else if constexpr (_write_mode == WriteMode::managed) {
             _datamanager(static_cast<Derived&>(*this));
+            __link_shard_dsets();
+
+            if (_swmr_pending) {
+                __start_swmr_write();
+            }
         }
 
     }
 
-    /// Increment time
+    /// Increment time and invalidate the cached observables
     /** \param dt Time increment, defaults to 1
      */
     void increment_time (const Time dt=1) {
         _time += dt;
+        _observables.invalidate();
     }
 
     /// The default prolog of a model
@@ -700,9 +1143,14 @@ protected:
 
     /// The default epilog of a model
     /** Default tasks:
-     *      None
+     *      - Write out the time slices still buffered in datasets
      */
     void __epilog () {
+        for (const auto& weak_dset : _buffered_dsets) {
+            if (const auto dset = weak_dset.lock()) {
+                dset->flush();
+            }
+        }
         this->_log->debug("Epilog finished.");
     }
 
@@ -737,6 +1185,13 @@ public:
      *        suppress writing of these attributes by setting the
      *        configuration entry _cfg['write_dim_labels_and_coords'] to false.
      *
+     * @note  The precision of floating-point data can be reduced per dataset
+     *        via the `output_precision` configuration entry, which maps
+     *        dataset names to a `mode` (`full`, `float32`, `scale_offset`, or
+     *        `bit_round`) and the number of `digits` to retain, e.g.
+     *        `output_precision: {height: {mode: bit_round, digits: 4}}`.
+     *        See DataIO::HDFDataset::set_float_precision for details.
+     *
      * @param name The name of the dataset
      * @param hdfgrp The parent HDFGroup
      * @param add_write_shape Additional write shape which, together with the
@@ -745,6 +1200,9 @@ public:
      *                        (capacity = (num_time_steps, add_write_shape)).
      * @param compression_level The compression level
      * @param chunksize The chunk size
+     * @param cfg_name  The name under which the output settings of the
+     *                  dataset are looked up in the configuration; if empty,
+     *                  the name of the dataset is used
 
      * @return std::shared_ptr<DataSet> The hdf dataset
      */
@@ -753,7 +1211,8 @@ public:
                     const std::shared_ptr<DataGroup>& hdfgrp,
                     std::vector<hsize_t> add_write_shape,
                     const std::size_t compression_level=1,
-                    const std::vector<hsize_t> chunksize={})
+                    const std::vector<hsize_t> chunksize={},
+                    const std::string cfg_name="")
     {
         _log->debug("Creating dataset '{}' in group '{}' ...",
                     name, hdfgrp->get_path());
@@ -770,6 +1229,55 @@ public:
                                                chunksize, compression_level);
         _log->debug("Successfully created dataset '{}'.", name);
 
+        // Let the dataset accumulate time slices and compress them on
+        // multiple threads, if configured. Remaining slices are written out
+        // in the epilog or when the dataset is closed.
+        if (_write_buffer_size > 1 or _direct_chunk_write) {
+            dset->set_write_buffer_size(_write_buffer_size);
+            dset->set_direct_chunk_write(_direct_chunk_write);
+            _buffered_dsets.push_back(dset);
+        }
+
+        if (_swmr) {
+            _swmr_dsets.push_back(dset);
+        }
+
+        // Datasets in the shard file are exposed in the parent's file once
+        // they were created, see __link_shard_dsets
+        if (_shard_file and DataIO::get_file_path(hdfgrp->get_C_id())
+                            == _shard_file->get_path())
+        {
+            const auto grp_path = DataIO::get_object_path(hdfgrp->get_C_id());
+            const auto base_path =
+                DataIO::get_object_path(_hdfgrp->get_C_id()) + "/";
+            if ((grp_path + "/").rfind(base_path, 0) == 0) {
+                _unlinked_dsets.push_back(dset);
+            }
+        }
+
+        // Reduce the precision of floating-point values, if configured
+        const auto& key = cfg_name.empty() ? name : cfg_name;
+        if (_cfg["output_precision"] and _cfg["output_precision"][key]) {
+            const auto prec_cfg = _cfg["output_precision"][key];
+            const auto mode = get_as<std::string>("mode", prec_cfg);
+            const auto precision = DataIO::float_precision_from_string(mode);
+
+            // Only the rounding modes need the number of digits to retain,
+            // for which there is no sensible default
+            unsigned int digits = 0;
+            if (   precision == DataIO::FloatPrecision::scale_offset
+                or precision == DataIO::FloatPrecision::bit_round)
+            {
+                digits = get_as<unsigned int>("digits", prec_cfg);
+            }
+
+            dset->set_float_precision(precision, digits);
+            dset->add_attribute("float_precision", mode);
+            dset->add_attribute("float_precision_digits", digits);
+            _log->debug("Storing dataset '{}' with float precision mode '{}' "
+                        "({} digits).", name, mode, digits);
+        }
+
         // Write further attributes, if not specifically suppressed
         if (get_as<bool>("write_dim_labels_and_coords", _cfg, true)) {
             // We know that dimension 0 is the time dimension. Add the
@@ -860,51 +1368,102 @@ public:
             chunksize
         );
 
-        // Set attributes to mark this dataset as containing grid data
-        dset->add_attribute("content", "grid");
+        add_cm_dset_attributes(*dset, cm, name);
+        return dset;
+    }
 
-        // Need further attributes to denote the grid structure, size, etc.
-        const auto grid_structure = cm.grid()->structure_name();
-        dset->add_attribute("grid_structure", grid_structure);
-        dset->add_attribute("grid_shape", cm.grid()->shape());
-        dset->add_attribute("space_extent", cm.grid()->space()->extent);
-        dset->add_attribute("periodic_space", cm.grid()->space()->periodic);
 
-        if (grid_structure == "hexagonal") {
-            // ... some additional info is needed, which is dependent on the
-            // way the HexagonalGrid maps cells
-            dset->add_attribute("coordinate_mode", "offset");
-            dset->add_attribute("offset_mode", "even");
-            dset->add_attribute("pointy_top", true);
-        }
+    /** @brief Create a writer storing data from a CellManager as changes
+     *
+     * Instead of writing the state of all cells each time, only the cells
+     * whose value changed since the previous write are stored, together
+     * with a full keyframe every `keyframe_interval` writes; see
+     * DataIO::DeltaWriter. In regimes where only few cells change per step,
+     * this reduces the output size considerably. The frame at a given time
+     * can be reconstructed using DataIO::load_delta_frame.
+     *
+     * The keyframes are stored in a group of the given name, which carries
+     * the same grid attributes as a dataset created via create_cm_dset; the
+     * changes are stored in the group `<name>_delta`.
+     *
+     * @param name              The name of the keyframe group
+     * @param cm                The CellManager whose cells' states are stored
+     * @param keyframe_interval After how many writes a full keyframe is
+     *                          stored; if 0, only the first write is
+     * @param compression_level The compression level
+     *
+     * @tparam T  The type of the stored values
+     *
+     * @return std::shared_ptr<DataIO::DeltaWriter<T>> The writer
+     */
+    template<class T, class CellManager>
+    std::shared_ptr<DataIO::DeltaWriter<T>>
+        create_cm_delta_dset(const std::string name,
+                             const CellManager& cm,
+                             const std::size_t keyframe_interval,
+                             const std::size_t compression_level=1)
+    {
+        const auto writer = std::make_shared<DataIO::DeltaWriter<T>>(
+            *_hdfgrp, name, cm.cells().size(), keyframe_interval,
+            compression_level
+        );
 
-        // The CellManager uses "column-style" index ordering, also called
-        // "Fortran-style". This is relevant for assigning the correct IDs.
-        dset->add_attribute("index_order", "F");
+        add_grid_attributes(*writer->get_keyframe_group(), cm);
 
-        _log->debug("Added attributes to dataset '{}' to mark it as storing "
-                    "grid data.", name);
+        _log->debug("Created delta-encoded grid output '{}' with a keyframe "
+                    "every {} writes.", name, keyframe_interval);
 
-        // Write additional attributes, if not specifically suppressed.
-        if (get_as<bool>("write_dim_labels_and_coords", _cfg, true)) {
-            // We know that the dimensions here refer to (time, cell ids).
-            // The time information is already added in create_dset; only need
-            // to add the ID information here
-            dset->add_attribute("dim_name__1", "ids");
+        return writer;
+    }
 
-            // For ids, the dimensions are trivial
-            dset->add_attribute("coords_mode__ids", "range");
-            dset->add_attribute("coords__ids",
-                                std::vector<std::size_t>{cm.cells().size()});
 
-            _log->debug("Added cell ID dimension labels and coordinates to "
-                        "dataset '{}'.", name);
+    /** @brief Create datasets storing data from a CellManager per replica
+     *
+     * For models advancing an ensemble of replicas in lockstep, e.g. using a
+     * Utopia::Field with several replicas, this creates a group of the given
+     * name with one dataset per replica, named by the replica index. Each of
+     * these is set up like a dataset created via create_cm_dset; the group
+     * carries the number of replicas as attribute `num_replicas`. The output
+     * settings, e.g. the `output_precision`, are looked up by the name of the
+     * group and apply to all replicas.
+     *
+     * @param name          The name of the group
+     * @param cm            The CellManager whose cells' states are stored
+     * @param num_replicas  The number of replicas
+     * @param compression_level  The compression level
+     * @param chunksize          The chunk size
+     *
+     * @return std::vector<std::shared_ptr<DataSet>> The datasets, indexed
+     *         by replica
+     */
+    template<class CellManager>
+    std::vector<std::shared_ptr<DataSet>>
+        create_cm_replica_dsets(const std::string name,
+                                const CellManager& cm,
+                                const std::size_t num_replicas,
+                                const std::size_t compression_level=1,
+                                const std::vector<hsize_t> chunksize={})
+    {
+        const auto grp = _hdfgrp->open_group(name);
+        grp->add_attribute("num_replicas", num_replicas);
+
+        std::vector<std::shared_ptr<DataSet>> dsets;
+        for (std::size_t replica = 0; replica < num_replicas; ++replica) {
+            const auto dset = create_dset(std::to_string(replica), grp,
+                                          {cm.cells().size()},
+                                          compression_level, chunksize,
+                                          name);
+            add_cm_dset_attributes(*dset, cm, name);
+            dsets.push_back(dset);
         }
 
-        return dset;
+        _log->debug("Created grid output '{}' for {} replicas.",
+                    name, num_replicas);
+
+        return dsets;
     }
-    
-    
+
+
     /** @brief Create a dataset storing data from a AgentManager
      *
      * The required capacity - the shape of the dataset - is calculated using
@@ -1033,6 +1592,9 @@ protected:
     /// The config node
     const Config _cfg;
 
+    /// Whether the HDF5 file supports single-writer/multiple-reader access
+    const bool _swmr;
+
     /// Pointer to the HDF5 file where data is written to
     const std::shared_ptr<HDFFile> _hdffile;
 
@@ -1051,6 +1613,28 @@ protected:
     /// The monitor instance of this root model
     Monitor _monitor;
 
+    /// The mutex serializing the output of all models
+    const std::shared_ptr<std::mutex> _output_mutex;
+
+    /// Create the monitor manager as configured in the given config node
+    /** The entries are emitted in the 'monitor_format' (default: yaml);
+     *  YAML lines start with a `!!map ` tag, while JSON lines come without
+     *  a prefix, see DataIO::monitor_emit_prefix.
+     */
+    static std::shared_ptr<MonitorManager>
+        setup_monitor_manager (const Config& cfg)
+    {
+        const auto format = DataIO::monitor_format_from_string(
+            get_as<std::string>("monitor_format", cfg, "yaml")
+        );
+        return std::make_shared<MonitorManager>(
+            get_as<double>("monitor_emit_interval", cfg),
+            DataIO::monitor_emit_prefix(format), "",
+            format,
+            get_as<bool>("monitor_async", cfg, false)
+        );
+    }
+
 public:
     /// Constructor that only requires path to a config file
     /** From the config file, all necessary information is extracted, i.e.:
@@ -1058,6 +1642,10 @@ public:
      *  RNG ('seed'). These keys have to be located at the top level of the
      *  configuration file.
      *
+     *  Optionally, the monitor can be configured to emit its entries as JSON
+     *  ('monitor_format', default: yaml) and on a separate thread
+     *  ('monitor_async', default: false).
+     *
      *  \param cfg_path The path to the YAML-formatted configuration file
      */
     PseudoParent (const std::string cfg_path)
@@ -1066,20 +1654,21 @@ public:
     _level(0),
     // Initialize the config node from the path to the config file
     _cfg(YAML::LoadFile(cfg_path)),
+    _swmr(get_as<bool>("swmr", _cfg, false)),
     // Create a file at the specified output path and store the shared pointer
     _hdffile(std::make_shared<HDFFile>(
         get_as<std::string>("output_path", _cfg),
-        get_as<std::string>("output_file_mode", _cfg, "w")
+        get_as<std::string>("output_file_mode", _cfg, "w"),
+        _swmr
     )),
     // Initialize the RNG from a seed
     _rng(std::make_shared<RNG>(get_as<int>("seed", _cfg))),
     // And initialize the root logger at warning level
     _log(Utopia::init_logger("root", spdlog::level::warn, false)),
     // Create a monitor manager and a root monitor
-    _monitor_mgr(std::make_shared<MonitorManager>(
-        get_as<double>("monitor_emit_interval", _cfg))
-    ),
-    _monitor(_monitor_mgr)
+    _monitor_mgr(setup_monitor_manager(_cfg)),
+    _monitor(_monitor_mgr),
+    _output_mutex(std::make_shared<std::mutex>())
     {
         setup_loggers(); // global loggers
         set_log_level(); // this log level
@@ -1102,26 +1691,31 @@ public:
      *  \param seed The seed the RNG is initialized with (default: 42)
      *  \param output_file_mode The access mode of the HDF5 file (default: w)
      *  \param emit_interval The monitor emit interval (in seconds)
+     *  \param swmr Whether the HDF5 file supports single-writer/multiple-
+     *              reader access, see Model::__start_swmr_write
      */
     PseudoParent (const std::string cfg_path,
                   const std::string output_path,
                   const int seed=42,
                   const std::string output_file_mode="w",
-                  const double emit_interval=5.)
+                  const double emit_interval=5.,
+                  const bool swmr=false)
     :
     // The hierarchical level is 0
     _level(0),
     // Initialize the config node from the path to the config file
     _cfg(YAML::LoadFile(cfg_path)),
+    _swmr(swmr),
     // Create a file at the specified output path
-    _hdffile(std::make_shared<HDFFile>(output_path, output_file_mode)),
+    _hdffile(std::make_shared<HDFFile>(output_path, output_file_mode, swmr)),
     // Initialize the RNG from a seed
     _rng(std::make_shared<RNG>(seed)),
     // And initialize the root logger at warning level
     _log(Utopia::init_logger("root", spdlog::level::warn, false)),
     // Create a monitor manager and a "root" monitor
     _monitor_mgr(std::make_shared<MonitorManager>(emit_interval)),
-    _monitor(_monitor_mgr)
+    _monitor(_monitor_mgr),
+    _output_mutex(std::make_shared<std::mutex>())
     {
         setup_loggers(); // global loggers
         set_log_level(); // this log level
@@ -1174,6 +1768,32 @@ public:
         return get_as<Time>("write_every", _cfg, 1);
     }
 
+    /// Return the number of time slices datasets buffer before writing
+    std::size_t get_write_buffer_size() const {
+        return get_as<std::size_t>("write_buffer_size", _cfg, 1);
+    }
+
+    /// Return whether datasets compress and write their chunks directly
+    bool get_direct_chunk_write() const {
+        return get_as<bool>("direct_chunk_write", _cfg, false);
+    }
+
+    /// Return whether the output file supports SWMR access
+    bool get_swmr() const {
+        return _swmr;
+    }
+
+    /// Return whether submodels are iterated concurrently: never, as there
+    /// is only a single model at the top level
+    bool get_parallel_submodels() const {
+        return false;
+    }
+
+    /// Return the mutex serializing the output of all models
+    std::shared_ptr<std::mutex> get_output_mutex() const {
+        return _output_mutex;
+    }
+
     /// Return a pointer to the RNG
     std::shared_ptr<RNG> get_rng() const {
         return _rng;
@@ -0,0 +1,239 @@
+#ifndef UTOPIA_CORE_OBSERVABLES_HH
+#define UTOPIA_CORE_OBSERVABLES_HH
+
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "parallel.hh"
+
+
+namespace Utopia {
+/**
+ * \addtogroup Model
+ * \{
+ */
+
+/// The type-independent interface of an observable
+class ObservableBase {
+public:
+    virtual ~ObservableBase () = default;
+
+    /// Discard the cached value; the next access re-computes it
+    virtual void invalidate () = 0;
+
+    /// Whether a value is currently cached
+    virtual bool is_cached () const = 0;
+};
+
+
+/// A named quantity that is computed lazily and cached until invalidated
+/** The value is computed on first access and then returned from the cache
+ *  until invalidate() is called. Within a model, this happens whenever the
+ *  time is incremented, such that the value is computed at most once per time
+ *  step, no matter how often it is requested from monitor(), write_data(),
+ *  or the rules.
+ *
+ *  \tparam T  The type of the computed value
+ */
+template<typename T>
+class Observable : public ObservableBase {
+public:
+    /// The type of the computed value
+    using Value = T;
+
+private:
+    /// The function computing the value
+    const std::function<T()> _compute;
+
+    /// The cached value, if any
+    std::optional<T> _value;
+
+    /// How often the value was computed so far
+    std::size_t _num_evaluations;
+
+public:
+    /// Construct an observable from the function computing its value
+    explicit Observable (std::function<T()> compute)
+    :
+        _compute(std::move(compute)),
+        _value(),
+        _num_evaluations(0)
+    {}
+
+    /// Return the value, computing it if it is not cached
+    const T& get () {
+        if (not _value) {
+            _value = _compute();
+            ++_num_evaluations;
+        }
+        return *_value;
+    }
+
+    /// Return the value, computing it if it is not cached
+    const T& operator() () {
+        return get();
+    }
+
+    void invalidate () override {
+        _value.reset();
+    }
+
+    bool is_cached () const override {
+        return _value.has_value();
+    }
+
+    /// How often the value was computed so far
+    std::size_t get_num_evaluations () const {
+        return _num_evaluations;
+    }
+};
+
+
+/// A registry of named observables sharing their invalidation
+/** Models declare the aggregate quantities they need in several places,
+ *  typically reductions over the entities of a manager, once via add().
+ *  Accessing them via get() then evaluates each at most once between two
+ *  calls to invalidate(), which the Model base class performs upon each
+ *  increment of time.
+ *
+ *  \note  A value computed during a step, e.g. by an update rule, reflects
+ *         the state at the time of the first access within that step.
+ *         Call invalidate() manually if it is needed after further changes.
+ */
+class ObservableRegistry {
+private:
+    /// The registered observables
+    std::unordered_map<std::string, std::shared_ptr<ObservableBase>>
+        _observables;
+
+public:
+    /// Register an observable
+    /** \param name     The name of the observable, needs to be unique
+      * \param compute  The function computing the value; its return type
+      *                 determines the type of the observable.
+      *
+      * \return A shared pointer to the observable, allowing access without
+      *         the name lookup
+      */
+    template<class Func>
+    auto add (const std::string& name, Func&& compute) {
+        using T = std::decay_t<std::invoke_result_t<Func>>;
+
+        if (contains(name)) {
+            throw std::invalid_argument("An observable named '" + name
+                                        + "' was already registered!");
+        }
+
+        auto obs = std::make_shared<Observable<T>>(
+            std::function<T()>(std::forward<Func>(compute))
+        );
+        _observables.emplace(name, obs);
+        return obs;
+    }
+
+    /// Return the observable registered under the given name
+    /** \tparam T  The value type of the observable
+      *
+      * \throw std::invalid_argument  If there is no such observable or if it
+      *                               is of a different type
+      */
+    template<typename T>
+    std::shared_ptr<Observable<T>> get_observable (const std::string& name)
+        const
+    {
+        const auto it = _observables.find(name);
+        if (it == _observables.end()) {
+            throw std::invalid_argument("No observable named '" + name
+                                        + "' was registered!");
+        }
+
+        auto obs = std::dynamic_pointer_cast<Observable<T>>(it->second);
+        if (not obs) {
+            throw std::invalid_argument("The observable '" + name + "' is "
+                                        "not of the requested type!");
+        }
+        return obs;
+    }
+
+    /// Return the (possibly cached) value of an observable
+    /** \tparam T  The value type of the observable
+      */
+    template<typename T>
+    const T& get (const std::string& name) const {
+        return get_observable<T>(name)->get();
+    }
+
+    /// Whether an observable of the given name is registered
+    bool contains (const std::string& name) const {
+        return _observables.find(name) != _observables.end();
+    }
+
+    /// The number of registered observables
+    std::size_t size () const {
+        return _observables.size();
+    }
+
+    /// Discard the cached values of all observables
+    void invalidate () {
+        for (auto& [name, obs] : _observables) {
+            obs->invalidate();
+        }
+    }
+};
+
+
+/// Create a function that reduces over a container of entities
+/** The returned function computes `std::transform_reduce` over the entities
+ *  with the given execution policy, e.g. to count the cells of a certain
+ *  state or to sum up a quantity of all agents. It can be registered as an
+ *  observable via ObservableRegistry::add.
+ *
+ *  \param policy     The execution policy of the reduction; as for all
+ *                    runtime-policy algorithms, it only applies if parallel
+ *                    execution is enabled.
+ *  \param entities   The entities to reduce over, e.g. `_cm.cells()`. The
+ *                    container is captured by reference and needs to outlive
+ *                    the returned function.
+ *  \param init       The initial value of the reduction
+ *  \param reduce     The associative and commutative reduction operation
+ *  \param transform  Maps an entity (pointer) to the value to be reduced
+ */
+template<class Container, typename T, class Reduce, class Transform>
+auto make_reduction (const ExecPolicy policy,
+                     const Container& entities,
+                     T init,
+                     Reduce reduce,
+                     Transform transform)
+{
+    return [policy, &entities, init, reduce, transform] () -> T {
+        return std::transform_reduce(policy,
+                                     entities.begin(), entities.end(),
+                                     init, reduce, transform);
+    };
+}
+
+/// Create a function that reduces over a container of entities, sequentially
+/** \overload
+ */
+template<class Container, typename T, class Reduce, class Transform>
+auto make_reduction (const Container& entities,
+                     T init,
+                     Reduce reduce,
+                     Transform transform)
+{
+    return make_reduction(ExecPolicy::seq, entities, init, reduce, transform);
+}
+
+/**
+ *  \} // endgroup Model
+ */
+
+} // namespace Utopia
+
+#endif // UTOPIA_CORE_OBSERVABLES_HH
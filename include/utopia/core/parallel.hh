@@ -27,13 +27,34 @@ namespace std::execution {
 }
 #endif
 
+// The PSTL backend uses TBB, such that its thread pool can be controlled
+// through a task arena
+#if __has_include(<tbb/task_arena.h>)
+#define UTOPIA_TASK_ARENA
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_observer.h>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#endif
+
 #else
 #define MAYBE_UNUSED [[maybe_unused]]  // Avoid warning for unused parameter
 #endif
 
 #include <algorithm>
 #include <exception>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include <utopia/core/logging.hh>
 #include <utopia/data_io/cfg_utils.hh>
@@ -77,9 +98,111 @@ enum ExecPolicy
 class ParallelExecution
 {
 private:
+#ifdef UTOPIA_TASK_ARENA
+    /// Pins the threads entering a task arena to the available CPUs
+    /** The CPUs are those the process is allowed to run on when the pinning
+     *  is set up, such that restrictions imposed from outside, e.g. when
+     *  several simulations share a node, are respected. Threads are
+     *  assigned to these CPUs in a round-robin fashion by their slot index
+     *  within the arena. When leaving the arena, a thread may again run on
+     *  all of these CPUs; this applies in particular to the calling thread.
+     *
+     *  \note Pinning is only implemented for Linux.
+     */
+    class ThreadPinner : public tbb::task_scheduler_observer
+    {
+    private:
+        /// The CPUs to pin the threads to
+        std::vector<int> _cpus;
+
+#if defined(__linux__)
+        /// The set of CPUs the process may run on
+        cpu_set_t _allowed;
+#endif
+
+    public:
+        explicit ThreadPinner(tbb::task_arena& arena)
+            : tbb::task_scheduler_observer(arena), _cpus()
+        {
+#if defined(__linux__)
+            CPU_ZERO(&_allowed);
+            if (sched_getaffinity(0, sizeof(_allowed), &_allowed) == 0)
+            {
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                {
+                    if (CPU_ISSET(cpu, &_allowed))
+                        _cpus.push_back(cpu);
+                }
+            }
+#endif
+            observe(true);
+        }
+
+        ~ThreadPinner() { observe(false); }
+
+        void on_scheduler_entry(bool) override
+        {
+#if defined(__linux__)
+            const auto slot = tbb::this_task_arena::current_thread_index();
+            if (_cpus.empty() or slot < 0)
+                return;
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(_cpus[slot % _cpus.size()], &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+        }
+
+        void on_scheduler_exit(bool) override
+        {
+#if defined(__linux__)
+            if (not _cpus.empty())
+                pthread_setaffinity_np(
+                    pthread_self(), sizeof(_allowed), &_allowed);
+#endif
+        }
+    };
+
+    /// A task arena with the (optional) thread pinning applied to it
+    /** The members are destroyed in reverse order, i.e., the observer is
+     *  detached before the arena is destroyed.
+     */
+    struct TaskArena
+    {
+        tbb::task_arena arena;
+        std::optional<ThreadPinner> pinner;
+
+        TaskArena(const unsigned int num_threads, const bool pin_threads)
+            : arena(num_threads > 0 ? static_cast<int>(num_threads)
+                                    : tbb::task_arena::automatic),
+              pinner()
+        {
+            arena.initialize();
+            if (pin_threads)
+                pinner.emplace(arena);
+        }
+    };
+
+    /// The arena all parallel algorithms are executed in
+    /** This is only set if the number of threads or the pinning of threads
+     *  were configured; otherwise, the global arena of the backend is used.
+     */
+    inline static std::unique_ptr<TaskArena> _arena;
+#endif
+
     /// Runtime setting for parallel execution
     inline static bool _enabled = false;
 
+    /// The number of threads to use; 0 leaves the choice to the backend
+    inline static unsigned int _num_threads = 0;
+
+    /// Whether to pin the threads to CPUs
+    inline static bool _pin_threads = false;
+
+    /// The minimum number of elements for which algorithms run in parallel
+    inline static std::size_t _grain_size = 0;
+
     /// Fetch the core logger
     /**
      *  \return Valid shared pointer to the logger
@@ -106,6 +229,16 @@ public:
 
     /// Initialize parallel features based on configuration setting
     /**
+     *  Besides the required `enabled` key, the `parallel_execution` node may
+     *  contain the following optional keys:
+     *    - `num_threads`: The number of threads to use. If 0 (default), this
+     *      is chosen by the backend, typically one per available core.
+     *    - `pin_threads`: Whether to pin each thread to one of the CPUs the
+     *      process may run on (default: false)
+     *    - `grain_size`: The minimum number of elements for which algorithms
+     *      run multithreaded (default: 0); algorithms on fewer elements run
+     *      on the calling thread.
+     *
      *  \param cfg Parameter space config node
      *  \note If the required parameter is not found, parallel features are
      *        **disabled** by default.
@@ -113,19 +246,73 @@ public:
     static void init(const DataIO::Config& cfg)
     {
         bool setting = false;
+        unsigned int num_threads = 0;
+        bool pin_threads = false;
+        std::size_t grain_size = 0;
 
         // Try fetching settings on parallel execution
         if (const YAML::Node& cfg_par = cfg["parallel_execution"])
         {
             setting = get_as<bool>("enabled", cfg_par);
+            num_threads = get_as<unsigned int>("num_threads", cfg_par, 0);
+            pin_threads = get_as<bool>("pin_threads", cfg_par, false);
+            grain_size = get_as<std::size_t>("grain_size", cfg_par, 0);
         }
 
+        set_threads(num_threads, pin_threads);
+        set_grain_size(grain_size);
+
         if (setting)
             set(Setting::enabled);
         else
             set(Setting::disabled);
     }
 
+    /// Set the number of threads and whether to pin them to CPUs
+    /**
+     *  This (re-)creates the task arena that parallel algorithms run in. It
+     *  must not be called while parallel algorithms are running.
+     *
+     *  \param num_threads The number of threads; if 0, the backend decides
+     *  \param pin_threads Whether to pin each thread to a CPU
+     */
+    static void set_threads(const unsigned int num_threads,
+                            const bool pin_threads = false)
+    {
+        _num_threads = num_threads;
+        _pin_threads = pin_threads;
+
+        const auto log = get_logger();
+#ifdef UTOPIA_TASK_ARENA
+        _arena.reset();
+        if (num_threads > 0 or pin_threads)
+        {
+            _arena = std::make_unique<TaskArena>(num_threads, pin_threads);
+            log->info("Parallel execution uses {} thread(s){}",
+                      _arena->arena.max_concurrency(),
+                      pin_threads ? ", pinned to CPUs" : "");
+        }
+#else
+        if (num_threads > 0 or pin_threads)
+        {
+            log->warn("Thread settings for parallel execution do NOT apply");
+        }
+#endif
+    }
+
+    /// Set the minimum number of elements for multithreaded execution
+    /**
+     *  Algorithms called with a multithreaded policy on ranges with fewer
+     *  elements run on the calling thread instead, with ExecPolicy::par_unseq
+     *  being reduced to ExecPolicy::unseq. This avoids the overhead of
+     *  distributing little work. A value of 0 disables this check. Only
+     *  applies to algorithms on random access ranges.
+     */
+    static void set_grain_size(const std::size_t grain_size)
+    {
+        _grain_size = grain_size;
+    }
+
     /// Choose a setting for parallel execution at runtime
     /**
      *  This setting may be changed at any time during runtime. However,
@@ -159,6 +346,99 @@ public:
      */
     static bool is_enabled() { return _enabled; }
 
+    /// The configured number of threads; 0 if chosen by the backend
+    static unsigned int get_num_threads() { return _num_threads; }
+
+    /// Whether threads are pinned to CPUs
+    static bool get_pin_threads() { return _pin_threads; }
+
+    /// The minimum number of elements for multithreaded execution
+    static std::size_t get_grain_size() { return _grain_size; }
+
+    /// Whether a range of the given size is large enough for multithreading
+    static bool exceeds_grain_size(const std::size_t size)
+    {
+        return size >= _grain_size;
+    }
+
+    /// Execute a function inside the configured task arena
+    /**
+     *  Parallel algorithms called from within the function use the threads
+     *  of the arena. If no arena was configured, the function is called
+     *  directly, using the global thread pool of the backend.
+     *
+     *  \return The return value of the function
+     */
+    template<class Func>
+    static decltype(auto) execute(Func&& f)
+    {
+#ifdef UTOPIA_TASK_ARENA
+        if (_arena)
+        {
+            return _arena->arena.execute(std::forward<Func>(f));
+        }
+#endif
+        return f();
+    }
+
+    /// Whether run_tasks uses the thread pool of the backend
+    /** This requires the backend to provide task arenas and parallel
+     *  execution to be enabled.
+     */
+    static bool has_task_pool()
+    {
+#ifdef UTOPIA_TASK_ARENA
+        return _enabled;
+#else
+        return false;
+#endif
+    }
+
+    /// Run the given functions as concurrent tasks in the task arena
+    /**
+     *  The tasks are run by the threads of the configured task arena, see
+     *  execute, and the calling thread takes part in running them. Returns
+     *  once all tasks finished. Without a thread pool (see has_task_pool),
+     *  the functions are called one after the other.
+     *
+     *  \warning The functions may not throw.
+     */
+    template<class... Funcs>
+    static void run_tasks(Funcs&&... funcs)
+    {
+#ifdef UTOPIA_TASK_ARENA
+        if (_enabled)
+        {
+            execute([&funcs...]() {
+                tbb::task_group tasks;
+                (tasks.run(funcs), ...);
+                tasks.wait();
+            });
+            return;
+        }
+#endif
+        (funcs(), ...);
+    }
+
+    /// Execute a function without taking on tasks created outside of it
+    /**
+     *  A thread waiting for a parallel algorithm may run other tasks of the
+     *  arena in the meantime, e.g. those started via run_tasks. Isolation
+     *  prevents this, which is needed if the function holds a lock that
+     *  these tasks might try to acquire as well.
+     *
+     *  \return The return value of the function
+     */
+    template<class Func>
+    static decltype(auto) isolate(Func&& f)
+    {
+#ifdef UTOPIA_TASK_ARENA
+        return tbb::this_task_arena::isolate(std::forward<Func>(f));
+#else
+        return f();
+#endif
+    }
+
     /// Actually check if parallel features are applied at runtime
     /**
      *  \note This method is implemented for testing purposes only and should
@@ -174,6 +454,49 @@ public:
     }
 };
 
+namespace impl
+{
+
+/// Whether a type is a random access iterator
+template<class It, class = void>
+struct is_random_access_iterator : std::false_type
+{};
+
+template<class It>
+struct is_random_access_iterator<
+    It,
+    std::void_t<typename std::iterator_traits<It>::iterator_category>>
+    : std::is_base_of<std::random_access_iterator_tag,
+                      typename std::iterator_traits<It>::iterator_category>
+{};
+
+/// The size of the range given by the first two algorithm arguments
+/**
+ *  \return The distance between the iterators, or the maximum value if the
+ *          arguments are no random access iterators of the same type.
+ */
+template<class... Args>
+std::size_t
+range_size(const Args&... args)
+{
+    if constexpr (sizeof...(Args) >= 2)
+    {
+        const auto& first = std::get<0>(std::tie(args...));
+        const auto& last = std::get<1>(std::tie(args...));
+        using It1 = std::decay_t<decltype(first)>;
+        using It2 = std::decay_t<decltype(last)>;
+
+        if constexpr (std::is_same_v<It1, It2> and
+                      is_random_access_iterator<It1>::value)
+        {
+            return static_cast<std::size_t>(std::distance(first, last));
+        }
+    }
+    return std::numeric_limits<std::size_t>::max();
+}
+
+} // namespace impl
+
 /// Call a function with an STL execution policy and arguments
 /**
  *  This function takes a set of STL algorithm arguments `args`, wraps them into
@@ -189,6 +512,11 @@ public:
  *  policy. This works because by definition of the STL they all have the same
  *  return type.
  *
+ *  Multithreaded algorithms are run inside the task arena configured via
+ *  ParallelExecution, such that they use the configured number of threads.
+ *  If the range they operate on is smaller than the configured grain size,
+ *  they run on the calling thread instead.
+ *
  *  See
  *  https://stackoverflow.com/questions/52975114/different-execution-policies-at-runtime
  *  for the inspiration to this implementation.
@@ -209,12 +537,22 @@ exec_parallel(MAYBE_UNUSED const Utopia::ExecPolicy policy,
 #ifdef UTOPIA_PARALLEL
     if (Utopia::ParallelExecution::is_enabled())
     {
-        if (policy == Utopia::ExecPolicy::unseq)
+        using Utopia::ParallelExecution;
+        const bool multithreaded = ParallelExecution::exceeds_grain_size(
+            impl::range_size(args...));
+
+        if (policy == Utopia::ExecPolicy::unseq
+            or (policy == Utopia::ExecPolicy::par_unseq and not multithreaded))
             return f(std::forward_as_tuple(std::execution::unseq, args...));
-        else if (policy == Utopia::ExecPolicy::par)
-            return f(std::forward_as_tuple(std::execution::par, args...));
+        else if (policy == Utopia::ExecPolicy::par and multithreaded)
+            return ParallelExecution::execute([&]() {
+                return f(std::forward_as_tuple(std::execution::par, args...));
+            });
         else if (policy == Utopia::ExecPolicy::par_unseq)
-            return f(std::forward_as_tuple(std::execution::par_unseq, args...));
+            return ParallelExecution::execute([&]() {
+                return f(
+                    std::forward_as_tuple(std::execution::par_unseq, args...));
+            });
     }
 #endif
 
@@ -413,6 +751,504 @@ transform(const Utopia::ExecPolicy policy,
         binary_op);
 }
 
+/// Sum up a range, starting from a value-initialized element
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/reduce
+ */
+template<class ForwardIt>
+typename std::iterator_traits<ForwardIt>::value_type
+reduce(const Utopia::ExecPolicy policy,
+       ForwardIt first,
+       ForwardIt last)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto reduce = [](auto&&... args) {
+                return std::reduce(args...);
+            };
+            return std::apply(reduce, args_tpl);
+        },
+        first,
+        last);
+}
+
+/// Sum up a range, starting from an initial value
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/reduce
+ */
+template<class ForwardIt, class T>
+T
+reduce(const Utopia::ExecPolicy policy,
+       ForwardIt first,
+       ForwardIt last,
+       T init)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto reduce = [](auto&&... args) {
+                return std::reduce(args...);
+            };
+            return std::apply(reduce, args_tpl);
+        },
+        first,
+        last,
+        init);
+}
+
+/// Reduce a range with a binary operation, starting from an initial value
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/reduce
+ */
+template<class ForwardIt, class T, class BinaryOp>
+T
+reduce(const Utopia::ExecPolicy policy,
+       ForwardIt first,
+       ForwardIt last,
+       T init,
+       BinaryOp binary_op)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto reduce = [](auto&&... args) {
+                return std::reduce(args...);
+            };
+            return std::apply(reduce, args_tpl);
+        },
+        first,
+        last,
+        init,
+        binary_op);
+}
+
+/// Compute the inner product of two ranges
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/transform_reduce
+ */
+template<class ForwardIt1, class ForwardIt2, class T>
+T
+transform_reduce(const Utopia::ExecPolicy policy,
+                 ForwardIt1 first1,
+                 ForwardIt1 last1,
+                 ForwardIt2 first2,
+                 T init)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto transform_reduce = [](auto&&... args) {
+                return std::transform_reduce(args...);
+            };
+            return std::apply(transform_reduce, args_tpl);
+        },
+        first1,
+        last1,
+        first2,
+        init);
+}
+
+/// Transform pairs of elements of two ranges and reduce the results
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/transform_reduce
+ */
+template<class ForwardIt1,
+         class ForwardIt2,
+         class T,
+         class BinaryReductionOp,
+         class BinaryTransformOp>
+T
+transform_reduce(const Utopia::ExecPolicy policy,
+                 ForwardIt1 first1,
+                 ForwardIt1 last1,
+                 ForwardIt2 first2,
+                 T init,
+                 BinaryReductionOp reduce,
+                 BinaryTransformOp transform)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto transform_reduce = [](auto&&... args) {
+                return std::transform_reduce(args...);
+            };
+            return std::apply(transform_reduce, args_tpl);
+        },
+        first1,
+        last1,
+        first2,
+        init,
+        reduce,
+        transform);
+}
+
+/// Transform the elements of a range and reduce the results
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/transform_reduce
+ */
+template<class ForwardIt,
+         class T,
+         class BinaryReductionOp,
+         class UnaryTransformOp>
+T
+transform_reduce(const Utopia::ExecPolicy policy,
+                 ForwardIt first,
+                 ForwardIt last,
+                 T init,
+                 BinaryReductionOp reduce,
+                 UnaryTransformOp transform)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto transform_reduce = [](auto&&... args) {
+                return std::transform_reduce(args...);
+            };
+            return std::apply(transform_reduce, args_tpl);
+        },
+        first,
+        last,
+        init,
+        reduce,
+        transform);
+}
+
+/// Count the elements of a range satisfying a predicate
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/count
+ */
+template<class ForwardIt, class UnaryPredicate>
+typename std::iterator_traits<ForwardIt>::difference_type
+count_if(const Utopia::ExecPolicy policy,
+         ForwardIt first,
+         ForwardIt last,
+         UnaryPredicate p)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto count_if = [](auto&&... args) {
+                return std::count_if(args...);
+            };
+            return std::apply(count_if, args_tpl);
+        },
+        first,
+        last,
+        p);
+}
+
+/// Copy the elements of a range satisfying a predicate to a new range
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/copy
+ */
+template<class ForwardIt1, class ForwardIt2, class UnaryPredicate>
+ForwardIt2
+copy_if(const Utopia::ExecPolicy policy,
+        ForwardIt1 first,
+        ForwardIt1 last,
+        ForwardIt2 d_first,
+        UnaryPredicate pred)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto copy_if = [](auto&&... args) {
+                return std::copy_if(args...);
+            };
+            return std::apply(copy_if, args_tpl);
+        },
+        first,
+        last,
+        d_first,
+        pred);
+}
+
+/// Sort a range in ascending order
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/sort
+ */
+template<class RandomIt>
+void
+sort(const Utopia::ExecPolicy policy,
+     RandomIt first,
+     RandomIt last)
+{
+    Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto sort = [](auto&&... args){ std::sort(args...); };
+            std::apply(sort, args_tpl);
+        },
+        first,
+        last);
+}
+
+/// Sort a range according to a comparison function
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/sort
+ */
+template<class RandomIt, class Compare>
+void
+sort(const Utopia::ExecPolicy policy,
+     RandomIt first,
+     RandomIt last,
+     Compare comp)
+{
+    Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto sort = [](auto&&... args){ std::sort(args...); };
+            std::apply(sort, args_tpl);
+        },
+        first,
+        last,
+        comp);
+}
+
+/// Compute the inclusive prefix sum of a range
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/inclusive_scan
+ */
+template<class ForwardIt1, class ForwardIt2>
+ForwardIt2
+inclusive_scan(const Utopia::ExecPolicy policy,
+               ForwardIt1 first,
+               ForwardIt1 last,
+               ForwardIt2 d_first)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto inclusive_scan = [](auto&&... args) {
+                return std::inclusive_scan(args...);
+            };
+            return std::apply(inclusive_scan, args_tpl);
+        },
+        first,
+        last,
+        d_first);
+}
+
+/// Compute the inclusive prefix reduction of a range
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/inclusive_scan
+ */
+template<class ForwardIt1, class ForwardIt2, class BinaryOp>
+ForwardIt2
+inclusive_scan(const Utopia::ExecPolicy policy,
+               ForwardIt1 first,
+               ForwardIt1 last,
+               ForwardIt2 d_first,
+               BinaryOp binary_op)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto inclusive_scan = [](auto&&... args) {
+                return std::inclusive_scan(args...);
+            };
+            return std::apply(inclusive_scan, args_tpl);
+        },
+        first,
+        last,
+        d_first,
+        binary_op);
+}
+
+/// Compute the exclusive prefix sum of a range
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/exclusive_scan
+ */
+template<class ForwardIt1, class ForwardIt2, class T>
+ForwardIt2
+exclusive_scan(const Utopia::ExecPolicy policy,
+               ForwardIt1 first,
+               ForwardIt1 last,
+               ForwardIt2 d_first,
+               T init)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto exclusive_scan = [](auto&&... args) {
+                return std::exclusive_scan(args...);
+            };
+            return std::apply(exclusive_scan, args_tpl);
+        },
+        first,
+        last,
+        d_first,
+        init);
+}
+
+/// Compute the exclusive prefix reduction of a range
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/exclusive_scan
+ */
+template<class ForwardIt1,
+         class ForwardIt2,
+         class T,
+         class BinaryOp>
+ForwardIt2
+exclusive_scan(const Utopia::ExecPolicy policy,
+               ForwardIt1 first,
+               ForwardIt1 last,
+               ForwardIt2 d_first,
+               T init,
+               BinaryOp binary_op)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto exclusive_scan = [](auto&&... args) {
+                return std::exclusive_scan(args...);
+            };
+            return std::apply(exclusive_scan, args_tpl);
+        },
+        first,
+        last,
+        d_first,
+        init,
+        binary_op);
+}
+
+/// Find the smallest element of a range
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/min_element
+ */
+template<class ForwardIt>
+ForwardIt
+min_element(const Utopia::ExecPolicy policy,
+            ForwardIt first,
+            ForwardIt last)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto min_element = [](auto&&... args) {
+                return std::min_element(args...);
+            };
+            return std::apply(min_element, args_tpl);
+        },
+        first,
+        last);
+}
+
+/// Find the smallest element of a range according to a comparison
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/min_element
+ */
+template<class ForwardIt, class Compare>
+ForwardIt
+min_element(const Utopia::ExecPolicy policy,
+            ForwardIt first,
+            ForwardIt last,
+            Compare comp)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto min_element = [](auto&&... args) {
+                return std::min_element(args...);
+            };
+            return std::apply(min_element, args_tpl);
+        },
+        first,
+        last,
+        comp);
+}
+
+/// Find the largest element of a range
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/max_element
+ */
+template<class ForwardIt>
+ForwardIt
+max_element(const Utopia::ExecPolicy policy,
+            ForwardIt first,
+            ForwardIt last)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto max_element = [](auto&&... args) {
+                return std::max_element(args...);
+            };
+            return std::apply(max_element, args_tpl);
+        },
+        first,
+        last);
+}
+
+/// Find the largest element of a range according to a comparison
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/max_element
+ */
+template<class ForwardIt, class Compare>
+ForwardIt
+max_element(const Utopia::ExecPolicy policy,
+            ForwardIt first,
+            ForwardIt last,
+            Compare comp)
+{
+    return Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto max_element = [](auto&&... args) {
+                return std::max_element(args...);
+            };
+            return std::apply(max_element, args_tpl);
+        },
+        first,
+        last,
+        comp);
+}
+
+/// Assign a value to all elements of a range
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/fill
+ */
+template<class ForwardIt, class T>
+void
+fill(const Utopia::ExecPolicy policy,
+     ForwardIt first,
+     ForwardIt last,
+     const T& value)
+{
+    Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto fill = [](auto&&... args){ std::fill(args...); };
+            std::apply(fill, args_tpl);
+        },
+        first,
+        last,
+        value);
+}
+
+/// Assign the results of successive calls of a function to a range
+/**
+ *  See https://en.cppreference.com/w/cpp/algorithm/generate
+ */
+template<class ForwardIt, class Generator>
+void
+generate(const Utopia::ExecPolicy policy,
+         ForwardIt first,
+         ForwardIt last,
+         Generator g)
+{
+    Utopia::exec_parallel(
+        policy,
+        [](auto&& args_tpl) {
+            auto generate = [](auto&&... args){ std::generate(args...); };
+            std::apply(generate, args_tpl);
+        },
+        first,
+        last,
+        g);
+}
+
 /**
  *  \}
  */
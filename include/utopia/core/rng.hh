@@ -0,0 +1,514 @@
+#ifndef UTOPIA_CORE_RNG_HH
+#define UTOPIA_CORE_RNG_HH
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "types.hh"
+
+
+namespace Utopia {
+/**
+ *  \addtogroup Rules
+ *  \{
+ */
+
+/// The xoshiro256++ pseudo random number generator
+/** A fast, small-state (256 bit) generator with excellent statistical
+ *  quality, see Blackman & Vigna (2021), *Scrambled Linear Pseudorandom
+ *  Number Generators*. It fulfills the requirements of a
+ *  RandomNumberEngine and can thus be used as a drop-in replacement for
+ *  Utopia::DefaultRNG, e.g. via the `RNGType` parameter of
+ *  Utopia::ModelTypes and the template parameter of Utopia::PseudoParent.
+ *
+ *  Seeding from a single integer expands it to the full state via the
+ *  SplitMix64 generator, as recommended by the authors.
+ */
+class Xoshiro256PlusPlus {
+public:
+    /// The type of the generated random numbers
+    using result_type = std::uint64_t;
+
+    /// The seed used by the default constructor
+    static constexpr result_type default_seed = 5489u;
+
+private:
+    /// The generator state
+    std::array<std::uint64_t, 4> _s;
+
+public:
+    /// Construct the generator using the default seed
+    Xoshiro256PlusPlus () {
+        seed(default_seed);
+    }
+
+    /// Construct the generator from a single seed value
+    explicit Xoshiro256PlusPlus (const result_type value) {
+        seed(value);
+    }
+
+    /// Construct the generator from a seed sequence, e.g. std::seed_seq
+    template<class SeedSeq,
+             class=std::enable_if_t<not std::is_arithmetic_v<SeedSeq>>>
+    explicit Xoshiro256PlusPlus (SeedSeq& seq) {
+        seed(seq);
+    }
+
+    /// Re-seed the generator from a single seed value
+    void seed (const result_type value) {
+        std::uint64_t x = value;
+        for (auto& s : _s) {
+            s = splitmix64(x);
+        }
+    }
+
+    /// Re-seed the generator from a seed sequence
+    template<class SeedSeq>
+    void seed (SeedSeq& seq) {
+        std::array<std::uint32_t, 8> words;
+        seq.generate(words.begin(), words.end());
+        for (std::size_t i = 0; i < 4; i++) {
+            _s[i] = (std::uint64_t(words[2*i]) << 32) | words[2*i + 1];
+        }
+
+        // The all-zero state is the only invalid one
+        if (not (_s[0] or _s[1] or _s[2] or _s[3])) {
+            seed(default_seed);
+        }
+    }
+
+    /// The smallest value the generator may return
+    static constexpr result_type min () {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    /// The largest value the generator may return
+    static constexpr result_type max () {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /// Generate the next random number
+    result_type operator() () {
+        const std::uint64_t result = rotl(_s[0] + _s[3], 23) + _s[0];
+        const std::uint64_t t = _s[1] << 17;
+
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl(_s[3], 45);
+
+        return result;
+    }
+
+    /// Advance the generator by the given number of steps
+    void discard (unsigned long long n) {
+        for (; n > 0; n--) {
+            (*this)();
+        }
+    }
+
+    /// Whether two generators have the same state
+    friend bool operator== (const Xoshiro256PlusPlus& a,
+                            const Xoshiro256PlusPlus& b)
+    {
+        return a._s == b._s;
+    }
+
+    /// Whether two generators have different states
+    friend bool operator!= (const Xoshiro256PlusPlus& a,
+                            const Xoshiro256PlusPlus& b)
+    {
+        return not (a == b);
+    }
+
+private:
+    /// Rotate the bits of x to the left by k
+    static std::uint64_t rotl (const std::uint64_t x, const int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    /// The SplitMix64 generator, used for expanding a single seed value
+    static std::uint64_t splitmix64 (std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+};
+
+
+/// The PCG64 pseudo random number generator
+/** A permuted congruential generator with 128 bit state and 64 bit output
+ *  (PCG XSL RR 128/64), see O'Neill (2014), *PCG: A Family of Simple Fast
+ *  Space-Efficient Statistically Good Algorithms for Random Number
+ *  Generation*. Like Utopia::Xoshiro256PlusPlus, it fulfills the
+ *  requirements of a RandomNumberEngine.
+ *
+ *  \note  This relies on the `unsigned __int128` extension of GCC and Clang.
+ */
+class PCG64 {
+public:
+    /// The type of the generated random numbers
+    using result_type = std::uint64_t;
+
+    /// The seed used by the default constructor
+    static constexpr result_type default_seed = 5489u;
+
+private:
+    /// The type of the internal state
+    using State = unsigned __int128;
+
+    /// The state of the underlying linear congruential generator
+    State _state;
+
+    /// The increment of the linear congruential generator; always odd
+    State _inc;
+
+public:
+    /// Construct the generator using the default seed
+    PCG64 () {
+        seed(default_seed);
+    }
+
+    /// Construct the generator from a single seed value
+    explicit PCG64 (const result_type value) {
+        seed(value);
+    }
+
+    /// Construct the generator from a seed sequence, e.g. std::seed_seq
+    template<class SeedSeq,
+             class=std::enable_if_t<not std::is_arithmetic_v<SeedSeq>>>
+    explicit PCG64 (SeedSeq& seq) {
+        seed(seq);
+    }
+
+    /// Re-seed the generator from a single seed value, using the default
+    /// stream
+    void seed (const result_type value) {
+        set_state(value, (State(0x5851f42d4c957f2dULL) << 64)
+                         | 0x14057b7ef767814fULL);
+    }
+
+    /// Re-seed the generator from a seed sequence, which also selects the
+    /// stream
+    template<class SeedSeq>
+    void seed (SeedSeq& seq) {
+        std::array<std::uint32_t, 8> words;
+        seq.generate(words.begin(), words.end());
+
+        std::array<State, 2> values{};
+        for (std::size_t i = 0; i < 8; i++) {
+            values[i / 4] = (values[i / 4] << 32) | words[i];
+        }
+        set_state(values[0], (values[1] << 1) | 1u);
+    }
+
+    /// The smallest value the generator may return
+    static constexpr result_type min () {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    /// The largest value the generator may return
+    static constexpr result_type max () {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /// Generate the next random number
+    result_type operator() () {
+        _state = _state * multiplier() + _inc;
+
+        const auto rot = static_cast<unsigned>(_state >> 122);
+        const auto x = static_cast<std::uint64_t>(_state >> 64)
+                       ^ static_cast<std::uint64_t>(_state);
+        return (x >> rot) | (x << ((-rot) & 63u));
+    }
+
+    /// Advance the generator by the given number of steps
+    void discard (unsigned long long n) {
+        for (; n > 0; n--) {
+            _state = _state * multiplier() + _inc;
+        }
+    }
+
+    /// Whether two generators have the same state and stream
+    friend bool operator== (const PCG64& a, const PCG64& b) {
+        return a._state == b._state and a._inc == b._inc;
+    }
+
+    /// Whether two generators differ in state or stream
+    friend bool operator!= (const PCG64& a, const PCG64& b) {
+        return not (a == b);
+    }
+
+private:
+    /// The multiplier of the linear congruential generator
+    static constexpr State multiplier () {
+        return (State(0x2360ed051fc65da4ULL) << 64) | 0x4385df649fccf645ULL;
+    }
+
+    /// Set the state from a seed value and an (odd) increment
+    void set_state (const State value, const State inc) {
+        _inc = inc;
+        _state = (value + _inc) * multiplier() + _inc;
+    }
+};
+
+
+/// A Bernoulli trial implemented as an integer comparison
+/** Compares the raw output of the RNG against a precomputed threshold,
+ *  instead of first converting it to a floating-point number in [0, 1).
+ *  This requires a single engine invocation per trial and no floating-point
+ *  arithmetic, whereas std::uniform_real_distribution<double> invokes a
+ *  32 bit engine like std::mt19937 twice per number.
+ *
+ *  The success probability is resolved in steps of 1/(range of the RNG),
+ *  i.e. 2^-32 for 32 bit engines and 2^-64 for 64 bit engines.
+ *
+ *  \tparam RNG  The random number engine
+ */
+template<class RNG>
+class BernoulliThreshold {
+public:
+    /// The type of the raw engine output
+    using result_type = typename RNG::result_type;
+
+private:
+    /// Trials whose (shifted) engine output is below this succeed
+    result_type _threshold;
+
+    /// Whether the trial always succeeds, i.e. the probability is one
+    bool _always;
+
+public:
+    /// Construct a Bernoulli trial with the given success probability
+    /** \throws std::invalid_argument If probability is outside of [0, 1]
+     */
+    explicit BernoulliThreshold (const double probability = 0.)
+    :
+        _threshold(0),
+        _always(false)
+    {
+        set_probability(probability);
+    }
+
+    /// Change the success probability
+    /** \throws std::invalid_argument If probability is outside of [0, 1]
+     */
+    void set_probability (const double probability) {
+        if (probability < 0. or probability > 1.) {
+            throw std::invalid_argument("Probability for Bernoulli trials "
+                "needs to be in the interval [0., 1.]!");
+        }
+
+        _always = (probability == 1.);
+        const long double num_values =
+            static_cast<long double>(RNG::max() - RNG::min()) + 1.L;
+        _threshold = _always ? 0 : static_cast<result_type>(
+            static_cast<long double>(probability) * num_values);
+    }
+
+    /// The threshold the shifted engine output is compared against
+    /** \note  Not meaningful if the success probability is one
+     */
+    result_type threshold () const {
+        return _threshold;
+    }
+
+    /// Perform a trial; returns true on success
+    bool operator() (RNG& rng) const {
+        return _always or (rng() - RNG::min()) < _threshold;
+    }
+};
+
+
+/// A Bernoulli trial implemented via a uniformly distributed real number
+/** Performs the same draws and comparison as the expression
+ *  `std::uniform_real_distribution<double>(0., 1.)(rng) < probability`,
+ *  such that realizations for a given seed are unchanged. It has the same
+ *  interface as Utopia::BernoulliThreshold.
+ *
+ *  \tparam RNG  The random number engine
+ */
+template<class RNG>
+class BernoulliUniform {
+private:
+    /// The success probability
+    double _probability;
+
+public:
+    /// Construct a Bernoulli trial with the given success probability
+    /** \throws std::invalid_argument If probability is outside of [0, 1]
+     */
+    explicit BernoulliUniform (const double probability = 0.)
+    :
+        _probability(0.)
+    {
+        set_probability(probability);
+    }
+
+    /// Change the success probability
+    /** \throws std::invalid_argument If probability is outside of [0, 1]
+     */
+    void set_probability (const double probability) {
+        if (probability < 0. or probability > 1.) {
+            throw std::invalid_argument("Probability for Bernoulli trials "
+                "needs to be in the interval [0., 1.]!");
+        }
+        _probability = probability;
+    }
+
+    /// Perform a trial; returns true on success
+    bool operator() (RNG& rng) const {
+        return std::uniform_real_distribution<double>(0., 1.)(rng)
+               < _probability;
+    }
+};
+
+/// The Bernoulli trial type to use with a random number engine
+/** For Utopia::DefaultRNG, this is Utopia::BernoulliUniform, which keeps
+ *  the realizations of existing simulations. For all other engines, which
+ *  are opted into for performance, it is the faster
+ *  Utopia::BernoulliThreshold.
+ */
+template<class RNG>
+using BernoulliTrial = std::conditional_t<std::is_same_v<RNG, DefaultRNG>,
+                                          BernoulliUniform<RNG>,
+                                          BernoulliThreshold<RNG>>;
+
+/// Fill a range with uniformly distributed numbers in [0, 1)
+/** The raw engine outputs are first drawn into a small block buffer and then
+ *  converted in a separate loop, which is free of dependencies between
+ *  iterations and can thus be vectorized by the compiler.
+ *
+ *  The resolution of the numbers is that of the engine output, at most 53
+ *  bit (the mantissa of a double). As each number takes a single engine
+ *  invocation, also for 32 bit engines, the numbers differ from those of
+ *  std::uniform_real_distribution for the same seed.
+ *
+ *  \param rng    The random number engine
+ *  \param first  Iterator to the beginning of the range to fill
+ *  \param last   Iterator to the end of the range to fill
+ */
+template<class RNG, class RandomIt>
+void fill_uniform (RNG& rng, RandomIt first, const RandomIt last) {
+    using Raw = typename RNG::result_type;
+    constexpr std::size_t block_size = 256;
+    constexpr bool full_range_64bit =
+        RNG::min() == 0
+        and RNG::max() == std::numeric_limits<std::uint64_t>::max();
+
+    const double scale = full_range_64bit
+        ? 0x1.0p-53
+        : 1. / (static_cast<double>(RNG::max() - RNG::min()) + 1.);
+
+    std::array<Raw, block_size> raw;
+    while (first != last) {
+        const auto n = static_cast<std::size_t>(
+            std::min<std::ptrdiff_t>(std::distance(first, last), block_size));
+
+        for (std::size_t i = 0; i < n; i++) {
+            raw[i] = rng() - RNG::min();
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            if constexpr (full_range_64bit) {
+                first[i] = static_cast<double>(raw[i] >> 11) * scale;
+            }
+            else {
+                first[i] = static_cast<double>(raw[i]) * scale;
+            }
+        }
+        first += n;
+    }
+}
+
+/// Fill a range with the outcomes of independent Bernoulli trials
+/** Uses the same integer-threshold comparison as Utopia::BernoulliThreshold
+ *  and the same two-stage, vectorizable approach as Utopia::fill_uniform.
+ *
+ *  \param rng          The random number engine
+ *  \param probability  The success probability of a single trial
+ *  \param first        Iterator to the beginning of the range to fill
+ *  \param last         Iterator to the end of the range to fill
+ *
+ *  \throws std::invalid_argument If probability is outside of [0, 1]
+ */
+template<class RNG, class RandomIt>
+void fill_bernoulli (RNG& rng,
+                     const double probability,
+                     RandomIt first,
+                     const RandomIt last)
+{
+    using Raw = typename RNG::result_type;
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    constexpr std::size_t block_size = 256;
+
+    if (probability == 1.) {
+        std::fill(first, last, Value(true));
+        return;
+    }
+    // Let the trial object take care of validation and the threshold
+    const auto threshold = BernoulliThreshold<RNG>(probability).threshold();
+
+    std::array<Raw, block_size> raw;
+    while (first != last) {
+        const auto n = static_cast<std::size_t>(
+            std::min<std::ptrdiff_t>(std::distance(first, last), block_size));
+
+        for (std::size_t i = 0; i < n; i++) {
+            raw[i] = rng() - RNG::min();
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            first[i] = Value(raw[i] < threshold);
+        }
+        first += n;
+    }
+}
+
+/**
+
+/// Split off independent random number engines from an engine
+/** Each new engine is seeded from a std::seed_seq of values drawn from the
+ *  given engine, such that the result is reproducible from the seed of the
+ *  latter. This is useful to give each replica of an ensemble, see
+ *  Utopia::Field, a random number stream of its own, independent of the
+ *  order in which the replicas draw their numbers. For Utopia::PCG64, the
+ *  seed sequence also selects the stream of the new engines.
+ *
+ *  \param rng  The engine to draw the seeds from
+ *  \param num  The number of engines to create
+ */
+template<class RNG>
+std::vector<RNG> split_rng (RNG& rng, const std::size_t num) {
+    std::vector<RNG> rngs;
+    rngs.reserve(num);
+
+    // Use all bits of the engine output, also for 64 bit engines
+    std::array<std::uint32_t, 8> words;
+    for (std::size_t i = 0; i < num; i++) {
+        for (std::size_t w = 0; w < words.size(); w += 2) {
+            const std::uint64_t value = rng() - RNG::min();
+            words[w] = static_cast<std::uint32_t>(value);
+            words[w + 1] = static_cast<std::uint32_t>(value >> 32);
+        }
+        std::seed_seq seq(words.begin(), words.end());
+        rngs.emplace_back(seq);
+    }
+    return rngs;
+}
+
+/**
+ *  \} // endgroup Rules
+ */
+
+} // namespace Utopia
+
+#endif // UTOPIA_CORE_RNG_HH
@@ -13,11 +13,13 @@
 #include <spdlog/spdlog.h>  // for fmt::
 
 #include "types.hh"
+#include "bernoulli.hh"
 #include "exceptions.hh"
 #include "entity.hh"
 #include "cell.hh"
 #include "agent.hh"
 #include "logging.hh"
+#include "parallel.hh"
 #include "../data_io/cfg_utils.hh"
 
 /**
@@ -350,6 +352,11 @@ Container select_entities(const Manager& mngr, const DataIO::Config& sel_cfg)
   * \param  mngr       The manager to select the entities from
   * \param  condition  A unary function working on a single entity and
   *                    returning a boolean.
+  * \param  policy     The execution policy with which the condition is
+  *                    evaluated. For policies other than the default,
+  *                    ExecPolicy::seq, the condition may be called
+  *                    concurrently and needs to be thread-safe; the order of
+  *                    the selected entities is preserved nevertheless.
   */
 template<
     SelectionMode mode,
@@ -359,12 +366,26 @@ template<
     typename std::enable_if_t<mode == SelectionMode::condition, int> = 0
     >
 Container select_entities(const Manager& mngr,
-                          const Condition& condition)
+                          const Condition& condition,
+                          const ExecPolicy policy = ExecPolicy::seq)
 {
-    Container selected{};
-    std::copy_if(mngr.entities().begin(), mngr.entities().end(),
-                 std::back_inserter(selected),
-                 condition);
+    if (policy == ExecPolicy::seq) {
+        Container selected{};
+        std::copy_if(mngr.entities().begin(), mngr.entities().end(),
+                     std::back_inserter(selected),
+                     condition);
+        return selected;
+    }
+
+    // Parallel algorithms require a forward iterator as output; allocate
+    // space for all entities and remove the unused part afterwards
+    Container selected(mngr.entities().size());
+    const auto selected_end = std::copy_if(policy,
+                                           mngr.entities().begin(),
+                                           mngr.entities().end(),
+                                           selected.begin(),
+                                           condition);
+    selected.erase(selected_end, selected.end());
     return selected;
 }
 
@@ -405,8 +426,13 @@ Container select_entities(const Manager& mngr,
 }
 
 /// Select entities with a certain probability
-/** Iterates over all entities and selects each entity with the given
-  * probability.
+/** Selects each entity independently with the given probability.
+  *
+  * Instead of drawing a random number for each entity, this jumps from one
+  * selected entity to the next using geometrically distributed skips, see
+  * \ref Utopia::for_each_bernoulli_success. The number of random numbers
+  * drawn is thus proportional to the number of *selected* entities, which
+  * makes this efficient for small probabilities.
   *
   * \note   The order of the entities in the returned container is the same as
   *         in the underlying container!
@@ -423,7 +449,7 @@ template<
 Container select_entities(const Manager& mngr,
                           const double probability)
 {
-    // Before drawing a huge amount of random numbers, check obvious cases
+    // Check obvious cases
     if (probability == 0.) {
         return {};
     }
@@ -435,17 +461,17 @@ Container select_entities(const Manager& mngr,
             "failed due to probability argument outside of interval [0., 1.]");
     }
 
-    // Build the distribution, selection condition lambda, and select ...
-    std::uniform_real_distribution<> dist(0., 1.);
+    const auto& entities = mngr.entities();
+    Container selected{};
+    selected.reserve(static_cast<std::size_t>(
+        1.1 * probability * entities.size()) + 1);
 
-    return
-        select_entities<SelectionMode::condition>(
-            mngr,
-            // Declare a mutable lambda (needed for dist)
-            [&, dist{std::move(dist)}](const auto&) mutable {
-                return (dist(*mngr.rng()) < probability);
-            }
-        );
+    for_each_bernoulli_success(entities.size(), probability, *mngr.rng(),
+        [&](const std::size_t idx){
+            selected.push_back(entities[idx]);
+        }
+    );
+    return selected;
 }
 
 // ++ Cell-based selection functions ++++++++++++++++++++++++++++++++++++++++++
@@ -0,0 +1,89 @@
+#ifndef UTOPIA_CORE_SPACE_FILLING_CURVES_HH
+#define UTOPIA_CORE_SPACE_FILLING_CURVES_HH
+
+#include <cstdint>
+#include <utility>
+
+namespace Utopia {
+/**
+ *  \addtogroup CellManager
+ *  \{
+ */
+
+/* Positions of multi-indices along space-filling curves
+ *
+ * Sorting by these keys places indices that are close in space close to
+ * each other. They are used to lay out cells in memory, see memory_order_of,
+ * and to sort agents spatially, see AgentManager::sort_agents.
+ * Multi-indices need to provide `n_elem` and `operator[]`, like the
+ * Armadillo vectors of MultiIndexType.
+ */
+
+/// The position of a multi-index along the Z-order curve
+template<class MultiIndex>
+std::uint64_t morton_key (const MultiIndex& midx) {
+    const std::size_t dim = midx.n_elem;
+    std::uint64_t key = 0;
+    for (std::size_t bit = 0; bit * dim < 64; bit++) {
+        for (std::size_t d = 0; d < dim and bit * dim + d < 64; d++) {
+            key |= ((std::uint64_t(midx[d]) >> bit) & 1u) << (bit * dim + d);
+        }
+    }
+    return key;
+}
+
+/// The position of a two-dimensional index along the Hilbert curve
+/** \param n  The side length of the curve's square, a power of two that is
+  *           larger than the indices in both dimensions
+  */
+inline std::uint64_t hilbert_key (const std::uint64_t n,
+                                  std::uint64_t x,
+                                  std::uint64_t y)
+{
+    std::uint64_t key = 0;
+    for (std::uint64_t s = n / 2; s > 0; s /= 2) {
+        const std::uint64_t rx = (x & s) > 0;
+        const std::uint64_t ry = (y & s) > 0;
+        key += s * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant such that the curve is continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return key;
+}
+
+/// The position of a multi-index when laid out in tiles
+template<class MultiIndex>
+std::uint64_t tiled_key (const MultiIndex& midx,
+                         const MultiIndex& shape,
+                         const std::uint64_t tile_size)
+{
+    // Flatten the index of the tile and the index within the tile, both with
+    // the first dimension running fastest (like the cell IDs)
+    std::uint64_t tile = 0, within = 0;
+    for (std::size_t d = midx.n_elem; d-- > 0;) {
+        const std::uint64_t num_tiles = (shape[d] + tile_size - 1) / tile_size;
+        tile = tile * num_tiles + midx[d] / tile_size;
+        within = within * tile_size + midx[d] % tile_size;
+    }
+
+    std::uint64_t tile_volume = 1;
+    for (std::size_t d = 0; d < midx.n_elem; d++) {
+        tile_volume *= tile_size;
+    }
+    return tile * tile_volume + within;
+}
+
+/**
+ *  \} // endgroup CellManager
+ */
+
+} // namespace Utopia
+
+#endif // UTOPIA_CORE_SPACE_FILLING_CURVES_HH
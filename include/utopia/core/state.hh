@@ -1,6 +1,8 @@
 #ifndef UTOPIA_CORE_STATE_HH
 #define UTOPIA_CORE_STATE_HH
 
+#include <array>
+
 namespace Utopia {
 
 /**
@@ -84,7 +86,10 @@ private:
 };
 
 /// State Container specialization for sync states
-/**
+/** The current and the new state are kept in two buffers. Committing the new
+ *  state can either copy the buffer (update()) or merely exchange the roles of
+ *  the two buffers (swap_buffers()), which avoids copying the state.
+ *
  *  \warning Using this specialization is discouraged because it determines
  *           the type of update used in apply_rule(). See \ref Rules for
  *           details.
@@ -101,20 +106,29 @@ public:
 
     /// Construct state container with specific state
     StateContainer (const State state):
-        _state(state),
-        _state_new(state)
+        _buffers{state, state},
+        _front(0)
     { }
 
     /// Return reference to state cache
-    State& state_new () { return _state_new; }
+    State& state_new () { return _buffers[_front ^ 1u]; }
     /// Return const reference to state
-    const State& state () const { return _state; }
+    const State& state () const { return _buffers[_front]; }
     /// Overwrite state with state cache
-    void update () noexcept { _state = _state_new; }
+    void update () noexcept { _buffers[_front] = _buffers[_front ^ 1u]; }
+
+    /// Make the state cache the current state without copying it
+    /** After this operation, the state cache holds the *previous* state.
+     *  Only use this if the cache is completely overwritten before the next
+     *  call, e.g. by a rule returning the new state.
+     */
+    void swap_buffers () noexcept { _front ^= 1u; }
 
 private:
-    State _state;
-    State _state_new;
+    /// The two state buffers, one of which is the current state
+    std::array<State, 2> _buffers;
+    /// The index of the buffer holding the current state
+    unsigned char _front;
 };
 
 /**
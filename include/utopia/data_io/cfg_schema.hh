@@ -0,0 +1,306 @@
+#ifndef UTOPIA_DATAIO_CFG_SCHEMA_HH
+#define UTOPIA_DATAIO_CFG_SCHEMA_HH
+
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/core/demangle.hpp>
+
+#include "cfg_utils.hh"
+
+
+namespace Utopia {
+/*!
+ * \addtogroup ConfigUtilities
+ * \{
+ */
+
+/// A requirement a parameter value needs to fulfill
+/** \tparam T  The type of the parameter value
+ */
+template<class T>
+struct ParamRequirement {
+    /// Returns true if the given value fulfills the requirement
+    std::function<bool(const T&)> is_valid;
+
+    /// Describes the requirement; completes the sentence "Needs to ..."
+    std::string description;
+};
+
+/// Requires a value to lie within the closed interval [lower, upper]
+template<class T>
+ParamRequirement<T> in_interval (const T lower, const T upper) {
+    std::ostringstream desc;
+    desc << "be in interval [" << lower << ", " << upper << "]";
+    return {[lower, upper](const T& v){ return lower <= v and v <= upper; },
+            desc.str()};
+}
+
+/// Requires a value to be a probability, i.e. to lie within [0, 1]
+inline ParamRequirement<double> is_probability () {
+    return {[](const double& p){ return 0. <= p and p <= 1.; },
+            "be a probability, i.e. in interval [0, 1]"};
+}
+
+/// Requires a value to be strictly positive
+template<class T>
+ParamRequirement<T> is_positive () {
+    return {[](const T& v){ return v > T(0); }, "be positive"};
+}
+
+/// Requires a value to be non-negative
+template<class T>
+ParamRequirement<T> is_non_negative () {
+    return {[](const T& v){ return v >= T(0); }, "be non-negative"};
+}
+
+
+/// Binds configuration entries to the members of a parameter struct
+/** A schema describes once which configuration entries make up a parameter
+ *  struct, how they are to be converted, and which requirements they need to
+ *  fulfill. The configuration is then parsed and validated a single time,
+ *  resulting in a plain C++ struct that can be accessed without any YAML
+ *  lookups, e.g. from within rule functions or by many entities at once.
+ *
+ *  All entries are checked before an error is raised, such that a single
+ *  exception reports all problems of a configuration node.
+ *
+ *  Example:
+ *  \code{.cc}
+ *   struct Params {
+ *       double p_growth;
+ *       unsigned num_seeds;
+ *       double temperature;
+ *   };
+ *
+ *   const auto schema = ConfigSchema<Params>("growth parameters")
+ *       .required("p_growth", &Params::p_growth, is_probability())
+ *       .required("num_seeds", &Params::num_seeds)
+ *       .optional("temperature", &Params::temperature, 20.);
+ *
+ *   const auto params = schema.parse(cfg);
+ *  \endcode
+ *
+ *  \tparam Params  The parameter struct; needs to be default-constructible
+ */
+template<class Params>
+class ConfigSchema {
+    static_assert(std::is_default_constructible_v<Params>,
+                  "The parameter struct of a ConfigSchema needs to be "
+                  "default-constructible!");
+
+public:
+    /// Type of the functions binding a single entry
+    /** Arguments: the struct to write to, the config node to read from, the
+     *  container to store error messages in, and the key prefix to prepend
+     *  to the error messages.
+     */
+    using Binder = std::function<void(Params&,
+                                      const DataIO::Config&,
+                                      std::vector<std::string>&,
+                                      const std::string&)>;
+
+private:
+    /// A name for the parameters, used in error messages
+    std::string _name;
+
+    /// The functions binding the individual entries
+    std::vector<Binder> _binders;
+
+public:
+    /// Construct an empty schema
+    /** \param name  A name for the parameters, used in error messages
+     */
+    explicit ConfigSchema (const std::string& name)
+    :
+        _name(name),
+        _binders{}
+    {}
+
+    /// Bind a required entry to a member of the parameter struct
+    template<class T>
+    ConfigSchema& required (const std::string& key, T Params::* member) {
+        _binders.push_back(make_binder(key, member, {}, {}));
+        return *this;
+    }
+
+    /// Bind a required entry and check it against a requirement
+    template<class T>
+    ConfigSchema& required (const std::string& key,
+                            T Params::* member,
+                            const ParamRequirement<T>& requirement)
+    {
+        _binders.push_back(make_binder(
+            key, member, {},
+            std::make_shared<ParamRequirement<T>>(requirement)));
+        return *this;
+    }
+
+    /// Bind an optional entry, using the fallback value if it is missing
+    template<class T>
+    ConfigSchema& optional (const std::string& key,
+                            T Params::* member,
+                            const T& fallback)
+    {
+        _binders.push_back(make_binder(key, member,
+                                       std::make_shared<T>(fallback),
+                                       {}));
+        return *this;
+    }
+
+    /// Bind an optional entry and check it against a requirement
+    /** \note  The requirement is also checked for the fallback value.
+     */
+    template<class T>
+    ConfigSchema& optional (const std::string& key,
+                            T Params::* member,
+                            const T& fallback,
+                            const ParamRequirement<T>& requirement)
+    {
+        _binders.push_back(make_binder(
+            key, member, std::make_shared<T>(fallback),
+            std::make_shared<ParamRequirement<T>>(requirement)));
+        return *this;
+    }
+
+    /// Bind a required mapping entry to a nested parameter struct
+    /** \param key     The key of the mapping within the configuration node
+     *  \param member  The member the nested parameters are written to
+     *  \param schema  The schema to parse the nested parameters with
+     */
+    template<class Nested>
+    ConfigSchema& nested (const std::string& key,
+                          Nested Params::* member,
+                          const ConfigSchema<Nested>& schema)
+    {
+        _binders.push_back(
+            [key, member, schema](Params& params,
+                                  const DataIO::Config& cfg,
+                                  std::vector<std::string>& errors,
+                                  const std::string& prefix)
+            {
+                const auto node = cfg[key];
+                if (not node) {
+                    errors.push_back("Missing required entry '"
+                                     + prefix + key + "'");
+                    return;
+                }
+                schema.collect(params.*member, node, errors,
+                               prefix + key + ".");
+            }
+        );
+        return *this;
+    }
+
+    /// Parse and validate the given configuration node
+    /** \throws std::invalid_argument Listing all missing, unconvertible, or
+     *          invalid entries, if there were any
+     */
+    Params parse (const DataIO::Config& cfg) const {
+        Params params{};
+        std::vector<std::string> errors{};
+        collect(params, cfg, errors, "");
+
+        if (not errors.empty()) {
+            std::string msg = "Invalid " + _name + " configuration:";
+            for (const auto& err : errors) {
+                msg += "\n  - " + err;
+            }
+            throw std::invalid_argument(msg);
+        }
+        return params;
+    }
+
+    /// Parse the given configuration into an immutable, shareable struct
+    std::shared_ptr<const Params> parse_shared (const DataIO::Config& cfg)
+                                                                        const
+    {
+        return std::make_shared<const Params>(parse(cfg));
+    }
+
+    /// Parse the configuration node, storing errors instead of throwing
+    /** This is used for nested parameter structs; use parse() instead.
+     */
+    void collect (Params& params,
+                  const DataIO::Config& cfg,
+                  std::vector<std::string>& errors,
+                  const std::string& prefix) const
+    {
+        if (not cfg.IsMap()) {
+            errors.push_back("Expected a mapping"
+                + (prefix.empty() ? std::string("")
+                                  : " for '"
+                                    + prefix.substr(0, prefix.size() - 1)
+                                    + "'")
+                + ", but got:\n" + DataIO::to_string(cfg));
+            return;
+        }
+
+        for (const auto& bind : _binders) {
+            bind(params, cfg, errors, prefix);
+        }
+    }
+
+private:
+    /// Create the binder for a single entry
+    /** \param fallback     If not null, the entry is optional
+     *  \param requirement  If not null, the value is checked against it
+     */
+    template<class T>
+    static Binder make_binder (
+        const std::string& key,
+        T Params::* member,
+        const std::shared_ptr<std::decay_t<T>>& fallback,
+        const std::shared_ptr<ParamRequirement<std::decay_t<T>>>& requirement)
+    {
+        return [key, member, fallback, requirement](
+            Params& params,
+            const DataIO::Config& cfg,
+            std::vector<std::string>& errors,
+            const std::string& prefix)
+        {
+            const auto node = cfg[key];
+            if (not node) {
+                if (not fallback) {
+                    errors.push_back("Missing required entry '"
+                                     + prefix + key + "'");
+                    return;
+                }
+                params.*member = *fallback;
+            }
+            else {
+                try {
+                    params.*member = node.template as<T>();
+                }
+                catch (YAML::Exception&) {
+                    errors.push_back("Could not convert entry '"
+                        + prefix + key + "' with value '"
+                        + DataIO::to_string(node) + "' to type "
+                        + boost::core::demangle(typeid(T).name()));
+                    return;
+                }
+            }
+
+            if (requirement and not requirement->is_valid(params.*member)) {
+                errors.push_back("Entry '" + prefix + key + "' needs to "
+                    + requirement->description + ", but was '"
+                    + (node ? DataIO::to_string(node) : "<fallback>")
+                    + "'");
+            }
+        };
+    }
+};
+
+// end group ConfigUtilities
+/**
+ *  \}
+ */
+
+} // namespace Utopia
+
+#endif // UTOPIA_DATAIO_CFG_SCHEMA_HH
@@ -1,7 +1,11 @@
 #ifndef UTOPIA_DATAIO_GRAPH_UTILS_HH
 #define UTOPIA_DATAIO_GRAPH_UTILS_HH
 
+#include <algorithm>
+#include <numeric>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/adjacency_matrix.hpp>
@@ -581,6 +585,392 @@ save_edge_properties(Graph&&                            g,
                                                      adaptor_tuple);
 }
 
+/// Writes the edges of a dynamic graph as keyframes and edge deltas
+/** Instead of writing the complete edge list at every write operation, this
+ *  writer keeps the edge list of the last write operation and only stores
+ *  the edges that were added and removed since then. To allow efficient
+ *  reconstruction, the complete edge list is additionally written as a
+ *  *keyframe* in the first write operation and every ``keyframe_interval``
+ *  write operations.
+ *
+ *  The data is stored in the given graph group as follows:
+ *
+ *    - ``_edges/<time>``: The keyframes, i.e. the full edge list of shape
+ *      ``(2, num_edges)``. This is the same layout as used when writing the
+ *      edges via \ref Utopia::DataIO::save_edge_properties with the time as
+ *      label.
+ *    - ``_edge_delta/keyframe_times``: The times at which keyframes were
+ *      written.
+ *    - ``_edge_delta/time``: The time of each delta record.
+ *    - ``_edge_delta/num_added`` and ``_edge_delta/num_removed``: The number
+ *      of added and removed edges of each delta record.
+ *    - ``_edge_delta/added_source``, ``_edge_delta/added_target``,
+ *      ``_edge_delta/removed_source``, ``_edge_delta/removed_target``:
+ *      The concatenated edge events of all delta records. The offset of a
+ *      record is given by the cumulative sum of the preceding counts.
+ *
+ *  The edge list at any written time can be reconstructed by taking the
+ *  latest keyframe and applying the subsequent delta records in order; see
+ *  \ref Utopia::DataIO::load_graph_delta_edges.
+ *
+ *  The same layout is used by \ref Utopia::DataIO::DeltaWriter to store
+ *  frames of a fixed number of entries, e.g. the cell states of a grid.
+ *
+ *  \note Edges are identified by their (source, target) vertex ids. For
+ *        undirected graphs, the pair is normalized such that the smaller
+ *        vertex id is the source. Parallel edges are supported.
+ *
+ *  Edge properties, e.g. weights, need to be written in the same order as
+ *  the edge lists, which is sorted by (source, target). Use the descriptors
+ *  returned by \ref edge_descriptors after each write operation for this;
+ *  then, the i-th property value belongs to the i-th reconstructed edge.
+ *
+ *  \tparam Graph       The graph type
+ *  \tparam VertexIdMap The property map type of the vertex ids
+ */
+template <typename Graph,
+          typename VertexIdMap = typename boost::property_map<
+                                    Graph, boost::vertex_index_t>::const_type>
+class GraphDeltaWriter {
+public:
+    /// The type of a vertex id
+    using VertexId = typename boost::property_traits<VertexIdMap>::value_type;
+
+    /// The type of an edge, given by a (source, target) pair of vertex ids
+    using EdgeIds = std::pair<VertexId, VertexId>;
+
+    /// The type of the container holding the edge ids
+    using EdgeIdContainer = std::vector<EdgeIds>;
+
+    /// The type of the container holding the edge descriptors
+    using EdgeDescContainer = std::vector<
+        typename boost::graph_traits<Graph>::edge_descriptor>;
+
+private:
+    /// The graph group the data is written to
+    const std::shared_ptr<HDFGroup> _nw_grp;
+
+    /// The group holding the keyframe datasets
+    const std::shared_ptr<HDFGroup> _keyframe_grp;
+
+    /// The group holding the delta datasets
+    const std::shared_ptr<HDFGroup> _delta_grp;
+
+    /// The vertex id property map
+    const VertexIdMap _vertex_ids;
+
+    /// After how many write operations to write a keyframe; 0: only initial
+    const std::size_t _keyframe_interval;
+
+    /// The number of write operations performed so far
+    std::size_t _num_writes;
+
+    /// The sorted edge ids at the last write operation
+    EdgeIdContainer _edges;
+
+    /// The edge descriptors at the last write operation, ordered like _edges
+    EdgeDescContainer _edge_descs;
+
+    // Datasets of the delta group
+    const std::shared_ptr<HDFDataset> _dset_keyframe_times;
+    const std::shared_ptr<HDFDataset> _dset_time;
+    const std::shared_ptr<HDFDataset> _dset_num_added;
+    const std::shared_ptr<HDFDataset> _dset_num_removed;
+    const std::shared_ptr<HDFDataset> _dset_added_source;
+    const std::shared_ptr<HDFDataset> _dset_added_target;
+    const std::shared_ptr<HDFDataset> _dset_removed_source;
+    const std::shared_ptr<HDFDataset> _dset_removed_target;
+
+public:
+    /// Construct a graph delta writer
+    /** \param g                 The graph that is to be written
+     *  \param nw_grp            The graph group to write to, e.g. as created
+     *                           by \ref Utopia::DataIO::create_graph_group
+     *  \param keyframe_interval After how many write operations to write the
+     *                           full edge list again. If 0, only the initial
+     *                           keyframe is written.
+     *  \param vertex_ids        The vertex id property map
+     */
+    GraphDeltaWriter(const Graph&,
+                     const std::shared_ptr<HDFGroup>& nw_grp,
+                     const std::size_t keyframe_interval,
+                     const VertexIdMap vertex_ids)
+    :
+        _nw_grp(nw_grp),
+        _keyframe_grp(nw_grp->open_group("_edges")),
+        _delta_grp(nw_grp->open_group("_edge_delta")),
+        _vertex_ids(vertex_ids),
+        _keyframe_interval(keyframe_interval),
+        _num_writes(0),
+        _edges{},
+        _edge_descs{},
+        _dset_keyframe_times(_delta_grp->open_dataset("keyframe_times")),
+        _dset_time(_delta_grp->open_dataset("time")),
+        _dset_num_added(_delta_grp->open_dataset("num_added")),
+        _dset_num_removed(_delta_grp->open_dataset("num_removed")),
+        _dset_added_source(_delta_grp->open_dataset("added_source")),
+        _dset_added_target(_delta_grp->open_dataset("added_target")),
+        _dset_removed_source(_delta_grp->open_dataset("removed_source")),
+        _dset_removed_target(_delta_grp->open_dataset("removed_target"))
+    {
+        _delta_grp->add_attribute("content", "graph_delta");
+        _delta_grp->add_attribute("keyframe_interval", _keyframe_interval);
+    }
+
+    /// Construct a graph delta writer using the graph's vertex indices
+    /** \param g                 The graph that is to be written
+     *  \param nw_grp            The graph group to write to
+     *  \param keyframe_interval After how many write operations to write the
+     *                           full edge list again. If 0, only the initial
+     *                           keyframe is written.
+     */
+    GraphDeltaWriter(const Graph& g,
+                     const std::shared_ptr<HDFGroup>& nw_grp,
+                     const std::size_t keyframe_interval = 0)
+    :
+        GraphDeltaWriter(g, nw_grp, keyframe_interval,
+                         boost::get(boost::vertex_index_t(), g))
+    {}
+
+    /// Write the edges of the given graph
+    /** Depending on the number of preceding write operations, this writes
+     *  either a keyframe or a delta record relative to the last write.
+     *
+     *  \param g     The graph to write the edges of
+     *  \param time  The time (or other label) to associate with this write
+     */
+    template <typename Time>
+    void write(const Graph& g, const Time time) {
+        auto edges = collect_edges(g, _edge_descs);
+
+        if (   _num_writes == 0
+            or (    _keyframe_interval > 0
+                and _num_writes % _keyframe_interval == 0))
+        {
+            write_keyframe(edges, time);
+        }
+        else {
+            write_delta(edges, time);
+        }
+
+        _edges = std::move(edges);
+        ++_num_writes;
+    }
+
+    /// The number of write operations performed so far
+    std::size_t num_writes() const {
+        return _num_writes;
+    }
+
+    /// The sorted edge ids of the last write operation
+    const EdgeIdContainer& edges() const {
+        return _edges;
+    }
+
+    /// The edge descriptors of the last write operation, ordered like edges
+    /** Use these to write edge properties in the order of the written edge
+     *  lists. They are only valid until the graph is modified.
+     */
+    const EdgeDescContainer& edge_descriptors() const {
+        return _edge_descs;
+    }
+
+private:
+    /// Collect the sorted (and, if undirected, normalized) edge ids
+    /** The descriptors of the edges are stored in the same order in descs.
+     */
+    EdgeIdContainer collect_edges(const Graph& g,
+                                  EdgeDescContainer& descs) const
+    {
+        EdgeIdContainer ids;
+        EdgeDescContainer unsorted_descs;
+        ids.reserve(boost::num_edges(g));
+        unsorted_descs.reserve(boost::num_edges(g));
+
+        for (auto [e, e_end] = boost::edges(g); e != e_end; ++e) {
+            auto s = boost::get(_vertex_ids, boost::source(*e, g));
+            auto t = boost::get(_vertex_ids, boost::target(*e, g));
+
+            if constexpr (not boost::is_directed_graph<Graph>::value) {
+                if (t < s) {
+                    std::swap(s, t);
+                }
+            }
+            ids.emplace_back(s, t);
+            unsorted_descs.push_back(*e);
+        }
+
+        std::vector<std::size_t> order(ids.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+            [&ids](const auto a, const auto b){ return ids[a] < ids[b]; }
+        );
+
+        EdgeIdContainer edges;
+        edges.reserve(ids.size());
+        descs.clear();
+        descs.reserve(ids.size());
+        for (const auto i : order) {
+            edges.push_back(ids[i]);
+            descs.push_back(unsorted_descs[i]);
+        }
+        return edges;
+    }
+
+    /// Write the full edge list as keyframe dataset ``_edges/<time>``
+    template <typename Time>
+    void write_keyframe(const EdgeIdContainer& edges, const Time time) {
+        const auto dset = _keyframe_grp->open_dataset(std::to_string(time),
+                                                      {2, edges.size()});
+
+        dset->write(edges.begin(), edges.end(),
+                    [](const auto& e){ return e.first; });
+        dset->write(edges.begin(), edges.end(),
+                    [](const auto& e){ return e.second; });
+
+        dset->add_attribute("dim_name__0", "type");
+        dset->add_attribute("coords_mode__type", "values");
+        dset->add_attribute("coords__type",
+                            std::vector<std::string>{"source", "target"});
+        dset->add_attribute("dim_name__1", "edge_idx");
+        dset->add_attribute("coords_mode__edge_idx", "trivial");
+
+        _dset_keyframe_times->write(static_cast<std::size_t>(time));
+
+        spdlog::get("data_io")->debug("Wrote graph keyframe with {} edges at "
+                                      "time {}.", edges.size(), time);
+    }
+
+    /// Write the edges added and removed since the last write operation
+    template <typename Time>
+    void write_delta(const EdgeIdContainer& edges, const Time time) {
+        EdgeIdContainer added, removed;
+        std::set_difference(edges.begin(), edges.end(),
+                            _edges.begin(), _edges.end(),
+                            std::back_inserter(added));
+        std::set_difference(_edges.begin(), _edges.end(),
+                            edges.begin(), edges.end(),
+                            std::back_inserter(removed));
+
+        _dset_time->write(static_cast<std::size_t>(time));
+        _dset_num_added->write(added.size());
+        _dset_num_removed->write(removed.size());
+
+        // Empty records need not be written to the event datasets
+        if (not added.empty()) {
+            _dset_added_source->write(added.begin(), added.end(),
+                                      [](const auto& e){ return e.first; });
+            _dset_added_target->write(added.begin(), added.end(),
+                                      [](const auto& e){ return e.second; });
+        }
+        if (not removed.empty()) {
+            _dset_removed_source->write(removed.begin(), removed.end(),
+                                        [](const auto& e){ return e.first; });
+            _dset_removed_target->write(removed.begin(), removed.end(),
+                                        [](const auto& e){ return e.second; });
+        }
+
+        spdlog::get("data_io")->debug("Wrote graph delta with {} added and {} "
+                                      "removed edges at time {}.",
+                                      added.size(), removed.size(), time);
+    }
+};
+
+
+/// Reconstruct the edge list written by a GraphDeltaWriter at a given time
+/** This reads the latest keyframe written at or before the given time and
+ *  applies all subsequent delta records up to and including the given time.
+ *  If there was no write operation at exactly the given time, the edge list
+ *  of the latest write operation before it is returned.
+ *
+ *  \tparam VertexId  The type of the vertex ids; needs to match the type
+ *                    that was written by the GraphDeltaWriter
+ *
+ *  \param nw_grp     The graph group the GraphDeltaWriter wrote to
+ *  \param time       The time at which to reconstruct the edge list
+ *
+ *  \return The sorted (source, target) pairs of all edges at that time
+ */
+template <typename VertexId = std::size_t>
+std::vector<std::pair<VertexId, VertexId>>
+load_graph_delta_edges(const std::shared_ptr<HDFGroup>& nw_grp,
+                       const std::size_t time)
+{
+    const auto delta_grp = nw_grp->open_group("_edge_delta");
+
+    // Reads a 1D dataset, returning an empty vector if it was never written
+    auto read_1d = [&](auto&& grp, const std::string& name, auto tag) {
+        using T = decltype(tag);
+        const auto dset = grp->open_dataset(name);
+        if (not dset->is_valid()) {
+            return std::vector<T>{};
+        }
+        return std::get<1>(dset->template read<std::vector<T>>());
+    };
+
+    // Find the latest keyframe at or before the given time
+    const auto keyframe_times =
+        read_1d(delta_grp, "keyframe_times", std::size_t{});
+    const auto kf = std::upper_bound(keyframe_times.begin(),
+                                     keyframe_times.end(), time);
+    if (kf == keyframe_times.begin()) {
+        throw std::invalid_argument("No graph keyframe was written at or "
+                                    "before time " + std::to_string(time)
+                                    + "!");
+    }
+    const auto keyframe_time = *std::prev(kf);
+
+    // Read the keyframe; it is of shape (2, num_edges)
+    const auto kf_data = read_1d(nw_grp->open_group("_edges"),
+                                 std::to_string(keyframe_time), VertexId{});
+    const auto num_edges = kf_data.size() / 2;
+
+    std::vector<std::pair<VertexId, VertexId>> edges;
+    edges.reserve(num_edges);
+    for (std::size_t i = 0; i < num_edges; ++i) {
+        edges.emplace_back(kf_data[i], kf_data[num_edges + i]);
+    }
+
+    // Read the delta records and the events
+    const auto times = read_1d(delta_grp, "time", std::size_t{});
+    const auto num_added = read_1d(delta_grp, "num_added", std::size_t{});
+    const auto num_removed = read_1d(delta_grp, "num_removed", std::size_t{});
+    const auto added_src = read_1d(delta_grp, "added_source", VertexId{});
+    const auto added_trgt = read_1d(delta_grp, "added_target", VertexId{});
+    const auto removed_src = read_1d(delta_grp, "removed_source", VertexId{});
+    const auto removed_trgt = read_1d(delta_grp, "removed_target", VertexId{});
+
+    // Apply all records after the keyframe up to the given time
+    std::size_t added_offset = 0, removed_offset = 0;
+    for (std::size_t r = 0; r < times.size() and times[r] <= time; ++r) {
+        if (times[r] > keyframe_time) {
+            std::vector<std::pair<VertexId, VertexId>> removed, added;
+            for (std::size_t i = 0; i < num_removed[r]; ++i) {
+                removed.emplace_back(removed_src[removed_offset + i],
+                                     removed_trgt[removed_offset + i]);
+            }
+            for (std::size_t i = 0; i < num_added[r]; ++i) {
+                added.emplace_back(added_src[added_offset + i],
+                                   added_trgt[added_offset + i]);
+            }
+
+            std::vector<std::pair<VertexId, VertexId>> remaining, merged;
+            std::set_difference(edges.begin(), edges.end(),
+                                removed.begin(), removed.end(),
+                                std::back_inserter(remaining));
+            std::merge(remaining.begin(), remaining.end(),
+                       added.begin(), added.end(),
+                       std::back_inserter(merged));
+            edges = std::move(merged);
+        }
+
+        added_offset += num_added[r];
+        removed_offset += num_removed[r];
+    }
+
+    return edges;
+}
+
 // TODO add functions here to open datasets for edge or vertex attributes.
 
 /*! \} */ // end of group GraphUtilities
@@ -10,14 +10,19 @@
 #ifndef UTOPIA_DATAIO_HDFDATASET_HH
 #define UTOPIA_DATAIO_HDFDATASET_HH
 
+#include <algorithm>
+#include <iterator>
 #include <numeric>
 #include <stdexcept>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <hdf5.h>
 #include <hdf5_hl.h>
+#include <zlib.h>
 
+#include "../core/parallel.hh"
 #include "../core/type_traits.hh"
 
 #include "hdfattribute.hh"
@@ -76,9 +81,24 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
 
         _type.open<Datatype>("datatype of " + _path, typesize);
 
+        // The type the values are stored as; single precision, if configured
+        hid_t file_type = _type.get_C_id();
+        if constexpr (std::is_same_v<Datatype, double>)
+        {
+            if (_float_precision == FloatPrecision::single)
+            {
+                file_type = H5T_NATIVE_FLOAT;
+            }
+        }
+
+        // Quantization requires chunking
+        const bool scale_offset =
+            std::is_floating_point_v<Datatype> and
+            _float_precision == FloatPrecision::scale_offset;
+
         // this is something different than typesize, which has meaning for
         // arrays only
-        if (_capacity != _current_extent)
+        if (_capacity != _current_extent or scale_offset)
         {
             if (_chunksizes.size() != _rank)
             {
@@ -98,6 +118,12 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
             this->_log->debug("Setting given chunksizes ...");
             H5Pset_chunk(plist, _rank, _chunksizes.data());
 
+            // quantize before compressing
+            if (scale_offset)
+            {
+                H5Pset_scaleoffset(plist, H5Z_SO_FLOAT_DSCALE, _float_digits);
+            }
+
             if (_compress_level > 0)
             {
                 H5Pset_deflate(plist, _compress_level);
@@ -113,7 +139,7 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
                 "Creating actual dataset and binding it to object class ...");
 
             bind_to(H5Dcreate(_parent_identifier.get_id(), _path.c_str(),
-                              _type.get_C_id(), _filespace.get_C_id(),
+                              file_type, _filespace.get_C_id(),
                               group_plist, plist, H5P_DEFAULT),
                     &H5Dclose);
 
@@ -134,7 +160,7 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
                 "Creating actual dataset and binding it to object class ...");
             // can create the dataset right away
             bind_to(H5Dcreate(_parent_identifier.get_id(), _path.c_str(),
-                              _type.get_C_id(), _filespace.get_C_id(),
+                              file_type, _filespace.get_C_id(),
                               group_plist, H5P_DEFAULT, H5P_DEFAULT),
                     &H5Dclose);
 
@@ -147,6 +173,10 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
 
         this->_log->debug("refcount of dataset after creation {}: {}", _path,
                           get_refcount());
+
+        // write out buffered attributes right away; they cannot be created
+        // anymore once the file was switched to SWMR mode
+        __write_attribute_buffer__();
     }
 
     /**
@@ -724,6 +754,374 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
                        _filespace.get_C_id(), H5P_DEFAULT, &buffer);
     }
 
+    /**
+     * @brief Appends a slice to the write buffer, writing the buffer out once
+     * it holds the configured number of slices
+     *
+     * @tparam Value The element type of the slice
+     * @tparam Data  The container type of the slice, automatically determined
+     * @param data   The slice to buffer
+     */
+    template <typename Value, typename Data>
+    void __buffer_slice__(const Data &data)
+    {
+        const hsize_t size = std::distance(std::begin(data), std::end(data));
+        const auto flush_func = &HDFDataset::__flush_write_buffer__<Value>;
+
+        // Changing the element type or slice size requires writing out first
+        if (_write_buffer.num_slices > 0 and
+            (_write_buffer.slice_size != size or
+             _write_buffer.flush_func != flush_func))
+        {
+            flush();
+        }
+
+        if (_write_buffer.num_slices == 0)
+        {
+            this->_log->debug("Buffering up to {} slices of dataset {}",
+                              _write_buffer.capacity, _path);
+            _write_buffer.slice_size = size;
+            _write_buffer.flush_func = flush_func;
+            _write_buffer.data.reserve(_write_buffer.capacity * size *
+                                       sizeof(Value));
+        }
+
+        const auto offset = _write_buffer.num_slices * size;
+        _write_buffer.data.resize((offset + size) * sizeof(Value));
+        std::copy(std::begin(data), std::end(data),
+                  reinterpret_cast<Value *>(_write_buffer.data.data()) +
+                      offset);
+        ++_write_buffer.num_slices;
+
+        if (_write_buffer.num_slices >= _write_buffer.capacity)
+        {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Writes all buffered slices as a single hyperslab
+     *
+     * @tparam Value The element type of the buffered slices
+     */
+    template <typename Value> void __flush_write_buffer__()
+    {
+        const std::vector<hsize_t> counts{_write_buffer.num_slices,
+                                          _write_buffer.slice_size};
+
+        this->_log->debug("Writing {} buffered slices to dataset {}",
+                          counts[0], _path);
+
+        // Reset first such that a failed write is not attempted again, e.g.
+        // when the dataset is closed after an exception
+        _write_buffer.num_slices = 0;
+
+        _memspace.close();
+        _filespace.close();
+        _memspace.open();
+        _filespace.open();
+
+        // The row the buffered block starts at
+        hsize_t first_row = 0;
+
+        if (not is_valid())
+        {
+            // Choose the chunks as if a single slice was written, such that
+            // the layout does not depend on the number of buffered slices
+            const std::vector<hsize_t> slice_extent{1, counts[1]};
+            if (_chunksizes.size() != _rank and _capacity != slice_extent)
+            {
+                _chunksizes =
+                    calc_chunksize(sizeof(Value), slice_extent, _capacity);
+            }
+
+            _current_extent = counts;
+            __create_dataset__<Value>(0);
+        }
+        else
+        {
+            HDFType temp_type;
+            temp_type.open<Value>("testtype", 0);
+
+            if (temp_type != _type)
+            {
+                throw std::runtime_error("Error, cannot write buffered data "
+                                         "of a different type into dataset " +
+                                         _path);
+            }
+            if (_current_extent[1] != counts[1])
+            {
+                throw std::runtime_error(
+                    "Dataset " + _path + ": Cannot append buffered slices of "
+                    "size " + std::to_string(counts[1]) + " to a dataset of "
+                    "width " + std::to_string(_current_extent[1]));
+            }
+
+            std::vector<hsize_t> new_extent = _current_extent;
+            new_extent[0] += counts[0];
+
+            if (new_extent[0] > _capacity[0])
+            {
+                throw std::runtime_error("Dataset " + _path +
+                                         ": Cannot append buffered data, "
+                                         "new extent larger than capacity "
+                                         "in dimension 0");
+            }
+
+            herr_t err = H5Dset_extent(get_C_id(), new_extent.data());
+
+            if (err < 0)
+            {
+                throw std::runtime_error(
+                    "Dataset " + _path +
+                    ": Error when trying to increase extent");
+            }
+
+            _offset = {_current_extent[0], 0};
+            first_row = _current_extent[0];
+
+            _filespace.open(*this);
+            _memspace.open(_path + "memory dataspace", _rank, counts, {});
+            _filespace.select_slice(
+                _offset,
+                arma::Row<hsize_t>(_offset) + arma::Row<hsize_t>(counts), {});
+
+            _current_extent = new_extent;
+        }
+
+        if constexpr (std::is_floating_point_v<Value>)
+        {
+            if (_float_precision == FloatPrecision::bit_round)
+            {
+                round_mantissa(
+                    reinterpret_cast<Value *>(_write_buffer.data.data()),
+                    counts[0] * counts[1], _float_digits);
+            }
+        }
+
+        if (_direct_chunk_write and
+            __write_chunks_direct__<Value>(first_row, counts))
+        {
+            _write_buffer.data.clear();
+            __swmr_flush__();
+            return;
+        }
+
+        herr_t err =
+            H5Dwrite(get_C_id(), _type.get_C_id(), _memspace.get_C_id(),
+                     _filespace.get_C_id(), H5P_DEFAULT,
+                     _write_buffer.data.data());
+        _write_buffer.data.clear();
+
+        if (err < 0)
+        {
+            throw std::runtime_error("Dataset " + _path +
+                                     ": Error in writing buffered data");
+        }
+        __swmr_flush__();
+    }
+
+    /**
+     * @brief Writes a block of buffered rows by compressing the chunks it
+     * covers in parallel and passing them to HDF5 as they are
+     *
+     * @details Chunks that are covered completely by the block (or that are
+     *          the last chunks in a dataset of fixed size) are compressed
+     *          with zlib, using Utopia::ExecPolicy::par, and written with a
+     *          direct chunk write, bypassing the HDF5 filter pipeline. The
+     *          remaining rows at the beginning and end of the block only
+     *          cover parts of chunks and are written the regular way.
+     *
+     *          This is only possible if the dataset is chunked, uses no
+     *          filter except deflate, and stores the values with their
+     *          in-memory type; otherwise nothing is written.
+     *
+     * @tparam Value    The element type of the buffered rows
+     * @param first_row The row of the dataset the block starts at
+     * @param counts    The number of rows and columns of the block
+     *
+     * @return Whether the block was written
+     */
+    template <typename Value>
+    bool __write_chunks_direct__(const hsize_t first_row,
+                                 const std::vector<hsize_t> &counts)
+    {
+        // Chunk shape and filters are taken from the dataset itself
+        hid_t plist = H5Dget_create_plist(get_C_id());
+        std::vector<hsize_t> chunk(2, 0);
+        int level = -1;
+
+        // The values need to be stored as they are in memory
+        const hid_t file_type = H5Dget_type(get_C_id());
+        const bool same_type = (H5Tget_size(file_type) == sizeof(Value));
+        H5Tclose(file_type);
+
+        if (same_type and H5Pget_layout(plist) == H5D_CHUNKED and
+            H5Pget_chunk(plist, 2, chunk.data()) == 2)
+        {
+            const int num_filters = H5Pget_nfilters(plist);
+            if (num_filters == 0)
+            {
+                level = 0;
+            }
+            else if (num_filters == 1)
+            {
+                unsigned flags = 0;
+                std::size_t num_values = 1;
+                unsigned values[1] = {0};
+                const auto filter =
+                    H5Pget_filter2(plist, 0, &flags, &num_values, values, 0,
+                                   nullptr, nullptr);
+                if (filter == H5Z_FILTER_DEFLATE)
+                {
+                    level = values[0];
+                }
+            }
+        }
+        H5Pclose(plist);
+
+        if (level < 0)
+        {
+            this->_log->debug("Dataset {} does not support direct chunk "
+                              "writes; writing buffered data regularly.",
+                              _path);
+            return false;
+        }
+
+        const hsize_t width = counts[1];
+        const hsize_t last_row = first_row + counts[0];
+        const auto data =
+            reinterpret_cast<const Value *>(_write_buffer.data.data());
+
+        // Determine the rows that make up complete chunks
+        const hsize_t chunks_begin =
+            ((first_row + chunk[0] - 1) / chunk[0]) * chunk[0];
+        hsize_t chunks_end = (last_row / chunk[0]) * chunk[0];
+        if (last_row == _capacity[0])
+        {
+            chunks_end = last_row;
+        }
+
+        if (chunks_begin >= chunks_end)
+        {
+            __write_rows__(data, first_row, counts[0], width);
+            return true;
+        }
+
+        if (first_row < chunks_begin)
+        {
+            __write_rows__(data, first_row, chunks_begin - first_row, width);
+        }
+
+        // Compress the chunks in parallel ...
+        const hsize_t num_chunk_cols = (width + chunk[1] - 1) / chunk[1];
+        const hsize_t num_chunks =
+            ((chunks_end - chunks_begin + chunk[0] - 1) / chunk[0]) *
+            num_chunk_cols;
+        const std::size_t chunk_bytes = chunk[0] * chunk[1] * sizeof(Value);
+
+        std::vector<std::vector<unsigned char>> compressed(num_chunks);
+        std::vector<unsigned> filter_masks(num_chunks, 0);
+        std::vector<hsize_t> chunk_ids(num_chunks);
+        std::iota(chunk_ids.begin(), chunk_ids.end(), 0);
+
+        std::for_each(
+            ExecPolicy::par, chunk_ids.begin(), chunk_ids.end(),
+            [&](const hsize_t id) {
+                const hsize_t row = chunks_begin + (id / num_chunk_cols) *
+                                                       chunk[0];
+                const hsize_t col = (id % num_chunk_cols) * chunk[1];
+                const hsize_t num_rows = std::min(chunk[0], last_row - row);
+                const hsize_t num_cols = std::min(chunk[1], width - col);
+
+                // Gather the chunk; parts outside the extent stay zero
+                std::vector<Value> raw(chunk[0] * chunk[1], Value(0));
+                for (hsize_t i = 0; i < num_rows; ++i)
+                {
+                    const auto src =
+                        data + (row - first_row + i) * width + col;
+                    std::copy(src, src + num_cols, raw.begin() + i * chunk[1]);
+                }
+
+                auto &out = compressed[id];
+                const auto raw_bytes =
+                    reinterpret_cast<const unsigned char *>(raw.data());
+
+                if (level > 0)
+                {
+                    uLongf size = compressBound(chunk_bytes);
+                    out.resize(size);
+                    if (compress2(out.data(), &size, raw_bytes, chunk_bytes,
+                                  level) == Z_OK and
+                        size < chunk_bytes)
+                    {
+                        out.resize(size);
+                        return;
+                    }
+                    // Like the deflate filter, store incompressible chunks
+                    // as they are and mark the filter as skipped
+                    filter_masks[id] = 0x1;
+                }
+                out.assign(raw_bytes, raw_bytes + chunk_bytes);
+            });
+
+        // ... and write them sequentially, as HDF5 is not thread-safe
+        this->_log->debug("Writing {} compressed chunks to dataset {}",
+                          num_chunks, _path);
+
+        for (hsize_t id = 0; id < num_chunks; ++id)
+        {
+            const hsize_t offset[2] = {
+                chunks_begin + (id / num_chunk_cols) * chunk[0],
+                (id % num_chunk_cols) * chunk[1]};
+
+            const herr_t err = H5Dwrite_chunk(
+                get_C_id(), H5P_DEFAULT, filter_masks[id], offset,
+                compressed[id].size(), compressed[id].data());
+            if (err < 0)
+            {
+                throw std::runtime_error("Dataset " + _path +
+                                         ": Error in writing chunk directly");
+            }
+        }
+
+        if (chunks_end < last_row)
+        {
+            __write_rows__(data + (chunks_end - first_row) * width,
+                           chunks_end, last_row - chunks_end, width);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Writes consecutive rows of a two-dimensional dataset
+     *
+     * @param data     Pointer to the rows, stored contiguously
+     * @param row      The first row to write to
+     * @param num_rows The number of rows
+     * @param width    The number of elements per row
+     */
+    template <typename Value>
+    void __write_rows__(const Value *data, const hsize_t row,
+                        const hsize_t num_rows, const hsize_t width)
+    {
+        HDFDataspace memspace(_path + " memory dataspace", 2,
+                              {num_rows, width}, {});
+        HDFDataspace filespace(*this);
+        filespace.select_slice({row, 0}, {row + num_rows, width}, {});
+
+        herr_t err = H5Dwrite(get_C_id(), _type.get_C_id(),
+                              memspace.get_C_id(), filespace.get_C_id(),
+                              H5P_DEFAULT, data);
+
+        if (err < 0)
+        {
+            throw std::runtime_error("Dataset " + _path +
+                                     ": Error in writing buffered rows");
+        }
+    }
+
     /// write out the attribute buffer
     void __write_attribute_buffer__()
     {
@@ -760,6 +1158,19 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
         _attribute_buffer.clear();
     }
 
+    /**
+     * @brief Makes written data visible to readers if the file is in
+     * single-writer/multiple-reader (SWMR) mode
+     */
+    void __swmr_flush__()
+    {
+        if (_swmr and H5Dflush(get_C_id()) < 0)
+        {
+            throw std::runtime_error("Dataset " + _path +
+                                     ": Error when flushing in SWMR mode");
+        }
+    }
+
     /**
      *  @brief Identifier of the parent object
      */
@@ -832,6 +1243,67 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
      */
     HDFDataspace _memspace;
 
+    /**
+     * @brief Buffer for accumulating time slices before writing them
+     *
+     * @details Copying the buffer only copies its capacity, not the buffered
+     *          slices; these are written out by the object buffering them.
+     */
+    struct WriteBuffer
+    {
+        /// The number of slices to accumulate; below two disables buffering
+        std::size_t capacity = 1;
+
+        /// The raw bytes of the buffered slices
+        std::vector<char> data = {};
+
+        /// The number of currently buffered slices
+        hsize_t num_slices = 0;
+
+        /// The number of elements per slice
+        hsize_t slice_size = 0;
+
+        /// Writes out the buffer; depends on the buffered element type
+        void (HDFDataset::*flush_func)() = nullptr;
+
+        WriteBuffer() = default;
+        WriteBuffer(const WriteBuffer &other) : capacity(other.capacity) {}
+        WriteBuffer(WriteBuffer &&other) = default;
+        WriteBuffer &operator=(WriteBuffer &&other) = default;
+        WriteBuffer &operator=(const WriteBuffer &other)
+        {
+            *this = WriteBuffer(other);
+            return *this;
+        }
+    };
+
+    /**
+     * @brief The buffer for temporal write batching
+     */
+    WriteBuffer _write_buffer;
+
+    /**
+     * @brief Whether buffered rows are compressed in parallel and written
+     * with direct chunk writes
+     */
+    bool _direct_chunk_write = false;
+
+    /**
+     * @brief Whether the file is known to be in SWMR writing mode, in which
+     * case data is flushed after each write
+     */
+    bool _swmr = false;
+
+    /**
+     * @brief How the precision of floating-point values is reduced
+     */
+    FloatPrecision _float_precision = FloatPrecision::full;
+
+    /**
+     * @brief The number of digits retained when reducing the precision
+     */
+    unsigned int _float_digits = 0;
+
   public:
     /**
      * @brief Base class alias
@@ -958,14 +1430,144 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
         _chunksizes = chunksizes;
     }
 
+    /**
+     * @brief Accumulate the given number of time slices in memory before
+     * writing them to the dataset as one contiguous block
+     *
+     * @details This reduces the per-call overhead of HDF5 for datasets that
+     *          are written to often, e.g. once per time step. It applies to
+     *          two-dimensional datasets that are appended to with containers
+     *          of arithmetic type, one row (time slice) per write call; all
+     *          other writes are passed on directly, after writing out the
+     *          buffered slices. For the block writes to be aligned with the
+     *          chunks, choose a multiple of the chunk size in dimension 0.
+     *
+     *          The buffer is written out when full, on flush, and when the
+     *          dataset is closed, re-opened or destroyed. Until then, the
+     *          buffered slices are neither in the file nor reflected in the
+     *          current extent.
+     *
+     * @param num_slices The number of slices to buffer; 0 or 1 disables
+     *                   buffering
+     */
+    void set_write_buffer_size(std::size_t num_slices)
+    {
+        flush();
+        _write_buffer.capacity = num_slices;
+    }
+
+    /**
+     * @brief Get the number of time slices accumulated before writing
+     */
+    std::size_t get_write_buffer_size() { return _write_buffer.capacity; }
+
+    /**
+     * @brief Get the number of time slices currently held in the buffer
+     */
+    std::size_t get_num_buffered_slices() { return _write_buffer.num_slices; }
+
+    /**
+     * @brief Compress the buffered time slices on multiple threads and write
+     * them chunk by chunk, bypassing the HDF5 filter pipeline
+     *
+     * @details Usually, compression happens single-threaded within H5Dwrite.
+     *          With this mode enabled, all chunks fully covered by the
+     *          buffered slices are compressed in parallel (see
+     *          Utopia::ParallelExecution) and passed to H5Dwrite_chunk; the
+     *          remaining rows are written the regular way. The resulting
+     *          file is a regular deflate-compressed HDF5 file.
+     *
+     *          Enabling this also routes single slices through the write
+     *          buffer, i.e. a buffer size of 1 suffices if the chunks span a
+     *          single slice in dimension 0. It has no effect for datasets
+     *          that are not chunked or use other filters than deflate.
+     */
+    void set_direct_chunk_write(bool enabled)
+    {
+        flush();
+        _direct_chunk_write = enabled;
+    }
+
+    /**
+     * @brief Get whether buffered slices are written as compressed chunks
+     */
+    bool get_direct_chunk_write() { return _direct_chunk_write; }
+
+    /**
+     * @brief Set whether written data is flushed right away, such that
+     * readers of a file in single-writer/multiple-reader (SWMR) mode see it
+     *
+     * @details This is determined when opening the dataset. For datasets
+     *          that were opened before their file was switched to SWMR mode
+     *          (see start_swmr_write), it needs to be enabled here.
+     */
+    void set_swmr_flush(bool enabled) { _swmr = enabled; }
+
+    /**
+     * @brief Get whether written data is flushed for SWMR readers
+     */
+    bool get_swmr_flush() { return _swmr; }
+
+    /**
+     * @brief Reduce the precision floating-point values are stored with
+     *
+     * @details Analysis rarely needs all digits of a double, while the
+     *          trailing digits take up most of the space after compression.
+     *          The modes are (see FloatPrecision):
+     *            - `single`: store doubles as float32. Note that the data
+     *              then needs to be read as float.
+     *            - `scale_offset`: quantize with the HDF5 scale-offset filter,
+     *              retaining `digits` decimal digits after the decimal point.
+     *              This requires chunking, which is enabled if necessary.
+     *            - `bit_round`: round to `digits` significant decimal digits
+     *              before compressing, see round_mantissa. Slices written to
+     *              two-dimensional datasets are rounded in the write buffer,
+     *              containers and scalars written to one-dimensional ones are
+     *              rounded in a copy. Pointer data is written unchanged.
+     *
+     *          The first two modes need to be set before the dataset is
+     *          created. Non-floating-point data is not affected.
+     *
+     * @param mode   How to reduce the precision
+     * @param digits The number of digits to retain, depending on the mode
+     */
+    void set_float_precision(FloatPrecision mode, unsigned int digits = 0)
+    {
+        flush();
+        _float_precision = mode;
+        _float_digits = digits;
+    }
+
+    /**
+     * @brief Get how the precision of floating-point values is reduced
+     */
+    FloatPrecision get_float_precision() { return _float_precision; }
+
+    /**
+     * @brief Get the number of digits retained when reducing the precision
+     */
+    unsigned int get_float_digits() { return _float_digits; }
+
+    /**
+     * @brief Write out all buffered time slices, if any
+     */
+    void flush()
+    {
+        if (_write_buffer.num_slices > 0)
+        {
+            (this->*_write_buffer.flush_func)();
+        }
+    }
+
     /**
      * @brief      add attribute to the dataset
      *
      * @details     If the dataset is not opened already, the attribute is
-     *             stored in the _attribute_buffer and written on close.
+     *             stored in the _attribute_buffer and written when the
+     *             dataset is created on disk or on close.
      *
      * @note       Attributes stored when the dataset was not yet opened will
-     *             only become available after the dataset was closed.
+     *             only become available after the dataset was created.
      *
      * @param      attribute_path  The attribute path
      * @param      data  The attribute data
@@ -1032,6 +1634,9 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
     {
         auto log = spdlog::get("data_io");
 
+        // write out buffered slices while the dataset is still open
+        flush();
+
         // write the attributebuffer out
         if (is_valid())
         {
@@ -1097,9 +1702,22 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
             throw std::runtime_error("parent id not valid for dataset " + path);
         }
 
-        _parent_identifier = parent_identifier;
+        // buffered slices belong to the previously opened dataset
+        flush();
+
+        // Hold an own identifier of the parent rather than sharing it, such
+        // that each object is referenced only once, as is required for
+        // switching the file to SWMR writing mode, see start_swmr_write
+        const hid_t parent_id =
+            H5Oopen(parent_identifier.get_id(), ".", H5P_DEFAULT);
+        _parent_identifier.close();
+        _parent_identifier.open(parent_id, &H5Oclose);
         _path = path;
 
+        // Files switched to SWMR mode later on need to tell their datasets,
+        // see set_swmr_flush
+        _swmr = is_swmr_write(_parent_identifier.get_id());
+
         _filespace.close();
         _memspace.close();
         // open with H5S_ALL
@@ -1214,6 +1832,11 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
         swap(_filespace, other._filespace);
         swap(_memspace, other._memspace);
         swap(_type, other._type);
+        swap(_write_buffer, other._write_buffer);
+        swap(_direct_chunk_write, other._direct_chunk_write);
+        swap(_swmr, other._swmr);
+        swap(_float_precision, other._float_precision);
+        swap(_float_digits, other._float_digits);
     }
 
     /**
@@ -1232,6 +1855,32 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
         this->_log->debug("... capacity {}", Utils::str(_capacity));
         this->_log->debug("... refcount {}", get_refcount());
 
+        // temporal write batching: buffer rows of arithmetic values
+        if constexpr (Utils::is_container_v<std::decay_t<T>>)
+        {
+            using Value = Utils::remove_qualifier_t<
+                typename std::decay_t<T>::value_type>;
+
+            if constexpr (std::is_arithmetic_v<Value> and
+                          not std::is_same_v<Value, bool>)
+            {
+                const bool bit_round =
+                    std::is_floating_point_v<Value> and
+                    _float_precision == FloatPrecision::bit_round;
+
+                if ((_write_buffer.capacity > 1 or _direct_chunk_write or
+                     bit_round) and
+                    _rank == 2)
+                {
+                    __buffer_slice__<Value>(data);
+                    return;
+                }
+            }
+        }
+
+        // keep the order of writes: buffered slices go first
+        flush();
+
         // dataset does not yet exist
         _memspace.close();
         _filespace.close();
@@ -1477,8 +2126,32 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
         // everything is prepared, we can write the data
         if constexpr (Utils::is_container_v<std::decay_t<T>>)
         {
+            using Value = Utils::remove_qualifier_t<
+                typename std::decay_t<T>::value_type>;
+
+            herr_t err = 0;
 
-            herr_t err = __write_container__(std::forward<T>(data));
+            // rows of two-dimensional datasets were rounded in the write
+            // buffer; round a copy of the data for one-dimensional ones
+            if constexpr (std::is_floating_point_v<Value>)
+            {
+                if (_float_precision == FloatPrecision::bit_round)
+                {
+                    std::vector<Value> rounded(std::begin(data),
+                                               std::end(data));
+                    round_mantissa(rounded.data(), rounded.size(),
+                                   _float_digits);
+                    err = __write_container__(std::move(rounded));
+                }
+                else
+                {
+                    err = __write_container__(std::forward<T>(data));
+                }
+            }
+            else
+            {
+                err = __write_container__(std::forward<T>(data));
+            }
 
             if (err < 0)
             {
@@ -1507,13 +2180,33 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
         }
         else
         {
-            herr_t err = __write_scalartype__(std::forward<T>(data));
+            herr_t err = 0;
+
+            if constexpr (std::is_floating_point_v<std::decay_t<T>>)
+            {
+                if (_float_precision == FloatPrecision::bit_round)
+                {
+                    std::decay_t<T> rounded = data;
+                    round_mantissa(&rounded, 1, _float_digits);
+                    err = __write_scalartype__(rounded);
+                }
+                else
+                {
+                    err = __write_scalartype__(std::forward<T>(data));
+                }
+            }
+            else
+            {
+                err = __write_scalartype__(std::forward<T>(data));
+            }
             if (err < 0)
             {
                 throw std::runtime_error("Dataset " + _path +
                                          ": Error in appending scalar");
             }
         }
+
+        __swmr_flush__();
     }
 
     /**
@@ -1579,6 +2272,9 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
         this->_log->debug("... current offset {}", Utils::str(_offset));
         this->_log->debug("... capacity {}", Utils::str(_capacity));
 
+        // keep the order of writes: buffered slices go first
+        flush();
+
         _filespace.close();
         _memspace.close();
 
@@ -2018,6 +2714,8 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
                 }
             }
         }
+
+        __swmr_flush__();
     }
 
     /**
@@ -2202,7 +2900,14 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
      *
      * @return     HDFDataset&
      */
-    HDFDataset &operator=(const HDFDataset &other) = default;
+    HDFDataset &operator=(const HDFDataset &other)
+    {
+        // buffered slices belong to the dataset that is being replaced
+        flush();
+        HDFDataset tmp(other);
+        swap(tmp);
+        return *this;
+    }
 
     /**
      * @brief Move assignment operator
@@ -2210,7 +2915,13 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
      * @param other
      * @return HDFDataset&
      */
-    HDFDataset &operator=(HDFDataset &&other) = default;
+    HDFDataset &operator=(HDFDataset &&other)
+    {
+        // buffered slices belong to the dataset that is being replaced
+        flush();
+        swap(other);
+        return *this;
+    }
 
     /**
      * @brief Construct a new HDFDataset object
@@ -2239,7 +2950,20 @@ class HDFDataset final : public HDFObject<HDFCategory::dataset>
     /**
      * @brief      Destructor
      */
-    virtual ~HDFDataset() { close(); }
+    virtual ~HDFDataset()
+    {
+        // errors cannot be propagated out of the destructor; report them
+        try
+        {
+            flush();
+        }
+        catch (std::exception &e)
+        {
+            this->_log->error("Failed writing buffered data of dataset {}: {}",
+                              _path, e.what());
+        }
+        close();
+    }
 }; // end of HDFDataset class
 
 /**
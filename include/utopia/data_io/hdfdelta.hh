@@ -0,0 +1,350 @@
+/**
+ * @brief This file provides a writer that stores a sequence of frames, e.g.
+ *        the states of all cells of a grid, as keyframes and changes in
+ *        between, as well as a function reconstructing a frame.
+ * @file hdfdelta.hh
+ */
+#ifndef UTOPIA_DATAIO_HDFDELTA_HH
+#define UTOPIA_DATAIO_HDFDELTA_HH
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <hdf5.h>
+
+#include "hdfattribute.hh"
+#include "hdfdataset.hh"
+#include "hdfgroup.hh"
+#include "hdfutilities.hh"
+
+namespace Utopia
+{
+namespace DataIO
+{
+/*!
+ * \addtogroup DataIO
+ * \{
+ */
+
+/*!
+ * \addtogroup HDF5
+ * \{
+ */
+
+/**
+ * @brief Writes frames of a fixed number of entries by only storing the
+ *        entries that changed since the previous frame
+ *
+ * @details The first frame and every `keyframe_interval`-th frame after it
+ *          are stored completely as keyframes; for the frames in between,
+ *          only the ids and new values of the entries that changed are
+ *          stored. If only few entries change from one frame to the next, as
+ *          is typical for grid models in low-activity regimes, this takes a
+ *          fraction of the space needed to store every frame.
+ *
+ *          The layout follows that of GraphDeltaWriter. For a writer named
+ *          `<name>`, the data is stored in the parent group as follows:
+ *            - `<name>/<time>`: the keyframes, each of shape (entries,)
+ *            - `<name>_delta/keyframe_times`: the times of the keyframes
+ *            - `<name>_delta/time`: the time of each delta record
+ *            - `<name>_delta/num_changes`: the number of changes of each
+ *              delta record
+ *            - `<name>_delta/change_ids`, `<name>_delta/change_values`: the
+ *              ids and new values of the changed entries, concatenated over
+ *              all delta records
+ *
+ *          Datasets are only created once they are written to. Use
+ *          load_delta_frame to reconstruct the frame at a given time.
+ *
+ * @note    As keyframe datasets are created on demand, this cannot be used
+ *          for output in SWMR mode.
+ *
+ * @tparam T The type of the values; needs to be comparable
+ */
+template < typename T >
+class DeltaWriter
+{
+  public:
+    /// The type of the entry ids
+    using IdType = std::size_t;
+
+  private:
+    /// The group holding the keyframe datasets
+    std::shared_ptr< HDFGroup > _keyframe_grp;
+
+    /// The group holding the delta datasets
+    std::shared_ptr< HDFGroup > _delta_grp;
+
+    /// The number of entries of each frame
+    std::size_t _num_entries;
+
+    /// After how many frames a keyframe is stored; 0: only the first one
+    std::size_t _keyframe_interval;
+
+    /// The number of frames written so far
+    std::size_t _num_frames;
+
+    /// The total number of changes written so far
+    std::size_t _num_changes;
+
+    /// The previous frame, which changes are determined against
+    std::vector< T > _last;
+
+    /// Buffers for the ids and values of changed entries
+    std::vector< IdType > _changed_ids;
+    std::vector< T >      _changed_values;
+
+    /// Datasets of the delta group
+    std::shared_ptr< HDFDataset > _dset_keyframe_times;
+    std::shared_ptr< HDFDataset > _dset_time;
+    std::shared_ptr< HDFDataset > _dset_num_changes;
+    std::shared_ptr< HDFDataset > _dset_change_ids;
+    std::shared_ptr< HDFDataset > _dset_change_values;
+
+    /// The compression level of the datasets
+    std::size_t _compress_level;
+
+  public:
+    /**
+     * @brief Write a frame
+     *
+     * @param frame The values of all entries
+     * @param time  The time (or other label) to associate with the frame
+     */
+    void
+    write(const std::vector< T >& frame, const std::size_t time)
+    {
+        if (frame.size() != _num_entries)
+        {
+            throw std::invalid_argument(
+                "Cannot write a frame of size " + std::to_string(frame.size()) +
+                " to the delta-encoded data in " + _delta_grp->get_path() +
+                ", which expects frames of size " +
+                std::to_string(_num_entries) + "!");
+        }
+
+        if (_num_frames == 0 or
+            (_keyframe_interval > 0 and _num_frames % _keyframe_interval == 0))
+        {
+            _last = frame;
+            _keyframe_grp
+                ->open_dataset(
+                    std::to_string(time), { _num_entries }, {}, _compress_level)
+                ->write(_last);
+            _dset_keyframe_times->write(time);
+        }
+        else
+        {
+            _changed_ids.clear();
+            _changed_values.clear();
+
+            for (IdType i = 0; i < _num_entries; ++i)
+            {
+                if (not(frame[i] == _last[i]))
+                {
+                    _changed_ids.push_back(i);
+                    _changed_values.push_back(frame[i]);
+                }
+            }
+
+            _dset_time->write(time);
+            _dset_num_changes->write(IdType(_changed_ids.size()));
+
+            // Empty records need not be written to the change datasets
+            if (not _changed_ids.empty())
+            {
+                _dset_change_ids->write(_changed_ids);
+                _dset_change_values->write(_changed_values);
+            }
+            _num_changes += _changed_ids.size();
+
+            for (std::size_t c = 0; c < _changed_ids.size(); ++c)
+            {
+                _last[_changed_ids[c]] = _changed_values[c];
+            }
+        }
+
+        ++_num_frames;
+    }
+
+    /**
+     * @brief Write a frame from an iterator range, in accordance with
+     *        HDFDataset::write
+     *
+     * @param begin   Start of the range
+     * @param end     End of the range
+     * @param adaptor Function returning the value to store for an element
+     * @param time    The time (or other label) to associate with the frame
+     */
+    template < typename Iter, typename Adaptor >
+    void
+    write(Iter begin, Iter end, Adaptor&& adaptor, const std::size_t time)
+    {
+        std::vector< T > frame;
+        frame.reserve(_num_entries);
+        std::transform(begin, end, std::back_inserter(frame), adaptor);
+        write(frame, time);
+    }
+
+    /// The group holding the keyframe datasets
+    std::shared_ptr< HDFGroup >
+    get_keyframe_group() const
+    {
+        return _keyframe_grp;
+    }
+
+    /// The group holding the delta datasets
+    std::shared_ptr< HDFGroup >
+    get_delta_group() const
+    {
+        return _delta_grp;
+    }
+
+    /// The number of frames written so far
+    std::size_t
+    get_num_frames() const
+    {
+        return _num_frames;
+    }
+
+    /// The total number of changes written so far
+    std::size_t
+    get_num_changes() const
+    {
+        return _num_changes;
+    }
+
+    /// After how many frames a keyframe is stored; 0: only the first one
+    std::size_t
+    get_keyframe_interval() const
+    {
+        return _keyframe_interval;
+    }
+
+    /**
+     * @brief Construct a DeltaWriter
+     *
+     * @param parent            The group to create the data groups in
+     * @param name              The name of the keyframe group; the delta
+     *                          group is named `<name>_delta`
+     * @param num_entries       The number of entries of each frame
+     * @param keyframe_interval After how many frames a keyframe is stored;
+     *                          if 0, only the first frame is a keyframe, if
+     *                          1, all frames are stored completely
+     * @param compress_level    The compression level of the datasets
+     */
+    DeltaWriter(HDFGroup&          parent,
+                const std::string& name,
+                std::size_t        num_entries,
+                std::size_t        keyframe_interval,
+                std::size_t        compress_level = 1)
+        : _keyframe_grp(parent.open_group(name)),
+          _delta_grp(parent.open_group(name + "_delta")),
+          _num_entries(num_entries),
+          _keyframe_interval(keyframe_interval),
+          _num_frames(0),
+          _num_changes(0),
+          _last{},
+          _changed_ids{},
+          _changed_values{},
+          _dset_keyframe_times(_delta_grp->open_dataset("keyframe_times")),
+          _dset_time(_delta_grp->open_dataset("time")),
+          _dset_num_changes(_delta_grp->open_dataset("num_changes")),
+          _dset_change_ids(_delta_grp->open_dataset(
+              "change_ids", { H5S_UNLIMITED }, {}, compress_level)),
+          _dset_change_values(_delta_grp->open_dataset(
+              "change_values", { H5S_UNLIMITED }, {}, compress_level)),
+          _compress_level(compress_level)
+    {
+        _delta_grp->add_attribute("content", "delta");
+        _delta_grp->add_attribute("keyframe_interval", _keyframe_interval);
+        _delta_grp->add_attribute("num_entries", _num_entries);
+    }
+};
+
+/**
+ * @brief Reconstruct the frame written by a DeltaWriter at a given time
+ *
+ * @details Reads the latest keyframe written at or before the given time
+ *          and applies all subsequent delta records up to and including
+ *          the given time, like load_graph_delta_edges. If no frame was
+ *          written at exactly that time, the latest frame before it is
+ *          returned.
+ *
+ * @tparam T The type of the values
+ * @param parent The group the DeltaWriter created its groups in
+ * @param name   The name the DeltaWriter was created with
+ * @param time   The time at which to reconstruct the frame
+ * @return std::vector< T > The values of all entries
+ */
+template < typename T >
+std::vector< T >
+load_delta_frame(const std::shared_ptr< HDFGroup >& parent,
+                 const std::string&                 name,
+                 const std::size_t                  time)
+{
+    using IdType = typename DeltaWriter< T >::IdType;
+
+    const auto keyframe_grp = parent->open_group(name);
+    const auto delta_grp    = parent->open_group(name + "_delta");
+
+    // Reads a 1D dataset, returning an empty vector if it was never written
+    auto read_1d = [&delta_grp](const std::string& dset_name, auto tag) {
+        using V         = decltype(tag);
+        const auto dset = delta_grp->open_dataset(dset_name);
+        if (not dset->is_valid())
+        {
+            return std::vector< V >{};
+        }
+        return std::get< 1 >(dset->template read< std::vector< V > >());
+    };
+
+    // Find the latest keyframe at or before the given time
+    const auto keyframe_times = read_1d("keyframe_times", std::size_t{});
+    const auto kf =
+        std::upper_bound(keyframe_times.begin(), keyframe_times.end(), time);
+    if (kf == keyframe_times.begin())
+    {
+        throw std::invalid_argument("No keyframe of " + name +
+                                    " was written at or before time " +
+                                    std::to_string(time) + "!");
+    }
+    const auto keyframe_time = *std::prev(kf);
+
+    auto frame = std::get< 1 >(
+        keyframe_grp->open_dataset(std::to_string(keyframe_time))
+            ->template read< std::vector< T > >());
+
+    // Apply all records after the keyframe up to the given time
+    const auto times = read_1d("time", std::size_t{});
+    const auto num_changes = read_1d("num_changes", IdType{});
+    const auto change_ids = read_1d("change_ids", IdType{});
+    const auto change_values = read_1d("change_values", T{});
+
+    std::size_t offset = 0;
+    for (std::size_t r = 0; r < times.size() and times[r] <= time; ++r)
+    {
+        if (times[r] > keyframe_time)
+        {
+            for (IdType c = offset; c < offset + num_changes[r]; ++c)
+            {
+                frame[change_ids[c]] = change_values[c];
+            }
+        }
+        offset += num_changes[r];
+    }
+
+    return frame;
+}
+
+/*! \} */ // end of group HDF5
+/*! \} */ // end of group DataIO
+
+} // namespace DataIO
+} // namespace Utopia
+
+#endif // UTOPIA_DATAIO_HDFDELTA_HH
@@ -92,9 +92,15 @@ class HDFFile final : public HDFObject< HDFCategory::file >
      *                     file must exist), 'w' (create file, truncate if
      *                     exists), 'x' (create file, fail if exists), or 'a'
      *                     (read/write if exists, create otherwise)
+     * @param      swmr    Whether to support single-writer/multiple-reader
+     *                     access. For writing, this uses the latest file
+     *                     format and the default (POSIX) driver; call
+     *                     start_swmr_write once all objects are created. For
+     *                     reading, this allows to read a file that is being
+     *                     written to in SWMR mode.
      */
     void
-    open(std::string path, std::string access)
+    open(std::string path, std::string access, bool swmr = false)
     {
         this->_log->info(
             "Opening file at {} with access specifier {}", path, access);
@@ -109,8 +115,15 @@ class HDFFile final : public HDFObject< HDFCategory::file >
         hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
 
         // set driver to stdio and close strongly, i.e., close all resources
-        // with the file
-        H5Pset_fapl_stdio(fapl);
+        // with the file. SWMR requires the default driver and latest format.
+        if (swmr)
+        {
+            H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+        }
+        else
+        {
+            H5Pset_fapl_stdio(fapl);
+        }
         H5Pset_fclose_degree(fapl, H5F_CLOSE_STRONG);
 
         if (access == "w")
@@ -121,8 +134,9 @@ class HDFFile final : public HDFObject< HDFCategory::file >
         }
         else if (access == "r")
         {
-            bind_to(
-                H5Fopen(path.c_str(), H5F_ACC_RDONLY, fapl), &H5Fclose, path);
+            const unsigned flags =
+                swmr ? (H5F_ACC_RDONLY | H5F_ACC_SWMR_READ) : H5F_ACC_RDONLY;
+            bind_to(H5Fopen(path.c_str(), flags, fapl), &H5Fclose, path);
         }
         else if (access == "r+")
         {
@@ -223,6 +237,32 @@ class HDFFile final : public HDFObject< HDFCategory::file >
         _base_group->delete_group(std::forward< std::string&& >(path));
     }
 
+    /**
+     * @brief      Switch to single-writer/multiple-reader (SWMR) mode
+     *
+     * @details    Requires the file to be opened with SWMR support. After
+     *             this, no new groups, datasets, or attributes can be
+     *             created, but datasets can be written to and extended.
+     *             Datasets flush their data after each write, such that it
+     *             becomes visible to readers; buffering time slices (see
+     *             HDFDataset::set_write_buffer_size) reduces the number of
+     *             these flushes.
+     */
+    void
+    start_swmr_write()
+    {
+        DataIO::start_swmr_write(get_C_id());
+    }
+
+    /**
+     * @brief      Whether the file is in SWMR writing mode
+     */
+    bool
+    is_swmr_write()
+    {
+        return DataIO::is_swmr_write(get_C_id());
+    }
+
     /**
      * @brief      Initiates an immediate write to disk of the data of the file
      */
@@ -285,13 +325,16 @@ class HDFFile final : public HDFObject< HDFCategory::file >
      *                     file must exist), 'w' (create file, truncate if
      *                     exists), 'x' (create file, fail if exists), or 'a'
      *                     (read/write if exists, create otherwise)
+     * @param      swmr    Whether to support single-writer/multiple-reader
+     *                     access, see open
      */
-    HDFFile(std::string path, std::string access) : HDFFile()
+    HDFFile(std::string path, std::string access, bool swmr = false)
+        : HDFFile()
     {
         // init the logger here because it is needed throughout the module
         // and its existence is not guaranteed when it is initialized in `core`
         _log = init_logger(log_data_io, spdlog::level::warn, false);
-        open(path, access);
+        open(path, access, swmr);
     }
 
     /**
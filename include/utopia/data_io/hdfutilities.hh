@@ -10,7 +10,11 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -275,6 +279,178 @@ open_type(Object&& object)
     }
 }
 
+/**
+ * @brief Switch the file an HDF5 object resides in to SWMR writing mode
+ *
+ * @details In single-writer/multiple-reader (SWMR) mode, other processes can
+ *          read the file while it is being written to. The file needs to
+ *          have been created with the latest file format, see HDFFile::open.
+ *          Afterwards, no new objects, i.e. groups, datasets, or attributes,
+ *          can be created in the file; datasets can still be written to and
+ *          extended.
+ *          Each open object of the file may only be referenced by a single
+ *          identifier when switching; HDFDataset holds its own identifier of
+ *          its parent object for that reason. Datasets opened beforehand
+ *          need to be told to flush after writing, see
+ *          HDFDataset::set_swmr_flush.
+ *
+ * @param id Identifier of the file or any object within it
+ */
+inline void
+start_swmr_write(hid_t id)
+{
+    const hid_t file = H5Iget_file_id(id);
+    H5Fflush(file, H5F_SCOPE_GLOBAL);
+
+    // Switching reopens all open objects of the file under their
+    // identifiers, which requires each of them to be referenced only once.
+    // Check this beforehand to report the offending object.
+    const unsigned types = H5F_OBJ_DATASET | H5F_OBJ_GROUP | H5F_OBJ_DATATYPE;
+    std::vector< hid_t > objects(H5Fget_obj_count(file, types));
+    H5Fget_obj_ids(file, types, objects.size(), objects.data());
+
+    for (const auto object : objects)
+    {
+        if (H5Iget_ref(object) > 1)
+        {
+            std::string name(H5Iget_name(object, nullptr, 0), '\0');
+            H5Iget_name(object, name.data(), name.size() + 1);
+            H5Fclose(file);
+
+            throw std::runtime_error(
+                "Could not switch file to SWMR writing mode! Object '" + name +
+                "' is referenced by more than one identifier; make sure "
+                "HDF5 objects are shared via pointers rather than copied.");
+        }
+    }
+
+    const herr_t err = H5Fstart_swmr_write(file);
+    H5Fclose(file);
+
+    if (err < 0)
+    {
+        throw std::runtime_error(
+            "Could not switch file to SWMR writing mode! Make sure it was "
+            "opened with SWMR support and all objects were created.");
+    }
+}
+
+/**
+ * @brief Whether the file an HDF5 object resides in is in SWMR writing mode
+ *
+ * @param id Identifier of the file or any object within it
+ */
+inline bool
+is_swmr_write(hid_t id)
+{
+    const hid_t file = H5Iget_file_id(id);
+    unsigned intent = 0;
+    H5Fget_intent(file, &intent);
+    H5Fclose(file);
+    return intent & H5F_ACC_SWMR_WRITE;
+}
+
+/**
+ * @brief How the precision of floating-point values is reduced when writing
+ *        them to a dataset
+ */
+enum class FloatPrecision
+{
+    /// Store the values as they are
+    full,
+
+    /// Store double precision values as single precision (float32)
+    single,
+
+    /// Quantize the values with the HDF5 scale-offset filter, retaining the
+    /// given number of decimal digits after the decimal point
+    scale_offset,
+
+    /// Round the mantissa to the given number of significant decimal digits,
+    /// such that the trailing bits are zero and compress well
+    bit_round
+};
+
+/**
+ * @brief Get the FloatPrecision mode of the given name
+ *
+ * @param mode One of `full`, `float32`, `scale_offset`, or `bit_round`
+ */
+inline FloatPrecision
+float_precision_from_string(const std::string& mode)
+{
+    if (mode == "full")
+    {
+        return FloatPrecision::full;
+    }
+    else if (mode == "float32")
+    {
+        return FloatPrecision::single;
+    }
+    else if (mode == "scale_offset")
+    {
+        return FloatPrecision::scale_offset;
+    }
+    else if (mode == "bit_round")
+    {
+        return FloatPrecision::bit_round;
+    }
+    throw std::invalid_argument("Invalid floating-point precision mode '" +
+                                mode +
+                                "'! Available modes: full, float32, "
+                                "scale_offset, bit_round.");
+}
+
+/**
+ * @brief Round floating-point values to a number of significant digits by
+ *        setting the trailing bits of their mantissa to zero
+ *
+ * @details The values are rounded to nearest (ties to even) in binary,
+ *          keeping enough mantissa bits to represent the given number of
+ *          significant decimal digits. Compared to the full values, the
+ *          rounded ones compress a lot better. Non-finite values are left
+ *          unchanged.
+ *
+ * @tparam Value A floating-point type
+ * @param data   Pointer to the values
+ * @param size   The number of values
+ * @param digits The number of significant decimal digits to retain
+ */
+template < typename Value >
+void
+round_mantissa(Value* data, std::size_t size, unsigned int digits)
+{
+    static_assert(std::is_floating_point_v< Value > and
+                      (sizeof(Value) == 4 or sizeof(Value) == 8),
+                  "Can only round the mantissa of float or double values!");
+    using Bits = std::conditional_t< sizeof(Value) == 8, std::uint64_t,
+                                     std::uint32_t >;
+
+    const int mantissa_bits = std::numeric_limits< Value >::digits - 1;
+    const int keep_bits = std::ceil(digits * std::log2(10.));
+    if (keep_bits >= mantissa_bits)
+    {
+        return;
+    }
+
+    const int  drop = mantissa_bits - keep_bits;
+    const Bits half = (Bits(1) << (drop - 1)) - 1;
+    const Bits mask = ~((Bits(1) << drop) - 1);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (not std::isfinite(data[i]))
+        {
+            continue;
+        }
+        Bits bits;
+        std::memcpy(&bits, &data[i], sizeof(Value));
+        bits += half + ((bits >> drop) & 1);
+        bits &= mask;
+        std::memcpy(&data[i], &bits, sizeof(Value));
+    }
+}
+
 /*! \} */ // end of group HDF5
 /*! \} */ // end of group DataIO
 
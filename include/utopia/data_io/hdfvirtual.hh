@@ -0,0 +1,351 @@
+/**
+ * @brief This file provides functions for distributing output over several
+ *        HDF5 files (shards) and exposing it in a single file via virtual
+ *        datasets.
+ * @file hdfvirtual.hh
+ */
+#ifndef UTOPIA_DATAIO_HDFVIRTUAL_HH
+#define UTOPIA_DATAIO_HDFVIRTUAL_HH
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <hdf5.h>
+
+#include "hdfgroup.hh"
+
+namespace Utopia
+{
+namespace DataIO
+{
+/*!
+ * \addtogroup DataIO
+ * \{
+ */
+
+/*!
+ * \addtogroup HDF5
+ * \{
+ */
+
+/**
+ * @brief Get the absolute path of an HDF5 object within its file
+ *
+ * @param id Identifier of the object
+ * @return std::string The absolute path, e.g. `/group/dataset`
+ */
+inline std::string
+get_object_path(hid_t id)
+{
+    std::string path(H5Iget_name(id, nullptr, 0) + 1, '\0');
+    H5Iget_name(id, path.data(), path.size());
+    path.pop_back();
+    return path;
+}
+
+/**
+ * @brief Get the name of the file an HDF5 object resides in
+ *
+ * @param id Identifier of the object
+ * @return std::string The file name as it was given when opening the file
+ */
+inline std::string
+get_file_path(hid_t id)
+{
+    std::string path(H5Fget_name(id, nullptr, 0) + 1, '\0');
+    H5Fget_name(id, path.data(), path.size());
+    path.pop_back();
+    return path;
+}
+
+/**
+ * @brief Determine the path of a shard file that belongs to an output file
+ *
+ * @details The shard is placed next to the output file; its name is composed
+ *          of the output file's name (without the `.h5` extension) and the
+ *          name of the shard, e.g. `data/data_sub.h5`.
+ *
+ * @param file_path  Path of the output file
+ * @param shard_name Name of the shard
+ * @return std::string The path of the shard file
+ */
+inline std::string
+shard_file_path(const std::string& file_path, const std::string& shard_name)
+{
+    std::string stem = file_path;
+    const std::string ext = ".h5";
+
+    if (stem.size() > ext.size() and
+        stem.compare(stem.size() - ext.size(), ext.size(), ext) == 0)
+    {
+        stem.erase(stem.size() - ext.size());
+    }
+
+    return stem + "_" + shard_name + ext;
+}
+
+/**
+ * @brief Copy all attributes of an HDF5 object to another object
+ *
+ * @details The values are copied in their file representation; variable
+ *          length data is copied as well.
+ *
+ * @param source Identifier of the object to copy the attributes from
+ * @param target Identifier of the object to copy the attributes to
+ */
+inline void
+copy_attributes(hid_t source, hid_t target)
+{
+    auto copy = [](hid_t loc, const char* name, const H5A_info_t*, void* op) {
+        const hid_t target = *static_cast< hid_t* >(op);
+        const hid_t attr = H5Aopen(loc, name, H5P_DEFAULT);
+        const hid_t type = H5Aget_type(attr);
+        const hid_t space = H5Aget_space(attr);
+
+        std::vector< char > buffer(
+            H5Sget_simple_extent_npoints(space) * H5Tget_size(type));
+        herr_t err = H5Aread(attr, type, buffer.data());
+
+        if (err >= 0)
+        {
+            if (H5Aexists(target, name) > 0)
+            {
+                H5Adelete(target, name);
+            }
+            const hid_t new_attr =
+                H5Acreate2(target, name, type, space, H5P_DEFAULT, H5P_DEFAULT);
+            err = H5Awrite(new_attr, type, buffer.data());
+            H5Aclose(new_attr);
+
+            // free memory allocated by HDF5 for variable length data
+            if (H5Tdetect_class(type, H5T_VLEN) > 0 or
+                H5Tis_variable_str(type) > 0)
+            {
+#if H5_VERSION_GE(1, 12, 0)
+                H5Treclaim(type, space, H5P_DEFAULT, buffer.data());
+#else
+                H5Dvlen_reclaim(type, space, H5P_DEFAULT, buffer.data());
+#endif
+            }
+        }
+
+        H5Sclose(space);
+        H5Tclose(type);
+        H5Aclose(attr);
+        return err;
+    };
+
+    hid_t op_data = target;
+    if (H5Aiterate2(
+            source, H5_INDEX_NAME, H5_ITER_NATIVE, nullptr, copy, &op_data) <
+        0)
+    {
+        throw std::runtime_error("Error when copying attributes of " +
+                                 get_object_path(source));
+    }
+}
+
+/**
+ * @brief Create a virtual dataset that maps the whole extent of a dataset
+ *        residing in another file
+ *
+ * @details The virtual dataset has the same type and the current extent of
+ *          the source dataset. If the source can still grow along its first
+ *          dimension, e.g. because it is written to at every time step, it
+ *          is mapped without bound along that dimension, such that data
+ *          written to the source later on is visible through the virtual
+ *          dataset as well. Missing intermediate groups are created. The
+ *          attributes of the source dataset are copied.
+ *
+ * @param target_loc  Identifier of the group to create the dataset in
+ * @param name        Name (or path relative to target_loc) of the virtual
+ *                    dataset
+ * @param source      Identifier of the source dataset
+ * @param source_file Name of the file containing the source dataset. If it
+ *                    is a relative path, HDF5 also looks for it relative to
+ *                    the directory of the file containing the virtual dataset
+ */
+inline void
+create_virtual_dataset(hid_t              target_loc,
+                       const std::string& name,
+                       hid_t              source,
+                       const std::string& source_file)
+{
+    const hid_t type = H5Dget_type(source);
+    const hid_t src_space = H5Dget_space(source);
+
+    const int rank = H5Sget_simple_extent_ndims(src_space);
+    std::vector< hsize_t > extent(rank);
+    std::vector< hsize_t > max_extent(rank);
+    H5Sget_simple_extent_dims(src_space, extent.data(), max_extent.data());
+
+    const bool extendible = rank > 0 and max_extent[0] != extent[0];
+    if (extendible)
+    {
+        max_extent[0] = H5S_UNLIMITED;
+    }
+    else
+    {
+        max_extent = extent;
+    }
+
+    // The mapping covers the whole source; in an extendible dataset, the
+    // first dimension is mapped without bound
+    const hid_t space =
+        H5Screate_simple(rank, extent.data(), max_extent.data());
+    const hid_t src_sel =
+        H5Screate_simple(rank, extent.data(), max_extent.data());
+
+    if (extendible)
+    {
+        std::vector< hsize_t > start(rank, 0);
+        std::vector< hsize_t > count(rank, 1);
+        std::vector< hsize_t > block = extent;
+        block[0] = H5S_UNLIMITED;
+
+        for (const auto sel : { space, src_sel })
+        {
+            H5Sselect_hyperslab(sel,
+                                H5S_SELECT_SET,
+                                start.data(),
+                                nullptr,
+                                count.data(),
+                                block.data());
+        }
+    }
+    else
+    {
+        H5Sselect_all(space);
+        H5Sselect_all(src_sel);
+    }
+
+    const hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_virtual(plist,
+                   space,
+                   source_file.c_str(),
+                   get_object_path(source).c_str(),
+                   src_sel);
+
+    const hid_t lcpl = H5Pcreate(H5P_LINK_CREATE);
+    H5Pset_create_intermediate_group(lcpl, 1);
+
+    const hid_t dset = H5Dcreate2(
+        target_loc, name.c_str(), type, space, lcpl, plist, H5P_DEFAULT);
+
+    H5Pclose(lcpl);
+    H5Pclose(plist);
+    H5Sclose(src_sel);
+    H5Sclose(space);
+    H5Sclose(src_space);
+    H5Tclose(type);
+
+    if (dset < 0)
+    {
+        throw std::runtime_error("Error when creating virtual dataset '" +
+                                 name + "' for " + get_object_path(source) +
+                                 " in " + source_file);
+    }
+
+    copy_attributes(source, dset);
+    H5Dclose(dset);
+}
+
+/**
+ * @brief Expose the content of a group via virtual datasets in another group
+ *
+ * @details Recursively goes through the source group, creating each
+ *          subgroup in the target group and a virtual dataset for each
+ *          dataset. Attributes of the groups and datasets are copied. This
+ *          makes output that was distributed over several files (shards)
+ *          accessible in a single file, with the same layout as if it was
+ *          written there directly. Datasets that already exist in the target
+ *          group are not created again; only their attributes are updated.
+ *
+ * @param source The group to expose, typically residing in a shard file
+ * @param target The group to create the virtual datasets in
+ * @param source_file Name of the file the source group resides in, as it
+ *                    should be referred to by the virtual datasets. Shard
+ *                    files are best referred to by their file name only,
+ *                    such that they are found relative to the target file.
+ */
+inline void
+link_virtual(HDFGroup& source, HDFGroup& target, const std::string& source_file)
+{
+    // Go recursively through the links in the group
+    auto link = [](hid_t source_id,
+                   hid_t target_id,
+                   const std::string& source_file,
+                   auto& self) -> void {
+        copy_attributes(source_id, target_id);
+
+        H5G_info_t info;
+        H5Gget_info(source_id, &info);
+
+        for (hsize_t i = 0; i < info.nlinks; ++i)
+        {
+            std::string name(H5Lget_name_by_idx(source_id,
+                                                ".",
+                                                H5_INDEX_NAME,
+                                                H5_ITER_NATIVE,
+                                                i,
+                                                nullptr,
+                                                0,
+                                                H5P_DEFAULT) +
+                                 1,
+                             '\0');
+            H5Lget_name_by_idx(source_id,
+                               ".",
+                               H5_INDEX_NAME,
+                               H5_ITER_NATIVE,
+                               i,
+                               name.data(),
+                               name.size(),
+                               H5P_DEFAULT);
+            name.pop_back();
+
+            const hid_t obj = H5Oopen(source_id, name.c_str(), H5P_DEFAULT);
+            const H5I_type_t obj_type = H5Iget_type(obj);
+
+            if (obj_type == H5I_GROUP)
+            {
+                const hid_t group =
+                    (H5Lexists(target_id, name.c_str(), H5P_DEFAULT) > 0)
+                        ? H5Gopen2(target_id, name.c_str(), H5P_DEFAULT)
+                        : H5Gcreate2(target_id,
+                                     name.c_str(),
+                                     H5P_DEFAULT,
+                                     H5P_DEFAULT,
+                                     H5P_DEFAULT);
+                self(obj, group, source_file, self);
+                H5Gclose(group);
+            }
+            else if (obj_type == H5I_DATASET)
+            {
+                if (H5Lexists(target_id, name.c_str(), H5P_DEFAULT) > 0)
+                {
+                    const hid_t dset =
+                        H5Dopen2(target_id, name.c_str(), H5P_DEFAULT);
+                    copy_attributes(obj, dset);
+                    H5Dclose(dset);
+                }
+                else
+                {
+                    create_virtual_dataset(target_id, name, obj, source_file);
+                }
+            }
+
+            H5Oclose(obj);
+        }
+    };
+
+    link(source.get_C_id(), target.get_C_id(), source_file, link);
+}
+
+/*! \} */ // end of group HDF5
+/*! \} */ // end of group DataIO
+
+} // namespace DataIO
+} // namespace Utopia
+
+#endif // UTOPIA_DATAIO_HDFVIRTUAL_HH
@@ -1,13 +1,29 @@
 #ifndef UTOPIA_DATAIO_MONITOR_HH
 #define UTOPIA_DATAIO_MONITOR_HH
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
+#include <spdlog/spdlog.h>  // for fmt::
 #include <yaml-cpp/yaml.h>
 
 #include "../core/string.hh"
+#include "../core/type_traits.hh"
 #include "cfg_utils.hh"
 
 
@@ -149,11 +165,229 @@ class MonitorTimer
     }
 };
 
+/// The format the monitor entries are emitted in
+enum class MonitorFormat
+{
+    /// A YAML mapping in flow style, e.g. `{time: 1, m: {a: 2}}`
+    yaml,
+
+    /// A JSON object, e.g. `{"time":1,"m":{"a":2}}`, which is more compact
+    /// and faster to parse
+    json
+};
+
+/// Get the MonitorFormat of the given name, `yaml` or `json`
+inline MonitorFormat
+monitor_format_from_string(const std::string& format)
+{
+    if (format == "yaml")
+    {
+        return MonitorFormat::yaml;
+    }
+    else if (format == "json")
+    {
+        return MonitorFormat::json;
+    }
+    throw std::invalid_argument("Invalid monitor format '" + format +
+                                "'! Available formats: yaml, json.");
+}
+
+/// Get the prefix emitted lines of the given MonitorFormat start with
+/** YAML lines are tagged as a mapping, `!!map `, as before. JSON lines have
+ *  no prefix, such that each of them is a valid JSON document; being valid
+ *  YAML as well, they can still be parsed by a YAML-based frontend. A
+ *  frontend can tell the formats apart by the first character of a line.
+ */
+inline std::string
+monitor_emit_prefix(const MonitorFormat format)
+{
+    return (format == MonitorFormat::json) ? "" : "!!map ";
+}
+
+/// The value of a monitor entry
+/** Entry values are stored in this form until they are emitted, such that
+ *  the conversion to text can happen at the time of emission, possibly on
+ *  another thread.
+ */
+using MonitorValue = std::variant< bool,
+                                   long long,
+                                   unsigned long long,
+                                   float,
+                                   double,
+                                   std::string,
+                                   std::vector< long long >,
+                                   std::vector< unsigned long long >,
+                                   std::vector< float >,
+                                   std::vector< double >,
+                                   std::vector< std::string > >;
+
+namespace _internal
+{
+
+/// The type a single value is stored as within a MonitorValue
+template < typename Value >
+using monitor_element_t = std::conditional_t<
+    std::is_same_v< Value, bool >,
+    bool,
+    std::conditional_t<
+        std::is_floating_point_v< Value >,
+        std::conditional_t< std::is_same_v< Value, float >, float, double >,
+        std::conditional_t<
+            std::is_integral_v< Value >,
+            std::conditional_t< std::is_signed_v< Value >,
+                                long long,
+                                unsigned long long >,
+            std::string > > >;
+
+/// Convert a value to a MonitorValue
+/** Supports arithmetic values, strings, and containers of these.
+ */
+template < typename Value >
+MonitorValue
+to_monitor_value(const Value& value)
+{
+    if constexpr (std::is_arithmetic_v< Value >)
+    {
+        return monitor_element_t< Value >(value);
+    }
+    else if constexpr (std::is_convertible_v< const Value&, std::string >)
+    {
+        return std::string(value);
+    }
+    else
+    {
+        using Element =
+            std::decay_t< decltype(*std::begin(std::declval< Value >())) >;
+        static_assert(std::is_arithmetic_v< Element > or
+                          std::is_convertible_v< const Element&, std::string >,
+                      "Monitor entries can only be arithmetic values, "
+                      "strings, or containers of these!");
+        static_assert(not std::is_same_v< Element, bool >,
+                      "Monitor entries cannot be containers of booleans!");
+
+        using Stored = monitor_element_t< Element >;
+        return std::vector< Stored >(std::begin(value), std::end(value));
+    }
+}
+
+/// Write a string as a JSON string literal
+inline void
+write_json_string(std::string& out, const std::string& str)
+{
+    out += '"';
+    for (const char c : str)
+    {
+        switch (c)
+        {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            case '\r': out += "\\r"; break;
+            default:
+                if (static_cast< unsigned char >(c) < 0x20)
+                {
+                    out += fmt::format("\\u{:04x}", int(c));
+                }
+                else
+                {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+/// Write a single element of a MonitorValue as JSON
+template < typename Element >
+void
+write_json_element(std::string& out, const Element& element)
+{
+    if constexpr (std::is_same_v< Element, bool >)
+    {
+        out += element ? "true" : "false";
+    }
+    else if constexpr (std::is_floating_point_v< Element >)
+    {
+        // JSON does not support non-finite numbers
+        if (std::isfinite(element))
+        {
+            out += fmt::format("{}", element);
+        }
+        else
+        {
+            out += "null";
+        }
+    }
+    else if constexpr (std::is_arithmetic_v< Element >)
+    {
+        out += fmt::format("{}", element);
+    }
+    else
+    {
+        write_json_string(out, element);
+    }
+}
+
+/// Write a MonitorValue as JSON
+inline void
+write_json_value(std::string& out, const MonitorValue& value)
+{
+    std::visit(
+        [&out](const auto& v) {
+            using V = std::decay_t< decltype(v) >;
+            if constexpr (Utils::is_container_v< V > and
+                          not std::is_same_v< V, std::string >)
+            {
+                out += '[';
+                for (std::size_t i = 0; i < v.size(); ++i)
+                {
+                    if (i > 0)
+                    {
+                        out += ',';
+                    }
+                    write_json_element(out, v[i]);
+                }
+                out += ']';
+            }
+            else
+            {
+                write_json_element(out, v);
+            }
+        },
+        value);
+}
+
+} // namespace _internal
+
+/// The layout of the monitor entries tree
+/** Each node is either a mapping with child nodes or, if it has a slot, a
+ *  leaf holding the value with that slot index. The tree is built when
+ *  entries are registered, such that paths need not be parsed on emission.
+ */
+struct MonitorNode
+{
+    /// The key of this node within its parent
+    std::string key;
+
+    /// The index of the slot holding the value, if this is a leaf
+    std::optional< std::size_t > slot;
+
+    /// The child nodes, in order of registration
+    std::vector< MonitorNode > children;
+};
+
 /// The MonitorManager manages the monitor entries and MonitorTimer
 /**
  * The manager performs an emission of the stored monitor data
  * if the monitor timer asserts that enough time has passed since
  * the last emit.
+ *
+ * Entries are stored in typed slots that are registered the first time an
+ * entry is set; setting an entry again only stores the value. Upon emission,
+ * the values are converted to text in the configured format, either
+ * directly or, if asynchronous emission is enabled, on a separate thread.
+ * In the latter case, the simulation only needs to copy the slot values.
  */
 class MonitorManager
 {
@@ -161,12 +395,25 @@ class MonitorManager
     /// Type of the timer
     using Timer = std::shared_ptr< MonitorTimer >;
 
+    /// An emission to be performed
+    struct Emission
+    {
+        std::shared_ptr< const MonitorNode > layout;
+        std::vector< MonitorValue >          values;
+    };
+
     // -- Members -------------------------------------------------------------
     /// The monitor timer
     Timer _timer;
 
-    /// The monitor entries
-    YAML::Node _entries;
+    /// The layout of the monitor entries; replaced upon registration
+    std::shared_ptr< const MonitorNode > _layout;
+
+    /// The slot indices of the registered entries, by full path
+    std::unordered_map< std::string, std::size_t > _slot_ids;
+
+    /// The values of the registered entries
+    std::vector< MonitorValue > _values;
 
     /// The flag that determines whether to collect data
     bool _emit_enabled;
@@ -180,6 +427,27 @@ class MonitorManager
     /// A suffix to the emitted string
     const std::string _emit_suffix;
 
+    /// The format to emit in
+    const MonitorFormat _format;
+
+    /// Whether to emit on a separate thread
+    const bool _async;
+
+    /// The emissions not yet performed by the emitting thread
+    std::deque< Emission > _queue;
+
+    /// Protects the queue
+    std::mutex _queue_mutex;
+
+    /// Notifies the emitting thread of new emissions or the shutdown
+    std::condition_variable _queue_cv;
+
+    /// Whether the emitting thread is to finish
+    bool _shutdown;
+
+    /// The emitting thread, if emitting asynchronously
+    std::thread _emitter;
+
   public:
     /// Constructor
     /**
@@ -187,22 +455,58 @@ class MonitorManager
      *                      time to emit the monitor data.
      * @param emit_prefix   A prefix to the emitted string, default: "!!map "
      * @param emit_suffix   A suffix to the emitted string, default: "". Note
-     *                      that std::endl is always appended.
+     *                      that a newline is always appended.
+     * @param format        The format to emit the entries in
+     * @param async         Whether to convert and emit the entries on a
+     *                      separate thread
      */
-    MonitorManager(const double      emit_interval,
-                   const std::string emit_prefix = "!!map ",
-                   const std::string emit_suffix = "")
+    MonitorManager(const double        emit_interval,
+                   const std::string   emit_prefix = "!!map ",
+                   const std::string   emit_suffix = "",
+                   const MonitorFormat format = MonitorFormat::yaml,
+                   const bool          async = false)
     :
         // Create a new MonitorTimer object
         _timer(std::make_shared< MonitorTimer >(emit_interval)),
-        // Create an empty MonitorEntries object for the data to be emitted
-        _entries(YAML::Node()),
+        // Start with an empty tree of entries
+        _layout(std::make_shared< const MonitorNode >()),
+        _slot_ids{},
+        _values{},
         // Initialially set the collect data flag to true
         _emit_enabled(true),
         _emit_counter(0),
         _emit_prefix(emit_prefix),
-        _emit_suffix(emit_suffix)
-    {};
+        _emit_suffix(emit_suffix),
+        _format(format),
+        _async(async),
+        _queue{},
+        _queue_mutex{},
+        _queue_cv{},
+        _shutdown(false),
+        _emitter{}
+    {
+        if (_async)
+        {
+            _emitter = std::thread([this]() { run_emitter(); });
+        }
+    };
+
+    MonitorManager(const MonitorManager&) = delete;
+    MonitorManager& operator=(const MonitorManager&) = delete;
+
+    /// Destructor; performs the outstanding emissions
+    ~MonitorManager()
+    {
+        if (_emitter.joinable())
+        {
+            {
+                std::lock_guard< std::mutex > lock(_queue_mutex);
+                _shutdown = true;
+            }
+            _queue_cv.notify_all();
+            _emitter.join();
+        }
+    }
 
     /// Perform an emission of the data to the terminal, if the flag was set
     void
@@ -210,21 +514,32 @@ class MonitorManager
     {
         if (not _emit_enabled) return;
 
-        // Calling recursive_setitem may remove the emitter style, requiring
-        // to reset it here each time. This will only set some flags in the
-        // to-be-created YAML::Emitter and has negligible performance impact.
-        _entries.SetStyle(YAML::EmitterStyle::Flow);
-
-        std::cout << _emit_prefix
-                  << _entries
-                  << _emit_suffix
-                  << std::endl;
+        if (_async)
+        {
+            {
+                std::lock_guard< std::mutex > lock(_queue_mutex);
+                _queue.push_back(Emission{ _layout, _values });
+            }
+            _queue_cv.notify_all();
+        }
+        else
+        {
+            emit(Emission{ _layout, _values });
+        }
 
         _emit_counter++;
         _timer->reset();
         _emit_enabled = false;
     }
 
+    /// Wait until all asynchronous emissions were performed
+    void
+    wait_for_emissions()
+    {
+        std::unique_lock< std::mutex > lock(_queue_mutex);
+        _queue_cv.wait(lock, [this]() { return _queue.empty(); });
+    }
+
     /// Checks with the timer whether the time to emit has come.
     void
     check_timer()
@@ -247,9 +562,76 @@ class MonitorManager
         return _emit_enabled;
     }
 
+    /// Register an entry, returning the index of the slot storing its value
+    /** If an entry at this path was already registered, its slot is
+     *  returned. The path is only parsed upon the first registration.
+     *
+     * @param path      The full path of the entry, segments separated by `.`;
+     *                  empty segments are skipped.
+     */
+    std::size_t
+    register_entry(const std::string& path)
+    {
+        if (const auto it = _slot_ids.find(path); it != _slot_ids.end())
+        {
+            return it->second;
+        }
+
+        const auto segments = split(path, ".");
+
+        // Build a new layout that includes the entry; the previous one might
+        // still be in use for an emission
+        auto layout = std::make_shared< MonitorNode >(*_layout);
+        auto node = layout.get();
+
+        for (const auto& segment : segments)
+        {
+            if (segment.empty())
+            {
+                continue;
+            }
+
+            auto child = std::find_if(
+                node->children.begin(),
+                node->children.end(),
+                [&segment](const auto& c) { return c.key == segment; });
+
+            if (child == node->children.end())
+            {
+                node->children.push_back(MonitorNode{ segment, {}, {} });
+                child = std::prev(node->children.end());
+            }
+            node = &(*child);
+        }
+
+        if (node == layout.get())
+        {
+            throw std::invalid_argument("Cannot register monitor entry with "
+                                        "invalid path '" +
+                                        path + "'!");
+        }
+
+        // A former mapping is replaced by the value
+        node->children.clear();
+        node->slot = _values.size();
+        _values.emplace_back();
+
+        _layout = std::move(layout);
+        _slot_ids[path] = *node->slot;
+        return *node->slot;
+    }
+
+    /// Set the value of a registered entry
+    template < typename Value >
+    void
+    set_slot(const std::size_t slot, const Value& value)
+    {
+        _values[slot] = _internal::to_monitor_value(value);
+    }
+
     /// Set an entry in the tree of monitor entries
-    /** Sets an element at `<path>.<key>` to `value`, creating intermediate
-     *  nodes within the monitor entries tree.
+    /** Sets an element at `<path>.<key>` to `value`, registering the entry
+     *  if it does not exist yet.
      *
      * @tparam Value    The type of the value that should be monitored
      *
@@ -267,8 +649,7 @@ class MonitorManager
               const std::string& key,
               const Value        value)
     {
-        using _internal::recursive_setitem;
-        recursive_setitem(_entries, path + "." + key, value, ".");
+        set_slot(register_entry(path + "." + key), value);
     }
 
     /// Set time- and progress-related top level entries
@@ -283,10 +664,10 @@ class MonitorManager
     void
     set_time_entries(const Time time, const Time time_max)
     {
-        _entries["time"] = time;
+        set_slot(register_entry("time"), time);
 
         // Add the progress indicator and the elapsed time
-        _entries["progress"] = float(time) / float(time_max);
+        set_slot(register_entry("progress"), float(time) / float(time_max));
     }
 
     /// Get a shared pointer to the MonitorTimer object.
@@ -310,11 +691,156 @@ class MonitorManager
         return _emit_counter;
     }
 
-    /// Get the reference to the monitor entries object.
-    YAML::Node&
-    get_entries()
+    /// Return the format the entries are emitted in
+    MonitorFormat
+    get_format() const
+    {
+        return _format;
+    }
+
+    /// Get the monitor entries as a YAML node
+    YAML::Node
+    get_entries() const
+    {
+        return to_yaml(*_layout, _values);
+    }
+
+  private:
+    /// Convert the entries to a YAML node
+    static YAML::Node
+    to_yaml(const MonitorNode& node, const std::vector< MonitorValue >& values)
+    {
+        YAML::Node yaml;
+        for (const auto& child : node.children)
+        {
+            if (child.slot)
+            {
+                std::visit([&](const auto& v) { yaml[child.key] = v; },
+                           values[*child.slot]);
+            }
+            else
+            {
+                yaml[child.key] = to_yaml(child, values);
+            }
+        }
+        return yaml;
+    }
+
+    /// Convert the entries to a JSON object
+    static void
+    to_json(std::string&                       out,
+            const MonitorNode&                 node,
+            const std::vector< MonitorValue >& values)
     {
-        return _entries;
+        out += '{';
+        for (std::size_t i = 0; i < node.children.size(); ++i)
+        {
+            const auto& child = node.children[i];
+            if (i > 0)
+            {
+                out += ',';
+            }
+            _internal::write_json_string(out, child.key);
+            out += ':';
+
+            if (child.slot)
+            {
+                _internal::write_json_value(out, values[*child.slot]);
+            }
+            else
+            {
+                to_json(out, child, values);
+            }
+        }
+        out += '}';
+    }
+
+    /// Convert the entries to text and write them to std::cout
+    /** The line is written with a single operation, such that it does not
+     *  get mixed up with output of other threads.
+     */
+    void
+    emit(const Emission& emission) const
+    {
+        std::string line = _emit_prefix;
+
+        if (_format == MonitorFormat::json)
+        {
+            to_json(line, *emission.layout, emission.values);
+        }
+        else
+        {
+            auto yaml = to_yaml(*emission.layout, emission.values);
+            yaml.SetStyle(YAML::EmitterStyle::Flow);
+
+            YAML::Emitter emitter;
+            emitter << yaml;
+            line += emitter.c_str();
+        }
+
+        line += _emit_suffix;
+        line += '\n';
+
+        std::cout << line << std::flush;
+    }
+
+    /// The loop of the emitting thread
+    void
+    run_emitter()
+    {
+        std::unique_lock< std::mutex > lock(_queue_mutex);
+        while (true)
+        {
+            _queue_cv.wait(lock,
+                           [this]() { return _shutdown or not _queue.empty(); });
+
+            while (not _queue.empty())
+            {
+                // Emit without holding the lock, such that the simulation
+                // can continue to enqueue emissions
+                const auto emission = std::move(_queue.front());
+                lock.unlock();
+                emit(emission);
+                lock.lock();
+                _queue.pop_front();
+            }
+            _queue_cv.notify_all();
+
+            if (_shutdown)
+            {
+                return;
+            }
+        }
+    }
+};
+
+/// A handle to a registered monitor entry
+/** Setting the value via the handle avoids looking up the entry by its path,
+ *  which is useful for entries that are set frequently.
+ */
+class MonitorEntry
+{
+  private:
+    /// The monitor manager the entry is registered with
+    std::shared_ptr< MonitorManager > _mtr_mgr;
+
+    /// The slot of the entry
+    std::size_t _slot;
+
+  public:
+    /// Construct a handle for the given slot
+    MonitorEntry(std::shared_ptr< MonitorManager > mtr_mgr,
+                 const std::size_t                 slot)
+    :
+        _mtr_mgr(mtr_mgr),
+        _slot(slot){};
+
+    /// Set the value of the entry
+    template < typename Value >
+    void
+    set(const Value& value)
+    {
+        _mtr_mgr->set_slot(_slot, value);
     }
 };
 
@@ -417,6 +943,17 @@ class Monitor
         }
     }
 
+    /// Register an entry, returning a handle to set its value with
+    /**
+     * @param key       The key of the entry
+     */
+    MonitorEntry
+    register_entry(const std::string& key)
+    {
+        return MonitorEntry(_mtr_mgr,
+                            _mtr_mgr->register_entry(_name + "." + key));
+    }
+
     /// Get a shared pointer to the MonitorManager.
     std::shared_ptr< MonitorManager >
     get_monitor_manager() const
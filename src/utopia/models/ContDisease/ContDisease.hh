@@ -8,6 +8,7 @@
 #include <utopia/core/model.hh>
 #include <utopia/core/apply.hh>
 #include <utopia/core/cell_manager.hh>
+#include <utopia/core/rng.hh>
 #include <utopia/core/select.hh>
 
 // ContDisease-realted includes
@@ -29,7 +30,16 @@ using CDCellTraits = Utopia::CellTraits<State, Update::manual>;
 
 
 /// Typehelper to define data types of ContDisease model
-using CDTypes = ModelTypes<>;
+/** \details The random number engine is selected via the `rng_engine` entry
+  *          of the model configuration, see ContDisease.cc. The default
+  *          engine, Utopia::DefaultRNG, keeps the realizations for a given
+  *          seed unchanged. The others are considerably faster: the model
+  *          then draws the random numbers for growth and point infection in
+  *          one batch per step, see Utopia::fill_uniform, and realizations
+  *          differ.
+  */
+template<class RNG=DefaultRNG>
+using CDTypes = ModelTypes<RNG>;
 
 
 // ++ Model definition ++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -47,12 +57,16 @@ using CDTypes = ModelTypes<>;
  *  cells that continuously spread infection without dying themselves.
  *  Different starting conditions, and update mechanisms can be configured.
  */
+template<class Types=CDTypes<>>
 class ContDisease:
-    public Model<ContDisease, CDTypes>
+    public Model<ContDisease<Types>, Types>
 {
 public:
     /// The base model type
-    using Base = Model<ContDisease, CDTypes>;
+    using Base = Model<ContDisease, Types>;
+
+    /// Data type of the shared RNG
+    using RNG = typename Base::RNG;
 
     /// Data type for a data group
     using DataGroup = typename Base::DataGroup;
@@ -83,14 +97,35 @@ private:
     /// Model parameters
     const Params _params;
 
-    /// The range [0, 1] distribution to use for probability checks
-    std::uniform_real_distribution<double> _prob_distr;
+    /// Whether to draw the numbers for growth and point infection in batches
+    /** This changes the order of draws and is thus only done for the engines
+      * other than the default one, like Utopia::BernoulliTrial does.
+      */
+    static constexpr bool _batched_draws = not std::is_same_v<RNG, DefaultRNG>;
+
+    /// The type of a Bernoulli trial using the model's RNG
+    using Trial = BernoulliTrial<RNG>;
+
+    /// Trial for an empty cell to grow a tree
+    const Trial _growth;
+
+    /// Trial for a random point infection of a tree; p_infect may change
+    Trial _infection;
+
+    /// Trial for a tree to resist the infection by an infected neighbor
+    const Trial _immunity;
 
     /// The incremental cluster tag
     unsigned int _cluster_id_cnt;
 
     /// A temporary container for use in cluster identification
-    std::vector<std::shared_ptr<CellManager::Cell>> _cluster_members;
+    std::vector<std::shared_ptr<Cell>> _cluster_members;
+
+    /// Uniformly distributed numbers for each cell; used for batched draws
+    /** Drawn at the beginning of each step; a cell compares its number
+      * against either p_growth or p_infect, depending on its kind.
+      */
+    std::vector<double> _draws;
 
     /// Densities for all states
     /** Array indices are linked to \ref Utopia::Models::ContDisease::Kind
@@ -106,9 +141,15 @@ private:
     /// 2D dataset (densities array and time) of density values
     std::shared_ptr<DataSet> _dset_densities;
 
-    /// 2D dataset (cell ID and time) of cell kinds
+    /// Whether to write the cell kinds as changes; see `kind_output` config
+    const bool _write_kind_delta;
+
+    /// 2D dataset (cell ID and time) of cell kinds; only used in full mode
     std::shared_ptr<DataSet> _dset_kind;
 
+    /// Writer of the cell kinds as keyframes and changes; only in delta mode
+    std::shared_ptr<DataIO::DeltaWriter<char>> _kind_delta_writer;
+
     /// 2D dataset (tree age and time) of cells
     std::shared_ptr<DataSet> _dset_age;
 
@@ -116,6 +157,28 @@ private:
     std::shared_ptr<DataSet> _dset_cluster_id;
 
 
+    // .. Helper functions ....................................................
+    // Only create the kind dataset if the kinds are written in full
+    std::shared_ptr<DataSet> create_kind_dset() {
+        if (_write_kind_delta) {
+            return nullptr;
+        }
+        return this->create_cm_dset("kind", _cm);
+    }
+
+    // Only create the kind delta writer if the kinds are written as changes
+    std::shared_ptr<DataIO::DeltaWriter<char>> create_kind_delta_writer() {
+        if (not _write_kind_delta) {
+            return nullptr;
+        }
+        return this->template create_cm_delta_dset<char>(
+            "kind", _cm,
+            get_as<std::size_t>("keyframe_interval",
+                                this->_cfg["kind_output"])
+        );
+    }
+
+
 public:
     /// Construct the ContDisease model
     /** \param name             Name of this model instance; is used to extract
@@ -143,9 +206,12 @@ public:
         _params(this->_cfg),
 
         // Initialize remaining members
-        _prob_distr(0., 1.),
+        _growth(_params.p_growth),
+        _infection(_params.p_infect),
+        _immunity(_params.p_immunity),
         _cluster_id_cnt(),
         _cluster_members(),
+        _draws(_batched_draws ? _cm.cells().size() : 0),
         _densities{},  // undefined here, will be set in constructor body
         _write_only_densities(get_as<bool>("write_only_densities",
                                            this->_cfg)),
@@ -153,8 +219,12 @@ public:
         // Create the dataset for the densities; shape is known
         _dset_densities(this->create_dset("densities", {5})),
 
-        // Create dataset for cell states
-        _dset_kind(this->create_cm_dset("kind", _cm)),
+        // Create dataset or delta writer for cell states
+        _write_kind_delta(get_as<std::string>("write_mode",
+                                              this->_cfg["kind_output"])
+                          == "delta"),
+        _dset_kind(create_kind_dset()),
+        _kind_delta_writer(create_kind_delta_writer()),
 
         // Create dataset for tree age
         _dset_age(this->create_cm_dset("age", _cm)),
@@ -170,11 +240,13 @@ public:
         // e.g. the setup of heterogeneities: Stones and infection source.
 
         // Stones
-        if (_cfg["stones"] and get_as<bool>("enabled", _cfg["stones"])) {
+        if (    this->_cfg["stones"]
+            and get_as<bool>("enabled", this->_cfg["stones"]))
+        {
             this->_log->info("Setting cells to be stones ...");
 
             // Get the container
-            auto to_turn_to_stone = _cm.select_cells(_cfg["stones"]);
+            auto to_turn_to_stone = _cm.select_cells(this->_cfg["stones"]);
 
             // Apply a rule to all cells of that container: turn to stone
             apply_rule<Update::async, Shuffle::off>(
@@ -188,15 +260,16 @@ public:
 
             this->_log->info("Set {} cells to be stones using selection mode "
                              "'{}'.", to_turn_to_stone.size(),
-                             get_as<std::string>("mode", _cfg["stones"]));
+                             get_as<std::string>("mode", this->_cfg["stones"]));
         }
         
         // Ignite some cells permanently: fire sources
-        if (    _cfg["infection_source"]
-            and get_as<bool>("enabled", _cfg["infection_source"]))
+        if (    this->_cfg["infection_source"]
+            and get_as<bool>("enabled", this->_cfg["infection_source"]))
         {
             this->_log->info("Setting cells to be infection sources ...");
-            auto source_cells = _cm.select_cells(_cfg["infection_source"]);
+            auto source_cells =
+                _cm.select_cells(this->_cfg["infection_source"]);
 
             apply_rule<Update::async, Shuffle::off>(
                 [](const auto& cell){
@@ -209,7 +282,7 @@ public:
 
             this->_log->info("Set {} cells to be infection sources using "
                 "selection mode '{}'.", source_cells.size(),
-                get_as<std::string>("mode", _cfg["infection_source"]));
+                get_as<std::string>("mode", this->_cfg["infection_source"]));
         }
 
         // Add attributes to density dataset that provide coordinates
@@ -255,6 +328,26 @@ protected:
     };
 
 
+    /// Whether an empty cell grows a tree in this step
+    bool grows (const std::shared_ptr<Cell>& cell) const {
+        if constexpr (_batched_draws) {
+            return _draws[cell->id()] < _params.p_growth;
+        }
+        else {
+            return _growth(*this->_rng);
+        }
+    }
+
+    /// Whether a tree is infected by a random point infection in this step
+    bool is_point_infected (const std::shared_ptr<Cell>& cell) const {
+        if constexpr (_batched_draws) {
+            return _draws[cell->id()] < _params.p_infect;
+        }
+        else {
+            return _infection(*this->_rng);
+        }
+    }
+
     /// Identify clusters
     /** This function identifies clusters and updates the cell
      *  specific cluster_id as well as the member variable 
@@ -287,7 +380,7 @@ protected:
                 // Select cells that are trees 
                 // (not empty, stones, infected, or source)
                 const auto cells_pool =
-                    _cm.select_cells<SelectionMode::condition>(
+                    _cm.template select_cells<SelectionMode::condition>(
                         [&](const auto& cell){
                             return (cell->state.kind == Kind::tree);
                         }
@@ -320,6 +413,7 @@ protected:
 
             if (this->_time == change_p_infect.first) {
                 _params.p_infect = change_p_infect.second;
+                _infection.set_probability(_params.p_infect);
 
                 // Done. Can now remove the element from the queue.
                 _params.infection_control.change_p_infect.pop();
@@ -344,7 +438,7 @@ protected:
         // Distinguish by current state
         if (state.kind == Kind::empty) {
             // With a probability of p_growth, set the cell's state to tree
-            if (_prob_distr(*this->_rng) < _params.p_growth){
+            if (grows(cell)){
                 state.kind = Kind::tree;
                 return state;
             }
@@ -356,7 +450,7 @@ protected:
             // Tree can be infected by neighbor or by random-point-infection.
 
             // Determine whether there will be a point infection
-            if (_prob_distr(*this->_rng) < _params.p_infect) {
+            if (is_point_infected(cell)) {
                 // Yes, point infection occurred.
                 state.kind = Kind::infected;
                 return state;
@@ -373,7 +467,7 @@ protected:
                         or nb_state.kind == Kind::source)
                     {
                         // With a certain probability, become infected
-                        if (_prob_distr(*this->_rng) > _params.p_immunity) {
+                        if (not _immunity(*this->_rng)) {
                             state.kind = Kind::infected;
                             return state;
                         }
@@ -450,6 +544,12 @@ public:
             infection_control();
         }
 
+        // Each cell either grows a tree or can be infected at random; draw
+        // the corresponding random numbers at once, if enabled
+        if constexpr (_batched_draws) {
+            fill_uniform(*this->_rng, _draws.begin(), _draws.end());
+        }
+
         // Apply the update rule to all cells.
         apply_rule<Update::sync>(_update, _cm.cells());
         // NOTE The cell state is updated synchronously, i.e.: only after all
@@ -483,12 +583,19 @@ public:
             return;
         }
 
-        // Write the cell state
-        _dset_kind->write(_cm.cells().begin(), _cm.cells().end(),
-            [](const auto& cell) {
-                return static_cast<char>(cell->state.kind);
-            }
-        );
+        // Write the cell state, either in full or as changes
+        const auto get_kind = [](const auto& cell) {
+            return static_cast<char>(cell->state.kind);
+        };
+
+        if (_kind_delta_writer) {
+            _kind_delta_writer->write(_cm.cells().begin(), _cm.cells().end(),
+                                      get_kind, this->get_time());
+        }
+        else {
+            _dset_kind->write(_cm.cells().begin(), _cm.cells().end(),
+                              get_kind);
+        }
 
         // Write the tree ages
         _dset_age->write(_cm.cells().begin(), _cm.cells().end(),
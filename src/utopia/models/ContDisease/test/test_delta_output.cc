@@ -0,0 +1,71 @@
+#define BOOST_TEST_MODULE delta output test
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <utopia/core/model.hh>
+#include <utopia/data_io/hdfdelta.hh>
+#include <utopia/data_io/hdffile.hh>
+
+#include "../ContDisease.hh"
+
+namespace Utopia::Models::ContDisease {
+
+using DataIO::HDFFile;
+
+
+// -- Helpers -----------------------------------------------------------------
+
+/// Run ContDisease with the given kind write mode, writing to the given file
+void run_model (const std::string& write_mode, const std::string& out_path) {
+    PseudoParent<> pp("test_delta_output.yml", out_path, 42);
+
+    auto cfg = YAML::Clone(pp.get_cfg()["ContDisease"]);
+    cfg["kind_output"]["write_mode"] = write_mode;
+
+    ContDisease<>("ContDisease", pp, cfg).run();
+
+    // Allow a model of the same name in a subsequent run
+    spdlog::drop("root.ContDisease");
+}
+
+
+// -- Tests -------------------------------------------------------------------
+
+/// Test that the kinds written in delta mode reproduce the full output
+BOOST_AUTO_TEST_CASE (kind_delta_output)
+{
+    run_model("full", "test_delta_output_full.h5");
+    run_model("delta", "test_delta_output_delta.h5");
+
+    HDFFile full_file("test_delta_output_full.h5", "r");
+    HDFFile delta_file("test_delta_output_delta.h5", "r");
+
+    const auto [shape, kinds] = full_file.open_group("ContDisease")
+                                         ->open_dataset("kind")
+                                         ->read<std::vector<char>>();
+    BOOST_TEST(shape.size() == 2u);
+    BOOST_TEST(shape[0] == 31u);
+
+    // The delta output does not contain the full dataset but its own groups
+    const auto delta_grp = delta_file.open_group("ContDisease");
+    BOOST_TEST(not delta_grp->open_dataset("kind_delta/num_changes")
+                            ->get_capacity().empty());
+
+    const std::size_t num_cells = shape[1];
+    for (std::size_t t = 0; t < shape[0]; ++t) {
+        const std::vector<char> expected(kinds.begin() + t * num_cells,
+                                         kinds.begin() + (t+1) * num_cells);
+        BOOST_TEST(DataIO::load_delta_frame<char>(delta_grp, "kind", t)
+                   == expected);
+    }
+
+    full_file.close();
+    delta_file.close();
+    std::remove("test_delta_output_full.h5");
+    std::remove("test_delta_output_delta.h5");
+}
+
+} // namespace Utopia::Models::ContDisease
@@ -1,18 +1,45 @@
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 #include "ForestFire.hh"
 
 using namespace Utopia::Models::ForestFire;
 
 
+/// Set up and run the ForestFire model using the given random number engine
+template<class RNG>
+void run (const std::string& cfg_path) {
+    // Initialize the PseudoParent from config file path
+    Utopia::PseudoParent<RNG> pp(cfg_path);
+
+    // Initialize the main model and run it
+    ForestFire<ModelTypes<RNG>> model("ForestFire", pp);
+    model.run();
+}
+
+
 int main (int, char** argv) {
     try {
-        // Initialize the PseudoParent from config file path
-        Utopia::PseudoParent pp(argv[1]);
+        // Select the random number engine
+        const auto cfg = YAML::LoadFile(argv[1]);
+        const auto rng_engine = Utopia::get_as<std::string>(
+            "rng_engine", cfg["ForestFire"], "default"
+        );
 
-        // Initialize the main model and run it
-        ForestFire model("ForestFire", pp);
-        model.run();
+        if (rng_engine == "default") {
+            run<Utopia::DefaultRNG>(argv[1]);
+        }
+        else if (rng_engine == "xoshiro256++") {
+            run<Utopia::Xoshiro256PlusPlus>(argv[1]);
+        }
+        else if (rng_engine == "pcg64") {
+            run<Utopia::PCG64>(argv[1]);
+        }
+        else {
+            throw std::invalid_argument("Invalid rng_engine '" + rng_engine
+                + "'! Choose from: default, xoshiro256++, pcg64");
+        }
 
         return 0;
     }
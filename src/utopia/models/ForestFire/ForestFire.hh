@@ -8,6 +8,8 @@
 #include <utopia/core/model.hh>
 #include <utopia/core/apply.hh>
 #include <utopia/core/cell_manager.hh>
+#include <utopia/core/rng.hh>
+#include <utopia/data_io/cfg_schema.hh>
 
 #include "../ContDisease/state.hh"
 
@@ -35,42 +37,62 @@ struct State {
     /// An ID denoting to which cluster this cell belongs (if it is a tree)
     unsigned int cluster_id;
 
+    /// The parameters needed to construct a cell state
+    struct Params {
+        /// The probability for a cell to initially be a tree
+        double p_tree;
+
+        /// Default-construct the parameters; required by ConfigSchema
+        Params () = default;
+
+        /// Extract the parameters from the ``cell_params`` node
+        Params (const DataIO::Config& cfg)
+        :
+            Params(schema().parse(cfg))
+        {}
+
+        /// The schema used to parse and validate the parameters
+        static const ConfigSchema<Params>& schema () {
+            static const auto schema = ConfigSchema<Params>("cell_params")
+                .required("p_tree", &Params::p_tree, is_probability());
+            return schema;
+        }
+    };
+
     /// Remove default constructor, for safety
     State () = delete;
 
-    /// Construct a cell from a configuration node and an RNG
+    /// Construct a cell from parsed parameters and an RNG
     template<class RNG>
-    State (const DataIO::Config& cfg, const std::shared_ptr<RNG>& rng)
+    State (const Params& params, RNG& rng)
     :
         kind(Kind::empty),
         age(0),
         cluster_id(0)
     {
-        // Get the desired probability to be a tree
-        const auto p_tree = get_as<double>("p_tree", cfg);
-
         // Check obvious cases (no need to draw a random number)
-        if (p_tree < 0. or p_tree > 1.) {
-            throw std::invalid_argument("p_tree needs to be in interval "
-                                        "[0., 1.], but was not!");
-        }
-        else if (p_tree == 0.) {
+        if (params.p_tree == 0.) {
             return;
         }
-        else if (p_tree == 1.) {
+        else if (params.p_tree == 1.) {
             kind = Kind::tree;
             return;
         }
 
         // With this probability, the cell state is a tree
-        if (std::uniform_real_distribution<double>(0., 1.)(*rng) < p_tree) {
+        if (std::uniform_real_distribution<double>(0., 1.)(rng)
+            < params.p_tree)
+        {
             kind = Kind::tree;
         }
-        // NOTE Although the distribution object is created each time, this
-        //      is not a significant slow-down compared to re-using an
-        //      existing distribution object (<4%). When compiled with
-        //      optimization flags, that slowdown is even smaller...
     }
+
+    /// Construct a cell from a configuration node and an RNG
+    template<class RNG>
+    State (const DataIO::Config& cfg, const std::shared_ptr<RNG>& rng)
+    :
+        State(Params(cfg), *rng)
+    {}
 };
 
 
@@ -88,42 +110,45 @@ using CellTraits = Utopia::CellTraits<State, Update::manual>;
 /// ForestFire model parameter struct
 struct Param {
     /// Rate of growth per cell
-    const double p_growth;
+    double p_growth;
 
     /// Frequency of lightning occurring per cell
-    const double p_lightning;
+    double p_lightning;
 
     /// The probability (per neighbor) to be immune to a spreading fire
-    const double p_immunity;
+    double p_immunity;
+
+    /// Default-construct the parameters; required by ConfigSchema
+    Param () = default;
 
     /// Construct the parameters from the given configuration node
     Param(const DataIO::Config& cfg)
     :
-        p_growth(get_as<double>("p_growth", cfg)),
-        p_lightning(get_as<double>("p_lightning", cfg)),
-        p_immunity(get_as<double>("p_immunity", cfg))
-    {
-        if ((p_growth > 1.) or (p_growth < 0.)) {
-            throw std::invalid_argument("Invalid p_growth! Need be a value "
-                "in range [0, 1] and specify the probability per time step "
-                "and cell with which an empty cell turns into a tree.");
-        }
-        if ((p_lightning > 1.) or (p_lightning < 0.)) {
-            throw std::invalid_argument("Invalid p_lightning! Need be "
-                "in range [0, 1] and specify the probability per cell and "
-                "time step for lightning to strike.");
-        }
-        if ((p_immunity > 1.) or (p_immunity < 0.)) {
-            throw std::invalid_argument("Invalid p_immunity! "
-                "Need be a value in range [0, 1] and specify the probability "
-                "per neighbor with which that neighbor is immune to fire.");
-        }
+        Param(schema().parse(cfg))
+    {}
+
+    /// The schema used to parse and validate the parameters
+    static const ConfigSchema<Param>& schema () {
+        static const auto schema = ConfigSchema<Param>("ForestFire model")
+            .required("p_growth", &Param::p_growth, is_probability())
+            .required("p_lightning", &Param::p_lightning, is_probability())
+            .required("p_immunity", &Param::p_immunity, is_probability());
+        return schema;
     }
 };
 
 
 /// Typehelper to define data types of ForestFire model
-using ModelTypes = Utopia::ModelTypes<>;
+/** \details The random number engine is selected via the `rng_engine` entry
+  *          of the model configuration, see ForestFire.cc. The default
+  *          engine, Utopia::DefaultRNG, keeps the realizations for a given
+  *          seed unchanged. The others are considerably faster: the model
+  *          then draws the random numbers for growth and lightning in one
+  *          batch per step, see Utopia::fill_uniform, and realizations
+  *          differ.
+  */
+template<class RNG=Utopia::DefaultRNG>
+using ModelTypes = Utopia::ModelTypes<RNG>;
 
 
 // ++ Model definition ++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -133,12 +158,16 @@ using ModelTypes = Utopia::ModelTypes<>;
  *  of fires. Trees grow randomly and lightning strikes lead to a whole cluster
  *  instantaneously burning down. This is the so-called two state model.
  */
+template<class Types=ModelTypes<>>
 class ForestFire:
-    public Model<ForestFire, ModelTypes>
+    public Model<ForestFire<Types>, Types>
 {
 public:
     /// The base model type
-    using Base = Model<ForestFire, ModelTypes>;
+    using Base = Model<ForestFire, Types>;
+
+    /// Data type of the shared RNG
+    using RNG = typename Base::RNG;
 
     /// Data type for a dataset
     using DataSet = typename Base::DataSet;
@@ -154,7 +183,8 @@ public:
 
 
 private:
-    // Base members: _time, _name, _cfg, _hdfgrp, _rng, _monitor, _log, _space
+    // Base members: _time, _name, _cfg, _hdfgrp, _rng, _monitor, _log, _space,
+    //               _observables
     // ... but you should definitely check out the documentation ;)
 
     // -- Members -------------------------------------------------------------
@@ -164,14 +194,36 @@ private:
     /// Model parameters
     const Param _param;
 
-    /// A [0,1]-range uniform distribution used for evaluating probabilities
-    std::uniform_real_distribution<double> _prob_distr;
+    /// Whether to draw the random numbers for growth and lightning in batches
+    /** This changes the order of draws and is thus only done for the engines
+      * other than the default one, like Utopia::BernoulliTrial does.
+      */
+    static constexpr bool _batched_draws =
+        not std::is_same_v<RNG, Utopia::DefaultRNG>;
+
+    /// The type of a Bernoulli trial using the model's RNG
+    using Trial = BernoulliTrial<RNG>;
+
+    /// Trial for an empty cell to grow a tree
+    const Trial _growth;
+
+    /// Trial for a tree to be hit by lightning
+    const Trial _lightning;
+
+    /// Trial for a tree to be immune to a spreading fire
+    const Trial _immunity;
 
     /// The incremental cluster tag caching variable
     unsigned int _cluster_id_cnt;
 
     /// A temporary container for use in cluster identification
-    std::vector<std::shared_ptr<CellManager::Cell>> _cluster_members;
+    std::vector<std::shared_ptr<Cell>> _cluster_members;
+
+    /// Uniformly distributed numbers for each cell; used for batched draws
+    /** Drawn at the beginning of each step; a cell compares its number
+      * against either p_growth or p_lightning, depending on its kind.
+      */
+    std::vector<double> _draws;
 
     // .. Output-related ......................................................
     /// Whether to _only_ write the tree density
@@ -218,9 +270,12 @@ public:
         _param(this->_cfg),
 
         // Initialize remaining members
-        _prob_distr(0., 1.),
+        _growth(_param.p_growth),
+        _lightning(_param.p_lightning),
+        _immunity(_param.p_immunity),
         _cluster_id_cnt(0),
         _cluster_members(),
+        _draws(_batched_draws ? _cm.cells().size() : 0),
         _write_only_tree_density(get_as<bool>("write_only_tree_density",
                                               this->_cfg)),
 
@@ -230,15 +285,23 @@ public:
         _dset_cluster_id{this->create_cm_dset("cluster_id", _cm)},
         _dset_tree_density{this->create_dset("tree_density", {})}
     {
+        // Register the tree density as observable, such that it is computed
+        // only once per step, even if both monitored and written
+        this->_observables.add("tree_density", [this](){
+            return calculate_tree_density();
+        });
+
         // Cells are already set up in the CellManager.
         // Take care of the heterogeneities now:
 
         // Stones
-        if (_cfg["stones"] and get_as<bool>("enabled", _cfg["stones"])) {
+        if (    this->_cfg["stones"]
+            and get_as<bool>("enabled", this->_cfg["stones"]))
+        {
             this->_log->info("Setting cells to be stones ...");
 
             // Get the container
-            auto to_turn_to_stone = _cm.select_cells(_cfg["stones"]);
+            auto to_turn_to_stone = _cm.select_cells(this->_cfg["stones"]);
 
             // Apply a rule to all cells of that container: turn to stone
             apply_rule<Update::async, Shuffle::off>(
@@ -252,15 +315,16 @@ public:
 
             this->_log->info("Set {} cells to be stones using selection mode "
                              "'{}'.", to_turn_to_stone.size(),
-                             get_as<std::string>("mode", _cfg["stones"]));
+                             get_as<std::string>("mode", this->_cfg["stones"]));
         }
 
         // Ignite some cells permanently: fire sources
-        if (    _cfg["ignite_permanently"]
-            and get_as<bool>("enabled", _cfg["ignite_permanently"]))
+        if (    this->_cfg["ignite_permanently"]
+            and get_as<bool>("enabled", this->_cfg["ignite_permanently"]))
         {
             this->_log->info("Setting cells to be permanently ignited ...");
-            auto to_be_ignited = _cm.select_cells(_cfg["ignite_permanently"]);
+            auto to_be_ignited =
+                _cm.select_cells(this->_cfg["ignite_permanently"]);
 
             apply_rule<Update::async, Shuffle::off>(
                 [](const auto& cell){
@@ -273,7 +337,7 @@ public:
 
             this->_log->info("Set {} cells to be permanently ignited using "
                 "selection mode '{}'.", to_be_ignited.size(),
-                get_as<std::string>("mode", _cfg["ignite_permanently"]));
+                get_as<std::string>("mode", this->_cfg["ignite_permanently"]));
         }
 
         this->_log->debug("{} model fully set up.", this->_name);
@@ -285,19 +349,37 @@ private:
 
     // .. Helper functions ....................................................
     /// Calculate and return the density of tree cells
+    /** \note This is registered as the `tree_density` observable; use that
+     *        to access the density without re-computing it.
+     */
     double calculate_tree_density() const {
-        // NOTE If execution policies are implemented, this could be easily
-        //      made parallel by replacing std::accumulate with std::reduce
-        //      and adding std::execution::par from the header
-        //      <execution> as first argument.
-        return
-            std::accumulate(_cm.cells().begin(), _cm.cells().end(),
-                0,
-                [&](std::size_t sum, const std::shared_ptr<Cell>& cell) {
-                    return sum + (cell->state.kind == Kind::tree);
-                }
-            )
-            / static_cast<double>(_cm.cells().size());
+        const auto count_trees = make_reduction(
+            ExecPolicy::par_unseq, _cm.cells(), std::size_t(0), std::plus<>(),
+            [](const std::shared_ptr<Cell>& cell) -> std::size_t {
+                return cell->state.kind == Kind::tree;
+            }
+        );
+        return count_trees() / static_cast<double>(_cm.cells().size());
+    }
+
+    /// Whether an empty cell grows a tree in this step
+    bool grows (const std::shared_ptr<Cell>& cell) const {
+        if constexpr (_batched_draws) {
+            return _draws[cell->id()] < _param.p_growth;
+        }
+        else {
+            return _growth(*this->_rng);
+        }
+    }
+
+    /// Whether a tree is hit by lightning in this step
+    bool is_struck (const std::shared_ptr<Cell>& cell) const {
+        if constexpr (_batched_draws) {
+            return _draws[cell->id()] < _param.p_lightning;
+        }
+        else {
+            return _lightning(*this->_rng);
+        }
     }
 
     /// Identifies clusters in the cells and labels them with corresponding IDs
@@ -345,7 +427,7 @@ private:
 
         // Empty cells can grow a tree
         if (state.kind == Kind::empty) {
-            if (this->_prob_distr(*this->_rng) < _param.p_growth) {
+            if (grows(cell)) {
                 state.kind = Kind::tree;
             }
         }
@@ -353,7 +435,7 @@ private:
         // Trees can be hit by lightning or continue living
         else if (state.kind == Kind::tree) {
             // Can be hit by lightning
-            if (this->_prob_distr(*this->_rng) < _param.p_lightning) {
+            if (is_struck(cell)) {
                 state = _burn_cluster(cell);
             }
             else {
@@ -407,8 +489,7 @@ private:
                     // ... unless there is p_immunity > 0 ...
                     if (this->_param.p_immunity > 0.) {
                         // ... where there is a chance not to burn:
-                        if (  this->_prob_distr(*this->_rng)
-                            < _param.p_immunity) {
+                        if (_immunity(*this->_rng)) {
                             continue;
                         }
                     }
@@ -477,6 +558,12 @@ public:
 
     /// Perform step
     void perform_step () {
+        // Each cell either grows a tree or can be hit by lightning; draw the
+        // corresponding random numbers at once, if enabled
+        if constexpr (_batched_draws) {
+            fill_uniform(*this->_rng, _draws.begin(), _draws.end());
+        }
+
         // Apply update rule on all cells, asynchronously and shuffled
         apply_rule<Update::async, Shuffle::on>(
             _update, _cm.cells(), *this->_rng
@@ -485,13 +572,15 @@ public:
 
     /// Provide monitoring information to the frontend: `tree_density`
     void monitor () {
-        this->_monitor.set_entry("tree_density", calculate_tree_density());
+        this->_monitor.set_entry("tree_density",
+            this->_observables.template get<double>("tree_density"));
     }
 
     /// Write data
     void write_data () {
         // Calculate and write the tree density
-        _dset_tree_density->write(calculate_tree_density());
+        _dset_tree_density->write(
+            this->_observables.template get<double>("tree_density"));
 
         if (_write_only_tree_density) {
             // Done here.
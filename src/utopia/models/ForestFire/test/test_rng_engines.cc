@@ -0,0 +1,88 @@
+#define BOOST_TEST_MODULE rng engines test
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <boost/mpl/vector.hpp>
+#include <boost/test/unit_test.hpp>
+#include <utopia/core/model.hh>
+#include <utopia/core/rng.hh>
+#include <utopia/data_io/hdffile.hh>
+
+#include "../ForestFire.hh"
+
+namespace Utopia::Models::ForestFire {
+
+using DataIO::HDFFile;
+
+/// The engines the model can be run with, see ForestFire.cc
+/** All but the default engine use batched draws for growth and lightning
+  */
+using Engines = boost::mpl::vector<DefaultRNG, Xoshiro256PlusPlus, PCG64>;
+
+
+// -- Helpers -----------------------------------------------------------------
+
+/// Run ForestFire with the given parameters and return the tree densities
+template<class RNG>
+std::vector<double> run_model (const double p_tree,
+                               const double p_growth,
+                               const double p_lightning,
+                               const std::string& neighborhood)
+{
+    const std::string out_path = "test_rng_engines.h5";
+    {
+        PseudoParent<RNG> pp("test_rng_engines.yml", out_path, 42);
+
+        auto cfg = YAML::Clone(pp.get_cfg()["ForestFire"]);
+        cfg["cell_manager"]["cell_params"]["p_tree"] = p_tree;
+        cfg["cell_manager"]["neighborhood"]["mode"] = neighborhood;
+        cfg["p_growth"] = p_growth;
+        cfg["p_lightning"] = p_lightning;
+
+        ForestFire<ModelTypes<RNG>>("ForestFire", pp, cfg).run();
+
+        // Allow a model of the same name in a subsequent run
+        spdlog::drop("root.ForestFire");
+    }
+
+    HDFFile file(out_path, "r");
+    const auto [shape, densities] = file.open_dataset("ForestFire/tree_density")
+                                        ->template read<std::vector<double>>();
+    BOOST_TEST(shape[0] == 21u);
+
+    file.close();
+    std::remove(out_path.c_str());
+    return densities;
+}
+
+
+// -- Tests -------------------------------------------------------------------
+
+/// Test that empty cells grow trees with the configured probability
+BOOST_AUTO_TEST_CASE_TEMPLATE (growth, RNG, Engines)
+{
+    const auto densities = run_model<RNG>(0., .02, 0., "Moore");
+
+    for (std::size_t t = 0; t < densities.size(); ++t) {
+        BOOST_TEST(std::abs(densities[t] - (1. - std::pow(.98, t))) < .02);
+    }
+
+    // Realizations are reproducible for a given seed
+    BOOST_TEST(run_model<RNG>(0., .02, 0., "Moore") == densities);
+}
+
+/// Test that trees are hit by lightning with the configured probability
+BOOST_AUTO_TEST_CASE_TEMPLATE (lightning, RNG, Engines)
+{
+    // Without neighbors, each tree only burns down itself
+    const auto densities = run_model<RNG>(1., 0., .05, "empty");
+
+    for (std::size_t t = 0; t < densities.size(); ++t) {
+        BOOST_TEST(std::abs(densities[t] - std::pow(.95, t)) < .02);
+    }
+}
+
+} // namespace Utopia::Models::ForestFire
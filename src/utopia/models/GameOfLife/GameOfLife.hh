@@ -5,6 +5,7 @@
 #include <random>
 #include <string>
 #include <algorithm>
+#include <memory>
 
 // third-party library includes
 
@@ -15,6 +16,8 @@
 #include <utopia/core/select.hh>
 #include <utopia/data_io/cfg_utils.hh>
 
+#include "bit_grid.hh"
+
 namespace Utopia::Models::GameOfLife
 {
 // ++ Type definitions ++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -99,6 +102,11 @@ class GameOfLife : public Model<GameOfLife, ModelTypes>
     /// The number of neighbors required to survive
     const NbLifeRule _survive;
 
+    /// The bit-packed grid, if that engine was selected; else nullptr
+    /** If set, the cell states are only updated when writing data.
+     */
+    const std::shared_ptr<BitGrid> _bit_grid;
+
     // .. Temporary objects ...................................................
 
     // .. Datasets ............................................................
@@ -124,6 +132,7 @@ class GameOfLife : public Model<GameOfLife, ModelTypes>
         _rule(get_as<std::string>("rule", this->_cfg)),
         _birth(this->extract_birth_from_rule()),
         _survive(this->extract_survive_from_rule()),
+        _bit_grid(this->setup_bit_grid()),
 
         // Datasets
         // For setting up datasets that store CellManager data, you can use the
@@ -137,6 +146,13 @@ class GameOfLife : public Model<GameOfLife, ModelTypes>
             living_cell->state.living = true;
         }
 
+        // Transfer the initial states to the bit-packed grid
+        if (_bit_grid) {
+            for (const auto& cell : this->_cm.cells()) {
+                _bit_grid->set(cell->id(), cell->state.living);
+            }
+        }
+
         // Initialization should be finished here.
         this->_log->debug("{} model fully set up.", this->_name);
     }
@@ -179,11 +195,60 @@ class GameOfLife : public Model<GameOfLife, ModelTypes>
         return survive;
     }
 
+    /// Set up the bit-packed grid, if the `engine` parameter selects it
+    std::shared_ptr<BitGrid> setup_bit_grid()
+    {
+        const auto engine = get_as<std::string>("engine", this->_cfg,
+                                                "cells");
+        if (engine == "cells") {
+            return nullptr;
+        }
+        else if (engine != "bit_grid") {
+            throw std::invalid_argument("Invalid GameOfLife engine '" + engine
+                + "'! Available engines: cells, bit_grid");
+        }
+
+        const auto& grid = *_cm.grid();
+        const bool moore = (_cm.nb_mode() == NBMode::Moore
+                            and _cm.nb_size() == 8);
+        const bool von_neumann = (_cm.nb_mode() == NBMode::vonNeumann
+                                  and _cm.nb_size() == 4);
+
+        if (grid.structure() != GridStructure::square
+            or not (moore or von_neumann))
+        {
+            throw std::invalid_argument("The bit_grid engine of the GameOfLife "
+                "model requires a square grid with a Moore or vonNeumann "
+                "neighborhood of distance 1!");
+        }
+
+        // Encode the rule as bit masks over the number of living neighbors
+        unsigned birth_mask = 0, survive_mask = 0;
+        for (const auto b : _birth) {
+            birth_mask |= (1u << b);
+        }
+        for (const auto s : _survive) {
+            survive_mask |= (1u << s);
+        }
+
+        this->_log->info("Using the bit-packed grid engine.");
+        const auto shape = grid.shape();
+        return std::make_shared<BitGrid>(
+            shape[0], shape[1], grid.is_periodic(),
+            moore ? BitGrid::Neighborhood::Moore
+                  : BitGrid::Neighborhood::vonNeumann,
+            birth_mask, survive_mask);
+    }
+
     // .. Helper functions ....................................................
 
     /// Calculate the mean of all cells' some_state
     double calculate_living_cell_density() const
     {
+        if (_bit_grid) {
+            return double(_bit_grid->count_living()) / _bit_grid->num_cells();
+        }
+
         double sum = 0.;
         for (const auto& cell : _cm.cells()) {
             sum += cell->state.living;
@@ -234,6 +299,11 @@ class GameOfLife : public Model<GameOfLife, ModelTypes>
     /// Iterate a single step
     void perform_step()
     {
+        if (_bit_grid) {
+            _bit_grid->step();
+            return;
+        }
+
         // Apply the rules to all cells, first the interaction, then the update
         apply_rule<Update::sync>(_life_rule, _cm.cells());
     }
@@ -260,6 +330,13 @@ class GameOfLife : public Model<GameOfLife, ModelTypes>
      */
     void write_data()
     {
+        // Bring the cell states up to date with the bit-packed grid
+        if (_bit_grid) {
+            for (const auto& cell : _cm.cells()) {
+                cell->state.living = _bit_grid->get(cell->id());
+            }
+        }
+
         // Write out the some_state of all cells
         _dset_living->write(_cm.cells().begin(),
                             _cm.cells().end(),
@@ -0,0 +1,277 @@
+#ifndef UTOPIA_MODELS_GAMEOFLIFE_BIT_GRID_HH
+#define UTOPIA_MODELS_GAMEOFLIFE_BIT_GRID_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <utopia/core/parallel.hh>
+
+
+namespace Utopia::Models::GameOfLife {
+
+/// A bit-packed two-dimensional grid of binary cells
+/** Implements life-like (outer-totalistic, two-state) cellular automata on a
+ *  square lattice with a Moore or von Neumann neighborhood of range one. The
+ *  cells are stored as bits, 64 cells per word, row by row; cell (x, y) has
+ *  the ID `x + y * size_x`, matching the cell IDs of the square grid.
+ *
+ *  An iteration step evaluates the rule for 64 cells at once: the neighbor
+ *  counts are accumulated in four bit planes via bitwise adders and compared
+ *  against the birth and survival conditions. The rows are independent of
+ *  each other and are processed with Utopia::ExecPolicy::par_unseq, i.e. in
+ *  parallel if parallel execution is enabled.
+ */
+class BitGrid
+{
+public:
+    /// The type of a word of cells
+    using Word = std::uint64_t;
+
+    /// The number of cells per word
+    static constexpr std::size_t bits_per_word = 64;
+
+    /// Supported neighborhoods
+    enum class Neighborhood { Moore, vonNeumann };
+
+private:
+    /// The number of cells in x-direction
+    const std::size_t _size_x;
+
+    /// The number of cells in y-direction
+    const std::size_t _size_y;
+
+    /// Whether the boundaries are periodic; otherwise, outside cells are dead
+    const bool _periodic;
+
+    /// The neighborhood used for counting living neighbors
+    const Neighborhood _nb;
+
+    /// Bit i is set if a dead cell with i living neighbors gets born
+    const unsigned _birth_mask;
+
+    /// Bit i is set if a living cell with i living neighbors survives
+    const unsigned _survive_mask;
+
+    /// The number of words per row
+    const std::size_t _words_per_row;
+
+    /// Mask of the valid bits in the last word of each row
+    const Word _last_word_mask;
+
+    /// The current cell states
+    std::vector<Word> _cells;
+
+    /// The buffer for the new cell states
+    std::vector<Word> _cells_new;
+
+    /// The row indices, used for (parallel) iteration over rows
+    std::vector<std::size_t> _rows;
+
+public:
+    /// Construct a bit grid with all cells dead
+    /** \param size_x        Number of cells in x-direction
+     *  \param size_y        Number of cells in y-direction
+     *  \param periodic      Whether the boundaries are periodic
+     *  \param nb            The neighborhood
+     *  \param birth_mask    Bit i set: a dead cell with i living neighbors
+     *                       gets born
+     *  \param survive_mask  Bit i set: a living cell with i living neighbors
+     *                       survives
+     */
+    BitGrid (const std::size_t size_x,
+             const std::size_t size_y,
+             const bool periodic,
+             const Neighborhood nb,
+             const unsigned birth_mask,
+             const unsigned survive_mask)
+    :
+        _size_x(size_x),
+        _size_y(size_y),
+        _periodic(periodic),
+        _nb(nb),
+        _birth_mask(birth_mask),
+        _survive_mask(survive_mask),
+        _words_per_row((size_x + bits_per_word - 1) / bits_per_word),
+        _last_word_mask(
+            (size_x % bits_per_word == 0)
+                ? ~Word(0) : (Word(1) << (size_x % bits_per_word)) - 1),
+        _cells(_words_per_row * size_y, 0),
+        _cells_new(_cells.size(), 0),
+        _rows(size_y)
+    {
+        if (size_x == 0 or size_y == 0) {
+            throw std::invalid_argument("BitGrid needs a non-zero extent in "
+                                        "both directions!");
+        }
+        if ((birth_mask | survive_mask) >> (max_neighbors() + 1)) {
+            throw std::invalid_argument("The birth or survival condition of "
+                "the BitGrid requires more than the "
+                + std::to_string(max_neighbors()) + " neighbors available in "
+                "the selected neighborhood!");
+        }
+        std::iota(_rows.begin(), _rows.end(), 0);
+    }
+
+    /// The number of cells
+    std::size_t num_cells () const {
+        return _size_x * _size_y;
+    }
+
+    /// The number of neighbors of each cell
+    unsigned max_neighbors () const {
+        return (_nb == Neighborhood::Moore) ? 8 : 4;
+    }
+
+    /// Whether the cell with the given ID is living
+    bool get (const std::size_t id) const {
+        const auto [w, bit] = locate(id);
+        return (_cells[w] >> bit) & Word(1);
+    }
+
+    /// Set the state of the cell with the given ID
+    void set (const std::size_t id, const bool living) {
+        const auto [w, bit] = locate(id);
+        if (living) {
+            _cells[w] |= (Word(1) << bit);
+        }
+        else {
+            _cells[w] &= ~(Word(1) << bit);
+        }
+    }
+
+    /// The number of living cells
+    std::size_t count_living () const {
+        std::size_t count = 0;
+        for (const auto word : _cells) {
+            count += __builtin_popcountll(word);
+        }
+        return count;
+    }
+
+    /// Apply the rule once to all cells (synchronously)
+    void step () {
+        std::for_each(ExecPolicy::par_unseq, _rows.begin(), _rows.end(),
+                      [this](const std::size_t y){ step_row(y); });
+        std::swap(_cells, _cells_new);
+    }
+
+private:
+    /// Compute the word and bit index of a cell
+    std::pair<std::size_t, std::size_t> locate (const std::size_t id) const {
+        const auto x = id % _size_x;
+        const auto y = id / _size_x;
+        return {y * _words_per_row + x / bits_per_word, x % bits_per_word};
+    }
+
+    /// Pointer to the first word of a row, or nullptr for outside rows
+    const Word* row_ptr (const std::size_t y, const int offset) const {
+        if (offset < 0 and y == 0) {
+            return _periodic ? &_cells[(_size_y - 1) * _words_per_row]
+                             : nullptr;
+        }
+        if (offset > 0 and y == _size_y - 1) {
+            return _periodic ? &_cells[0] : nullptr;
+        }
+        return &_cells[(y + offset) * _words_per_row];
+    }
+
+    /// The state of the cell in a row that is left of the first cell
+    Word wrap_left (const Word* row) const {
+        if (not _periodic) {
+            return 0;
+        }
+        const auto x = _size_x - 1;
+        return (row[x / bits_per_word] >> (x % bits_per_word)) & Word(1);
+    }
+
+    /// The state of the cell in a row that is right of the last cell
+    Word wrap_right (const Word* row) const {
+        return _periodic ? (row[0] & Word(1)) : 0;
+    }
+
+    /// Word w of the row with each bit holding the state of its left neighbor
+    Word west (const Word* row, const std::size_t w) const {
+        const Word carry = (w == 0) ? wrap_left(row)
+                                    : (row[w - 1] >> (bits_per_word - 1));
+        return (row[w] << 1) | carry;
+    }
+
+    /// Word w of the row with each bit holding the state of its right neighbor
+    Word east (const Word* row, const std::size_t w) const {
+        if (w + 1 < _words_per_row) {
+            return (row[w] >> 1) | (row[w + 1] << (bits_per_word - 1));
+        }
+        // Last word: the padding bits are zero, insert the wrapped cell
+        const auto last_bit = (_size_x - 1) % bits_per_word;
+        return (row[w] >> 1) | (wrap_right(row) << last_bit);
+    }
+
+    /// Compute the new states of a row of cells
+    void step_row (const std::size_t y) {
+        const Word* row = &_cells[y * _words_per_row];
+        const Word* north = row_ptr(y, +1);
+        const Word* south = row_ptr(y, -1);
+        Word* row_new = &_cells_new[y * _words_per_row];
+
+        for (std::size_t w = 0; w < _words_per_row; w++) {
+            // Bit planes of the neighbor count
+            Word s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+            auto add = [&](const Word x) {
+                const Word c0 = s0 & x;
+                s0 ^= x;
+                const Word c1 = s1 & c0;
+                s1 ^= c0;
+                const Word c2 = s2 & c1;
+                s2 ^= c1;
+                s3 |= c2;
+            };
+
+            add(west(row, w));
+            add(east(row, w));
+            if (north) {
+                add(north[w]);
+                if (_nb == Neighborhood::Moore) {
+                    add(west(north, w));
+                    add(east(north, w));
+                }
+            }
+            if (south) {
+                add(south[w]);
+                if (_nb == Neighborhood::Moore) {
+                    add(west(south, w));
+                    add(east(south, w));
+                }
+            }
+
+            // Evaluate the birth and survival conditions
+            const Word alive = row[w];
+            Word born = 0, survives = 0;
+            for (unsigned n = 0; n <= max_neighbors(); n++) {
+                const Word eq = ((n & 1u) ? s0 : ~s0)
+                              & ((n & 2u) ? s1 : ~s1)
+                              & ((n & 4u) ? s2 : ~s2)
+                              & ((n & 8u) ? s3 : ~s3);
+                if ((_birth_mask >> n) & 1u) {
+                    born |= eq;
+                }
+                if ((_survive_mask >> n) & 1u) {
+                    survives |= eq;
+                }
+            }
+
+            Word word_new = (alive & survives) | (~alive & born);
+            if (w + 1 == _words_per_row) {
+                word_new &= _last_word_mask;
+            }
+            row_new[w] = word_new;
+        }
+    }
+};
+
+} // namespace Utopia::Models::GameOfLife
+
+#endif // UTOPIA_MODELS_GAMEOFLIFE_BIT_GRID_HH
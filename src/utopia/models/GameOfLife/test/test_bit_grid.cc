@@ -0,0 +1,136 @@
+#define BOOST_TEST_MODULE bit grid test
+
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include "../bit_grid.hh"
+
+namespace Utopia::Models::GameOfLife {
+
+using NB = BitGrid::Neighborhood;
+
+// -- Helpers -----------------------------------------------------------------
+
+/// A straightforward implementation of a life-like rule, for comparison
+std::vector<bool> reference_step (const std::vector<bool>& cells,
+                                  const std::size_t size_x,
+                                  const std::size_t size_y,
+                                  const bool periodic,
+                                  const NB nb,
+                                  const unsigned birth_mask,
+                                  const unsigned survive_mask)
+{
+    auto living = [&](long x, long y) -> unsigned {
+        if (periodic) {
+            x = (x + size_x) % size_x;
+            y = (y + size_y) % size_y;
+        }
+        else if (   x < 0 or y < 0
+                 or x >= long(size_x) or y >= long(size_y))
+        {
+            return 0;
+        }
+        return cells[x + y * size_x];
+    };
+
+    std::vector<bool> cells_new(cells.size());
+    for (long y = 0; y < long(size_y); y++) {
+        for (long x = 0; x < long(size_x); x++) {
+            unsigned n = (  living(x - 1, y) + living(x + 1, y)
+                          + living(x, y - 1) + living(x, y + 1));
+            if (nb == NB::Moore) {
+                n += (  living(x - 1, y - 1) + living(x + 1, y - 1)
+                      + living(x - 1, y + 1) + living(x + 1, y + 1));
+            }
+            const auto mask = cells[x + y * size_x] ? survive_mask
+                                                     : birth_mask;
+            cells_new[x + y * size_x] = (mask >> n) & 1u;
+        }
+    }
+    return cells_new;
+}
+
+// -- Tests -------------------------------------------------------------------
+
+/// Compare the bit grid with the reference for various shapes and settings
+BOOST_AUTO_TEST_CASE(compare_with_reference)
+{
+    std::mt19937 rng(42);
+    std::bernoulli_distribution coin(0.3);
+
+    // Game of Life (3/23) and a vonNeumann-compatible rule (1/13)
+    const unsigned gol_birth = 1u << 3, gol_survive = (1u << 2) | (1u << 3);
+    const unsigned vn_birth = 1u << 1, vn_survive = (1u << 1) | (1u << 3);
+
+    for (const auto [size_x, size_y] : {std::pair<std::size_t,std::size_t>
+                                            {5, 7}, {64, 3}, {65, 4},
+                                            {130, 9}, {128, 1}, {1, 5}})
+    {
+        for (const bool periodic : {true, false}) {
+            for (const auto nb : {NB::Moore, NB::vonNeumann}) {
+                const auto birth = (nb == NB::Moore) ? gol_birth : vn_birth;
+                const auto survive = (nb == NB::Moore) ? gol_survive
+                                                       : vn_survive;
+
+                BitGrid grid(size_x, size_y, periodic, nb, birth, survive);
+                std::vector<bool> cells(size_x * size_y);
+                for (std::size_t i = 0; i < cells.size(); i++) {
+                    cells[i] = coin(rng);
+                    grid.set(i, cells[i]);
+                }
+
+                for (unsigned step = 0; step < 10; step++) {
+                    cells = reference_step(cells, size_x, size_y, periodic,
+                                           nb, birth, survive);
+                    grid.step();
+
+                    std::size_t mismatches = 0, num_living = 0;
+                    for (std::size_t i = 0; i < cells.size(); i++) {
+                        mismatches += (grid.get(i) != cells[i]);
+                        num_living += cells[i];
+                    }
+                    BOOST_TEST(mismatches == 0);
+                    BOOST_TEST(grid.count_living() == num_living);
+                }
+            }
+        }
+    }
+}
+
+/// A glider moves diagonally through the periodic grid
+BOOST_AUTO_TEST_CASE(glider)
+{
+    const std::size_t size = 70;
+    BitGrid grid(size, size, true, NB::Moore,
+                 1u << 3, (1u << 2) | (1u << 3));
+
+    // A glider moving towards increasing x and y
+    for (const auto [x, y] : {std::pair<std::size_t,std::size_t>
+                                  {1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}})
+    {
+        grid.set(x + y * size, true);
+    }
+
+    // After 4 * size steps, it is back at its original place
+    for (std::size_t i = 0; i < 4 * size; i++) {
+        grid.step();
+        BOOST_TEST(grid.count_living() == 5);
+    }
+    BOOST_TEST(grid.get(1));
+    BOOST_TEST(grid.get(2 + size));
+    BOOST_TEST(grid.get(2 + 2 * size));
+}
+
+/// Invalid arguments are rejected
+BOOST_AUTO_TEST_CASE(invalid_args)
+{
+    BOOST_CHECK_THROW(BitGrid(0, 3, true, NB::Moore, 0, 0),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(BitGrid(3, 3, true, NB::vonNeumann, 1u << 5, 0),
+                      std::invalid_argument);
+}
+
+} // namespace Utopia::Models::GameOfLife
@@ -283,11 +283,13 @@ private:
 
         // Initialize altitude as an inclined plane
         // (by making use of coordinates)
-        RuleFunc set_inclined_plane = [this](const auto& cell) {
+        // Read the slope once rather than once per cell
+        const auto slope = get_as<double>("initial_slope",
+                                          this->_cfg["cell_manager"]
+                                                    ["cell_params"]);
+        RuleFunc set_inclined_plane = [this, slope](const auto& cell) {
             auto state = cell->state;
             auto pos = _cm.barycenter_of(cell);
-            double slope = get_as<double>("initial_slope",
-                                this->_cfg["cell_manager"]["cell_params"]);
             state.rock += slope*pos[1];
             if (state.rock < _float_precision) {
                 std::uniform_real_distribution<> dist(0.,1e-5);
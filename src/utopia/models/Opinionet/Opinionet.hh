@@ -96,6 +96,9 @@ public:
     /// Data type of the shared RNG
     using RNG = typename Base::RNG;
 
+    /// Data type of the writer for edge deltas of the rewiring network
+    using EdgeDeltaWriter = DataIO::GraphDeltaWriter<NWType>;
+
 private:
     // Base members: _time, _name, _cfg, _hdfgrp, _rng, _monitor, _log, _space
 
@@ -118,6 +121,9 @@ private:
     const std::shared_ptr<DataSet> _dset_opinion;
     const std::shared_ptr<DataSet> _dset_edge_weights;
 
+    /// Writes only the changed edges if rewiring and delta mode are enabled
+    const std::shared_ptr<EdgeDeltaWriter> _edge_delta_writer;
+
 public:
     /// Construct the Opinionet model
     /** \param name     Name of this model instance
@@ -145,7 +151,8 @@ public:
         _dgrp_nw(create_graph_group(_nw, this->_hdfgrp, "nw")),
         _dset_opinion(this->create_dset("opinion", _dgrp_nw,
                                         {boost::num_vertices(_nw)})),
-        _dset_edge_weights(this->create_edge_weight_dset())
+        _dset_edge_weights(this->create_edge_weight_dset()),
+        _edge_delta_writer(this->create_edge_delta_writer())
     {
         this->_log->debug("Constructing the Opinionet Model ...");
 
@@ -165,6 +172,11 @@ public:
         _dset_opinion->add_attribute("dim_name__1", "vertex_idx");
         _dset_opinion->add_attribute("coords_mode__vertex_idx", "trivial");
 
+        if (_edge_delta_writer and _dset_edge_weights) {
+            _dset_edge_weights->add_attribute("edge_order",
+                                              "sorted_by_source_target");
+        }
+
         if (_rewire == Rewiring::RewiringOff) {
             save_graph(_nw, _dgrp_nw);
             this->_log->debug("Network saved.");
@@ -293,6 +305,23 @@ private:
         }
     }
 
+    // Only create the edge delta writer if rewiring and delta mode are on
+    std::shared_ptr<EdgeDeltaWriter> create_edge_delta_writer() {
+        const auto& edge_cfg = this->_cfg["network"]["edges"];
+
+        if (    _rewire == Rewiring::RewiringOn
+            and get_as<std::string>("write_mode", edge_cfg) == "delta")
+        {
+            return std::make_shared<EdgeDeltaWriter>(
+                _nw, _dgrp_nw,
+                get_as<std::size_t>("keyframe_interval", edge_cfg)
+            );
+        }
+        else {
+            return nullptr;
+        }
+    }
+
 
 public:
 
@@ -374,7 +403,11 @@ public:
         );
 
         // Write edges
-        if (_rewire == Rewiring::RewiringOn){
+        if (_edge_delta_writer) {
+            // Only write the edges that changed since the last write
+            _edge_delta_writer->write(_nw, this->get_time());
+        }
+        else if (_rewire == Rewiring::RewiringOn){
             // Adaptor tuple that allows to save the edge data
             const auto get_edge_data = std::make_tuple(
                 std::make_tuple("_edges", "type",
@@ -402,12 +435,18 @@ public:
 
         // Write edge weights
         if constexpr (Utils::is_directed<NWType>()) {
+            auto get_weight = [this](auto ed) { return _nw[ed].weight; };
 
-            auto [e, e_end] = boost::edges(_nw);
-
-            _dset_edge_weights->write(
-                e, e_end, [this](auto ed) { return _nw[ed].weight; }
-            );
+            // In delta mode, the weights need to be in the order of the
+            // reconstructed edge lists, i.e. sorted by (source, target)
+            if (_edge_delta_writer) {
+                const auto& eds = _edge_delta_writer->edge_descriptors();
+                _dset_edge_weights->write(eds.begin(), eds.end(), get_weight);
+            }
+            else {
+                auto [e, e_end] = boost::edges(_nw);
+                _dset_edge_weights->write(e, e_end, get_weight);
+            }
         }
     }
 
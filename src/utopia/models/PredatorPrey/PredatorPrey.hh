@@ -8,6 +8,7 @@
 #include <utopia/core/apply.hh>
 #include <utopia/core/model.hh>
 #include <utopia/core/cell_manager.hh>
+#include <utopia/data_io/cfg_schema.hh>
 
 #include "species.hh"
 
@@ -29,9 +30,55 @@ struct State {
     /// Flag to indicate if the predator on this cell has already moved  
     bool moved_predator;
 
-    /// Construct a cell state with the use of a RNG
+    /// The species-specific parameters needed to construct a cell state
+    struct SpeciesParams {
+        /// The initial resources of an individual
+        double init_resources;
+    };
+
+    /// The parameters needed to construct a cell state
+    struct Params {
+        /// The probability for a cell to initially host a prey
+        double p_prey;
+
+        /// The probability for a cell to initially host a predator
+        double p_predator;
+
+        /// The prey-specific parameters
+        SpeciesParams prey;
+
+        /// The predator-specific parameters
+        SpeciesParams predator;
+
+        /// Default-construct the parameters; required by ConfigSchema
+        Params () = default;
+
+        /// Extract the parameters from the ``cell_params`` node
+        Params (const DataIO::Config& cfg)
+        :
+            Params(schema().parse(cfg))
+        {}
+
+        /// The schema used to parse and validate the parameters
+        static const ConfigSchema<Params>& schema () {
+            static const auto species_schema =
+                ConfigSchema<SpeciesParams>("species cell_params")
+                .required("init_resources", &SpeciesParams::init_resources,
+                          is_non_negative<double>());
+
+            static const auto schema = ConfigSchema<Params>("cell_params")
+                .required("p_prey", &Params::p_prey, is_probability())
+                .required("p_predator", &Params::p_predator,
+                          is_probability())
+                .nested("prey", &Params::prey, species_schema)
+                .nested("predator", &Params::predator, species_schema);
+            return schema;
+        }
+    };
+
+    /// Construct a cell state from parsed parameters and an RNG
     template<class RNGType>
-    State(const DataIO::Config& cfg, const std::shared_ptr<RNGType>& rng)
+    State(const Params& params, RNGType& rng)
     :
         predator{},
         prey{},
@@ -39,25 +86,26 @@ struct State {
     {
         std::uniform_real_distribution<double> dist(0., 1.);
 
-        // Get the threshold probability value
-        const auto p_prey = get_as<double>("p_prey", cfg);
-        const auto p_predator = get_as<double>("p_predator", cfg);
-
         // Set a prey on a cell with the given probability by generating a
         // random number in [0, 1) and compare it to wanted probability.
-        if (dist(*rng) < p_prey){
+        if (dist(rng) < params.p_prey){
             prey.on_cell = true;
-            prey.resources = get_as<double>("init_resources",
-                                            cfg["prey"]);
+            prey.resources = params.prey.init_resources;
         }
 
         // Set a predator on a cell with the given probability.
-        if (dist(*rng) < p_predator){
+        if (dist(rng) < params.p_predator){
             predator.on_cell = true;
-            predator.resources = get_as<double>("init_resources",
-                                                cfg["predator"]);
+            predator.resources = params.predator.init_resources;
         }
     }
+
+    /// Construct a cell state with the use of a RNG
+    template<class RNGType>
+    State(const DataIO::Config& cfg, const std::shared_ptr<RNGType>& rng)
+    :
+        State(Params(cfg), *rng)
+    {}
 };
 
 
@@ -61,6 +61,9 @@ class SEIRD : public Model<SEIRD, CDTypes>
     /// Rule function type
     using RuleFunc = typename CellManager::RuleFunc;
 
+    /// The type of the densities array, indexed by Kind
+    using Densities = std::array<double, static_cast<char>(Kind::COUNT)>;
+
   private:
     // Base members: _time, _name, _cfg, _hdfgrp, _rng, _monitor, _space
     // ... but you should definitely check out the documentation ;)
@@ -85,13 +88,20 @@ class SEIRD : public Model<SEIRD, CDTypes>
     /** Array indices are linked to \ref Utopia::Models::SEIRD::Kind
      *
      * \warning This array is used for temporary storage; it is not
-     *          automatically updated but only upon write operations.
+     *          automatically updated but only upon write operations. Use
+     *          the `densities` observable to access the current values.
      */
-    std::array<double, static_cast<char>(Kind::COUNT)> _densities;
+    Densities _densities;
 
     /// *Cumulative* counters for state transitions and other events
     Counters<std::size_t> _counts;
 
+    /// Monitor entry for the densities of all states
+    DataIO::MonitorEntry _mtr_densities;
+
+    /// Monitor entry for the cumulative counters
+    DataIO::MonitorEntry _mtr_counts;
+
 
     // .. Data-Output related members .........................................
     /// The compression level used for all datasets
@@ -152,6 +162,8 @@ class SEIRD : public Model<SEIRD, CDTypes>
         _cluster_members(),
         _densities{},  // undefined here, will be set in constructor body
         _counts{},
+        _mtr_densities(this->_monitor.register_entry("densities")),
+        _mtr_counts(this->_monitor.register_entry("counts")),
 
         // Data output . . . . . . . . . . . . . . . . . . . . . . . . . . . .
         // Get output-related parameters
@@ -182,6 +194,13 @@ class SEIRD : public Model<SEIRD, CDTypes>
         // Make sure the densities are not undefined
         _densities.fill(std::numeric_limits<double>::quiet_NaN());
 
+        // Register the densities as observable, such that they are computed
+        // only once per step, even if both monitored and written
+        this->_observables.add("densities", [this](){
+            update_densities();
+            return _densities;
+        });
+
         // Cells are already set up by the CellManager.
         // Remaining initialization steps regard only macroscopic quantities,
         // e.g. the setup of heterogeneities: Inert cells and infection source.
@@ -816,17 +835,19 @@ class SEIRD : public Model<SEIRD, CDTypes>
      */
     void monitor()
     {
-        update_densities();
-        this->_monitor.set_entry("densities", _densities);
-        this->_monitor.set_entry("counts", _counts.counts());
+        _mtr_densities.set(
+            this->_observables.template get<Densities>("densities"));
+        _mtr_counts.set(_counts.counts());
     }
 
     /// Write data
     void write_data()
     {
-        // Update densities and write them
-        update_densities();
-        _dset_densities->write(_densities);
+        // Get the densities of this step and write them
+        auto densities = this->_observables.template get<Densities>(
+            "densities"
+        );
+        _dset_densities->write(densities);
 
         // Store the counts
         _dset_counts->write(_counts.counts());
@@ -89,6 +89,12 @@ private:
     std::uniform_real_distribution<double> _noise_distr;
 
 
+    // .. Monitor entries .....................................................
+    DataIO::MonitorEntry _mtr_orientation_mean;
+    DataIO::MonitorEntry _mtr_orientation_std;
+    DataIO::MonitorEntry _mtr_norm_group_velocity;
+
+
     // .. Output-related ......................................................
     /// Whether to store agent-specific data
     bool _store_agent_data;
@@ -133,6 +139,15 @@ public:
 
     ,   _noise_distr(-_noise_level/2., +_noise_level/2.)
 
+    // .. Monitor entries .....................................................
+    ,   _mtr_orientation_mean(
+            this->_monitor.register_entry("orientation_mean")
+        )
+    ,   _mtr_orientation_std(this->_monitor.register_entry("orientation_std"))
+    ,   _mtr_norm_group_velocity(
+            this->_monitor.register_entry("norm_group_velocity")
+        )
+
     // .. Output-related ......................................................
     ,   _store_agent_data(get_as<bool>("store_agent_data", this->_cfg))
 
@@ -152,6 +167,24 @@ public:
     {
         set_agent_speed(_speed);
 
+        // Register the global observables, such that they are computed only
+        // once per step, even if both monitored and written
+        this->_observables.add("orientations", [this](){
+            return get_from_agents([](const auto& agent){
+                return agent->state().get_orientation();
+            });
+        });
+        this->_observables.add("orientation_circ_stats", [this](){
+            return circular_mean_and_std(
+                this->_observables.template get<std::vector<double>>(
+                    "orientations"
+                )
+            );
+        });
+        this->_observables.add("norm_group_velocity", [this](){
+            return norm_group_velocity();
+        });
+
         this->_log->info("{} all set up.", this->_name);
         this->_log->info("  Store agent data?  {}", _store_agent_data);
     }
@@ -172,6 +205,9 @@ public:
     void perform_step () {
         apply_rule(_adjust_orientation, _am.agents());
         apply_rule(_move, _am.agents());
+
+        // Keep agents that are close in space close in the agents container
+        _am.sort_agents_periodically();
     }
 
 
@@ -182,53 +218,52 @@ public:
       * represents the system's order parameter.
       */
     void monitor () {
-        const auto orientations = get_from_agents([](const auto& agent){
-            return agent->state().get_orientation();
-        });
-
-        const auto [circ_mean, circ_std] = circular_mean_and_std(orientations);
-        this->_monitor.set_entry("orientation_mean", circ_mean);
-        this->_monitor.set_entry("orientation_std", circ_std);
-        this->_monitor.set_entry("norm_group_velocity", norm_group_velocity());
+        const auto [circ_mean, circ_std] = get_orientation_circ_stats();
+        _mtr_orientation_mean.set(circ_mean);
+        _mtr_orientation_std.set(circ_std);
+        _mtr_norm_group_velocity.set(
+            this->_observables.template get<double>("norm_group_velocity"));
     }
 
 
     /// Write data
     void write_data () {
         using WriteT = float;
-        const auto& agents = _am.agents();
 
         // -- Global observables
-        const auto orientations = get_from_agents([](const auto& agent){
-            return agent->state().get_orientation();
-        });
-
-        const auto [circ_mean, circ_std] = circular_mean_and_std(orientations);
+        const auto [circ_mean, circ_std] = get_orientation_circ_stats();
         _dset_orientation_circmean->write(circ_mean);
         _dset_orientation_circstd->write(circ_std);
 
-        _dset_norm_group_velocity->write(norm_group_velocity());
+        _dset_norm_group_velocity->write(
+            this->_observables.template get<double>("norm_group_velocity"));
 
         // -- Agent-specific data
         // ... only stored optionally
         if (not _store_agent_data) return;
 
+        // Write in order of the agent IDs, which is independent of the order
+        // of the agents container, see AgentManager::sort_agents
+        const auto& agents = _am.agents();
+        const auto idcs = _am.agent_idcs_by_id();
+
         _dset_agent_x->write(
-            agents.begin(), agents.end(),
-            [](const auto& agent) {
-                return static_cast<WriteT>(agent->position()[0]);
+            idcs.begin(), idcs.end(),
+            [&agents](const auto idx) {
+                return static_cast<WriteT>(agents[idx]->position()[0]);
         });
 
         _dset_agent_y->write(
-            agents.begin(), agents.end(),
-            [](const auto& agent) {
-                return static_cast<WriteT>(agent->position()[1]);
+            idcs.begin(), idcs.end(),
+            [&agents](const auto idx) {
+                return static_cast<WriteT>(agents[idx]->position()[1]);
         });
 
         _dset_agent_orientation->write(
-            orientations.begin(), orientations.end(),
-            [](const auto& orientation) {
-                return static_cast<WriteT>(orientation);
+            idcs.begin(), idcs.end(),
+            [&agents](const auto idx) {
+                return static_cast<WriteT>(
+                    agents[idx]->state().get_orientation());
         });
     }
 
@@ -270,6 +305,15 @@ public:
         return absolute_group_velocity(velocities) / std::fabs(_speed);
     }
 
+    /// The circular mean and standard deviation of the agent orientations
+    /** This is the cached value of the `orientation_circ_stats` observable.
+     */
+    const std::pair<double, double>& get_orientation_circ_stats () {
+        return this->_observables.template get<std::pair<double, double>>(
+            "orientation_circ_stats"
+        );
+    }
+
     /// Aggregate agent properties into a container
     template<
         class Adapter,
@@ -169,7 +169,8 @@ public:
     /// Iterate a single step
     void perform_step ()
     {
-        apply_rule(_growth_seeding, _cm.cells());
+        // The rule returns the full new state, so the buffers can be swapped
+        apply_rule<StateBuffer::swap>(_growth_seeding, _cm.cells());
     }
 
     /// Write the cell states (aka plant bio-mass)
@@ -0,0 +1,107 @@
+#define BOOST_TEST_MODULE agent cell index test
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <utopia/core/agent_cell_index.hh>
+#include <utopia/data_io/cfg_utils.hh>
+
+#include "agent_manager_test.hh"
+#include "cell_manager_test.hh"
+
+// -- Types -------------------------------------------------------------------
+
+using namespace Utopia;
+using Utopia::DataIO::Config;
+using SpaceVec = Utopia::SpaceVecType<2>;
+
+template<class T>
+using CMMockModel = Utopia::Test::CellManager::MockModel<T>;
+
+template<class T>
+using AMMockModel = Utopia::Test::AgentManager::MockModel<T>;
+
+using TestCellTraits = Utopia::CellTraits<int, Update::manual, true>;
+using TestAgentTraits = Utopia::AgentTraits<int, Update::async, true>;
+
+using CM = decltype(CMMockModel<TestCellTraits>::_cm);
+using AM = decltype(AMMockModel<TestAgentTraits>::_am);
+
+// -- Fixtures ----------------------------------------------------------------
+
+struct ModelFixture {
+    Config cfg;
+    CMMockModel<TestCellTraits> mm_cm;
+    AMMockModel<TestAgentTraits> mm_am;
+
+    ModelFixture ()
+    :
+        cfg(YAML::LoadFile("agent_cell_index_test.yml")),
+        mm_cm("mm_cm", cfg["model"]),
+        mm_am("mm_am", cfg["model"])
+    {}
+};
+
+// -- Tests -------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(buckets, ModelFixture)
+{
+    auto& cm = mm_cm._cm;
+    auto& am = mm_am._am;
+
+    AgentCellIndex<AM, CM> idx(am, cm);
+    BOOST_TEST(idx.agents().size() == am.agents().size());
+
+    // Each agent is in the bucket of the cell it is located in
+    std::size_t total = 0;
+    for (const auto& cell : cm.cells()) {
+        for (const auto& agent : idx.agents_in(cell)) {
+            BOOST_TEST(cm.cell_at(agent->position()) == cell);
+            BOOST_TEST(idx.cell_of(agent) == cell);
+        }
+        total += idx.num_agents_in(cell);
+    }
+    BOOST_TEST(total == am.agents().size());
+
+    // Out of range cell ID
+    BOOST_CHECK_THROW(idx.agents_in(cm.cells().size()),
+                      std::invalid_argument);
+
+    // Move all agents into one cell and add one; buckets change on update
+    for (const auto& agent : am.agents()) {
+        am.move_to(agent, SpaceVec({0.5, 0.5}));
+    }
+    am.add_agent(0, SpaceVec({1.5, 0.5}));
+
+    const auto& cell_0 = cm.cell_at(SpaceVec({0.5, 0.5}));
+    const auto& cell_1 = cm.cell_at(SpaceVec({1.5, 0.5}));
+    BOOST_TEST(not idx.is_up_to_date());
+    BOOST_CHECK_THROW(idx.num_agents_in(cell_0), std::runtime_error);
+    BOOST_CHECK_THROW(idx.agents_in_neighborhood(cell_0), std::runtime_error);
+
+    idx.update();
+    BOOST_TEST(idx.is_up_to_date());
+    BOOST_TEST(idx.num_agents_in(cell_0) == 200);
+    BOOST_TEST(idx.num_agents_in(cell_1) == 1);
+    BOOST_TEST(idx.agents_in(cell_1).front() == am.agents().back());
+
+    // Neighborhood query: the two cells are von Neumann neighbors
+    BOOST_TEST(idx.agents_in_neighborhood(cell_0).size() == 201);
+    BOOST_TEST(idx.agents_in_neighborhood(cell_0, false).size() == 1);
+    BOOST_TEST(idx.agents_in_neighborhood(cell_1, false).size() == 200);
+
+    const auto& cell_far = cm.cell_at(SpaceVec({2.5, 2.5}));
+    BOOST_TEST(idx.agents_in_neighborhood(cell_far).empty());
+
+    // The output buffer is cleared and reused
+    AgentContainer<AM::Agent> nb_agents;
+    idx.agents_in_neighborhood(cell_0, nb_agents);
+    BOOST_TEST(nb_agents.size() == 201);
+    idx.agents_in_neighborhood(cell_1, nb_agents, false);
+    BOOST_TEST(nb_agents.size() == 200);
+
+    // Removing agents also makes the index outdated
+    am.remove_agent(am.agents().back());
+    BOOST_CHECK_THROW(idx.agents(), std::runtime_error);
+    idx.update();
+    BOOST_TEST(idx.num_agents_in(cell_1) == 0);
+}
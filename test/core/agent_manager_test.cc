@@ -193,6 +193,50 @@ BOOST_FIXTURE_TEST_CASE(test_add_and_remove_agent, Infrastructure) {
     };
 }
 
+BOOST_FIXTURE_TEST_CASE(test_agent_lookup_and_scheduling, Infrastructure) {
+    MockModel<AgentTraitsDC> mm("mm_scheduling", cfg["default"]);
+    auto& am = mm._am;
+
+    // Lookup via ID
+    BOOST_TEST(am.contains_agent(3));
+    BOOST_TEST(am.agent_by_id(3)->id() == 3);
+    BOOST_CHECK_THROW(am.agent_by_id(1000), std::invalid_argument);
+
+    // Removal swaps the last agent into the gap; lookup still works
+    const auto first = am.agents().front();
+    am.remove_agent(first);
+    BOOST_TEST(am.agents().size() == 41);
+    BOOST_TEST(not am.contains_agent(first->id()));
+    BOOST_TEST(am.agents().front()->id() == 41);
+    for (const auto& agent : am.agents()) {
+        BOOST_TEST(am.agent_by_id(agent->id()) == agent);
+    }
+    BOOST_CHECK_THROW(am.remove_agent(first), std::invalid_argument);
+
+    // Scheduled changes are applied only on request
+    const auto victim = am.agent_by_id(10);
+    am.schedule_remove_agent(victim);
+    am.schedule_remove_agent(victim);
+    am.schedule_add_agent(AgentStateDC(), SpaceVec({0.1, 0.2}));
+    am.schedule_add_agent(AgentStateDC(), SpaceVec({0.3, 0.4}));
+    BOOST_TEST(am.agents().size() == 41);
+    BOOST_CHECK_THROW(am.schedule_remove_agent(first), std::invalid_argument);
+
+    am.apply_scheduled_changes();
+    BOOST_TEST(am.agents().size() == 42);
+    BOOST_TEST(not am.contains_agent(10));
+    BOOST_TEST(am.contains_agent(42));
+    BOOST_TEST(am.contains_agent(43));
+    BOOST_TEST(am.agent_by_id(43)->position()[0] == 0.3);
+    for (const auto& agent : am.agents()) {
+        BOOST_TEST(am.agent_by_id(agent->id()) == agent);
+    }
+
+    // Applying again does nothing
+    am.apply_scheduled_changes();
+    BOOST_TEST(am.agents().size() == 42);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -495,6 +539,68 @@ BOOST_FIXTURE_TEST_CASE(test_neighbors, AgentManagers, *utf::tolerance(1.e-10))
     BOOST_TEST(am.neighbors_of(am.agents()[0], 0.).size() == 0);
 }
 
+/// Sorting the agents spatially keeps them but brings neighbors together
+BOOST_FIXTURE_TEST_CASE(test_sort_agents, AgentManagers)
+{
+    MockModel<AgentTraitsDC> mm("mm_sorting", cfg["sorting"]);
+    auto& am = mm._am;
+    BOOST_TEST(am.sort_interval() == 3u);
+
+    // The mean distance between agents that are adjacent in the container
+    auto mean_distance = [&am](){
+        const auto& agents = am.agents();
+        double sum = 0.;
+        for (std::size_t i = 1; i < agents.size(); i++) {
+            sum += am.distance(agents[i-1], agents[i]);
+        }
+        return sum / (agents.size() - 1);
+    };
+
+    // The agents in the order of their IDs
+    auto agents_by_id = [&am](){
+        std::decay_t<decltype(am.agents())> agents;
+        for (const auto idx : am.agent_idcs_by_id()) {
+            agents.push_back(am.agents()[idx]);
+        }
+        return agents;
+    };
+
+    const auto agents_before = agents_by_id();
+    const auto dist_before = mean_distance();
+
+    am.sort_agents();
+    BOOST_TEST(am.agents().size() == 500u);
+    BOOST_TEST(mean_distance() < dist_before / 5.);
+
+    // The same agents are still there and can be looked up by their ID
+    BOOST_TEST(agents_by_id() == agents_before);
+    for (const auto& agent : am.agents()) {
+        BOOST_TEST(am.agent_by_id(agent->id()) == agent);
+    }
+
+    // Sorting again does not change the order
+    const auto agents_sorted = am.agents();
+    am.sort_agents();
+    BOOST_TEST(am.agents() == agents_sorted);
+
+    // With a large number of bins, the agents are sorted as well
+    am.sort_agents(1u << 12);
+    BOOST_TEST(mean_distance() < dist_before / 5.);
+    BOOST_TEST(agents_by_id() == agents_before);
+
+    // Periodic sorting happens on every third call
+    std::vector<bool> sorted;
+    for (int i = 0; i < 7; i++) {
+        sorted.push_back(am.sort_agents_periodically());
+    }
+    BOOST_TEST(sorted == std::vector<bool>({false, false, true,
+                                            false, false, true, false}));
+
+    // ... and never by default
+    BOOST_TEST(mm_dc._am.sort_interval() == 0u);
+    BOOST_TEST(not mm_dc._am.sort_agents_periodically());
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // space-embedding
 
 }  // namespace
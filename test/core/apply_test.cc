@@ -134,6 +134,34 @@ BOOST_AUTO_TEST_CASE(sync_rule)
     BOOST_TEST(wrong == 0);
 }
 
+BOOST_AUTO_TEST_CASE(sync_rule_swap)
+{
+    using Utopia::StateBuffer;
+    auto& cm = mm_sync._cm;
+    auto rule = get_rule_acc_neighbors_with_mngr(cm);
+    Utopia::apply_rule<StateBuffer::swap>(rule, cm.cells());
+
+    // check that rule was applied correctly
+    auto wrong = std::count_if(cm.cells().begin(),
+                               cm.cells().end(),
+                               [](const auto cell) {
+                                  return cell->state() != 1;
+                               });
+    BOOST_TEST(wrong == 0);
+
+    // apply again; the buffer now holds the previous state
+    Utopia::apply_rule<StateBuffer::swap>(
+        [](const auto& cell){ return cell->state() + 1; }, cm.cells());
+
+    wrong = std::count_if(cm.cells().begin(),
+                          cm.cells().end(),
+                          [](const auto cell) {
+                             return (cell->state() != 2
+                                     or cell->state_new() != 1);
+                          });
+    BOOST_TEST(wrong == 0);
+}
+
 BOOST_AUTO_TEST_CASE(async_rule)
 {
     auto& cm = mm_async._cm;
@@ -301,6 +329,51 @@ BOOST_AUTO_TEST_CASE(async_shuffled)
     BOOST_TEST(ids != ids_now, boost::test_tools::per_element());
 }
 
+BOOST_AUTO_TEST_CASE(with_probability)
+{
+    auto& cm = mm_manual._cm;
+    auto& rng = *mm_manual._rng;
+    const auto num_cells = cm.cells().size();
+
+    // The extreme cases
+    Utopia::apply_rule_with_probability<Update::async>(
+        [](const auto&){ return 1; }, cm.cells(), 0., rng);
+    BOOST_TEST(std::all_of(cm.cells().begin(), cm.cells().end(),
+                           [](const auto cell){ return cell->state == 0; }));
+
+    Utopia::apply_rule_with_probability<Update::sync>(
+        [](const auto&){ return 1; }, cm.cells(), 1., rng);
+    BOOST_TEST(std::all_of(cm.cells().begin(), cm.cells().end(),
+                           [](const auto cell){ return cell->state == 1; }));
+
+    // Apply with some probability; the rule is applied in container order
+    std::vector<unsigned int> ids_applied;
+    Utopia::apply_rule_with_probability<Update::async>(
+        [&](const auto& cell){ ids_applied.push_back(cell->id());
+                               cell->state = 2; },
+        cm.cells(), .1, rng);
+
+    const auto num_changed = std::count_if(cm.cells().begin(),
+                                           cm.cells().end(),
+                                           [](const auto cell) {
+                                               return cell->state == 2;
+                                           });
+    BOOST_TEST(num_changed == ids_applied.size());
+    BOOST_TEST(num_changed > 0);
+    BOOST_TEST(num_changed < num_cells / 2);
+    BOOST_TEST(std::is_sorted(ids_applied.begin(), ids_applied.end()));
+
+    // Sync: the new states only depend on the old ones
+    for (const auto& cell : cm.cells()) {
+        cell->state = 0;
+    }
+    auto acc_neighbors = get_rule_acc_neighbors(cm);
+    Utopia::apply_rule_with_probability<Update::sync>(acc_neighbors,
+                                                      cm.cells(), 1., rng);
+    BOOST_TEST(std::all_of(cm.cells().begin(), cm.cells().end(),
+                           [](const auto cell){ return cell->state == 1; }));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // Check for rules with multiple arguments
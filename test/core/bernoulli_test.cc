@@ -0,0 +1,73 @@
+#define BOOST_TEST_MODULE bernoulli test
+
+#include <random>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <utopia/core/bernoulli.hh>
+
+using Utopia::for_each_bernoulli_success;
+
+/// Edge cases and argument checks
+BOOST_AUTO_TEST_CASE(edge_cases)
+{
+    std::mt19937 rng(42);
+    std::vector<std::size_t> idcs;
+    auto collect = [&](const std::size_t i){ idcs.push_back(i); };
+
+    for_each_bernoulli_success(100, 0., rng, collect);
+    BOOST_TEST(idcs.empty());
+
+    for_each_bernoulli_success(100, 1., rng, collect);
+    BOOST_TEST(idcs.size() == 100);
+    BOOST_TEST(idcs.back() == 99);
+
+    idcs.clear();
+    for_each_bernoulli_success(0, .5, rng, collect);
+    BOOST_TEST(idcs.empty());
+
+    // Tiny probabilities do not overflow
+    for_each_bernoulli_success(1000, 1e-300, rng, collect);
+    BOOST_TEST(idcs.empty());
+
+    BOOST_CHECK_THROW(for_each_bernoulli_success(10, -.1, rng, collect),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(for_each_bernoulli_success(10, 1.1, rng, collect),
+                      std::invalid_argument);
+}
+
+/// The successes are in range, ascending, and have the expected statistics
+BOOST_AUTO_TEST_CASE(statistics)
+{
+    std::mt19937 rng(42);
+    const std::size_t n = 1000;
+    const std::size_t num_repetitions = 2000;
+
+    for (const double p : {.001, .05, .5, .9}) {
+        std::vector<std::size_t> counts(n, 0);
+        std::size_t total = 0;
+
+        for (std::size_t r = 0; r < num_repetitions; r++) {
+            long last = -1;
+            for_each_bernoulli_success(n, p, rng, [&](const std::size_t i){
+                BOOST_REQUIRE(i < n);
+                BOOST_REQUIRE(long(i) > last);
+                last = i;
+                ++counts[i];
+                ++total;
+            });
+        }
+
+        // Mean number of successes is within a few standard deviations
+        const double expected = p * n * num_repetitions;
+        const double sigma = std::sqrt(expected * (1. - p));
+        BOOST_TEST(std::abs(total - expected) < 5. * sigma);
+
+        // The first and the last trial are not treated differently
+        const double exp_single = p * num_repetitions;
+        const double sigma_single = std::sqrt(exp_single * (1. - p)) + 1.;
+        BOOST_TEST(std::abs(counts.front() - exp_single) < 5. * sigma_single);
+        BOOST_TEST(std::abs(counts.back() - exp_single) < 5. * sigma_single);
+    }
+}
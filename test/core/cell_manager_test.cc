@@ -55,6 +55,33 @@ struct CellStateRC {
     }
 };
 
+/// A cell state definition that is constructible from pre-parsed parameters
+struct CellStatePC {
+    /// The parameters, parsed once from the cell_params configuration
+    struct Params {
+        double a_double;
+        std::string a_string;
+
+        Params(const Config& cfg)
+        :
+            a_double(get_as<double>("a_double", cfg)),
+            a_string(get_as<std::string>("a_string", cfg))
+        {}
+    };
+
+    double a_double;
+    std::string a_string;
+    double a_random;
+
+    template<class RNG>
+    CellStatePC(const Params& params, RNG& rng)
+    :
+        a_double(params.a_double),
+        a_string(params.a_string),
+        a_random(std::uniform_real_distribution<double>(0., 1.)(rng))
+    {}
+};
+
 /// A cell state definition that is only explicitly constructible
 struct CellStateEC {
     double a_double;
@@ -94,6 +121,9 @@ using CellTraitsCC = Utopia::CellTraits<CellStateCC, Update::sync>;
 /// For a config-constructible cell state (with RNG) 
 using CellTraitsRC = Utopia::CellTraits<CellStateCC, Update::sync>;
 
+/// For a cell state constructible from pre-parsed parameters
+using CellTraitsPC = Utopia::CellTraits<CellStatePC, Update::sync>;
+
 /// For an explicitly-constructible cell state
 using CellTraitsEC = Utopia::CellTraits<CellStateEC, Update::sync>;
 
@@ -139,6 +169,31 @@ int main() {
         MockModel<CellTraitsRC> mm_rc("mm_rc", cfg["config_with_RNG"]);
         std::cout << "Success." << std::endl << std::endl;
         
+        // Initialize the mock model with a params-constructible cell type
+        std::cout << "... Params-constructible state" << std::endl;
+        MockModel<CellTraitsPC> mm_pc("mm_pc", cfg["config"]);
+        {
+            const auto& pc_cells = mm_pc._cm.cells();
+            assert(pc_cells.size() == (42 * 2) * (42 * 2));
+
+            // Parameters are shared, random values differ between cells
+            for (const auto& cell : pc_cells) {
+                assert(cell->state().a_double == 2.34);
+                assert(cell->state().a_string == "foobar");
+                assert(cell->state().a_random >= 0.);
+                assert(cell->state().a_random < 1.);
+            }
+            assert(pc_cells[0]->state().a_random
+                   != pc_cells[1]->state().a_random);
+
+            // The IDs are consecutive, the cells contiguous in memory
+            for (std::size_t i = 0; i < pc_cells.size(); i++) {
+                assert(pc_cells[i]->id() == i);
+            }
+            assert(pc_cells[1].get() == pc_cells[0].get() + 1);
+        }
+        std::cout << "Success." << std::endl << std::endl;
+
         // Initialize the mock model with config-constructible cell type
         std::cout << "... only explicitly constructible state" << std::endl;
         const auto initial_state = CellStateEC(2.34, "foobar", true);
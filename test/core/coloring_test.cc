@@ -0,0 +1,201 @@
+#define BOOST_TEST_MODULE coloring test
+
+#include <map>
+#include <random>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/graph/adjacency_list.hpp>
+
+#include <utopia/core/coloring.hh>
+#include <utopia/core/testtools.hh>
+
+#include "cell_manager_test.hh"
+
+using namespace Utopia;
+
+
+// -- Types, Fixtures and Helpers ---------------------------------------------
+
+/// Cells with a manually updated integer state
+using CellTraitsInt = CellTraits<int, Update::manual, true>;
+
+/// A mock model holding a cell manager with integer states
+using ColoringTest = Test::CellManager::MockModel<CellTraitsInt>;
+
+struct Infrastructure : public TestTools::BaseInfrastructure<> {
+    Infrastructure () : BaseInfrastructure<>("coloring_test.yml") {}
+};
+
+/// Check that a coloring of cells partitions the cells into independent sets
+template<class CellManager, class Coloring>
+void check_cell_coloring (const CellManager& cm,
+                          const Coloring& coloring,
+                          const unsigned distance)
+{
+    BOOST_TEST(coloring.size() == cm.cells().size());
+
+    std::vector<std::size_t> color_of(cm.cells().size(), coloring.size());
+    for (std::size_t c = 0; c < coloring.num_colors(); ++c) {
+        BOOST_TEST(not coloring[c].empty());
+        for (const auto& cell : coloring[c]) {
+            BOOST_TEST(color_of[cell->id()] == coloring.size());
+            color_of[cell->id()] = c;
+        }
+    }
+
+    for (const auto& cell : cm.cells()) {
+        for (const auto& nb : cm.neighbors_of(cell)) {
+            BOOST_TEST(color_of[nb->id()] != color_of[cell->id()]);
+
+            if (distance < 2) {
+                continue;
+            }
+            for (const auto& nb2 : cm.neighbors_of(nb)) {
+                if (nb2 != cell) {
+                    BOOST_TEST(color_of[nb2->id()] != color_of[cell->id()]);
+                }
+            }
+        }
+    }
+}
+
+
+// -- Tests -------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_SUITE(test_coloring, Infrastructure)
+
+/// Colorings of square grids follow the regular patterns where possible
+BOOST_AUTO_TEST_CASE(test_color_square_grids)
+{
+    // The expected number of colors for distance 1 and 2
+    const std::map<std::string, std::pair<std::size_t, std::size_t>> expected {
+        {"empty",          {1, 1}},
+        {"vonNeumann",     {2, 5}},
+        {"vonNeumann_np",  {2, 5}},
+        {"vonNeumann_d2",  {9, 25}},
+        {"Moore",          {4, 9}},
+        {"Moore_np",       {4, 9}}
+    };
+
+    for (const auto& [name, num_colors] : expected) {
+        BOOST_TEST_CONTEXT("Scenario: " << name) {
+            ColoringTest model(name, cfg[name]);
+            const auto& cm = model._cm;
+
+            const auto coloring = color_cells(cm);
+            check_cell_coloring(cm, coloring, 1);
+            BOOST_TEST(coloring.num_colors() == num_colors.first);
+
+            const auto coloring_d2 = color_cells(cm, 2);
+            check_cell_coloring(cm, coloring_d2, 2);
+            BOOST_TEST(coloring_d2.num_colors() == num_colors.second);
+        }
+    }
+}
+
+/// If the pattern does not fit the grid, cells are colored greedily
+BOOST_AUTO_TEST_CASE(test_color_greedily)
+{
+    for (const auto name : {"vonNeumann_odd", "Moore_odd", "hexagonal"}) {
+        BOOST_TEST_CONTEXT("Scenario: " << name) {
+            ColoringTest model(name, cfg[name]);
+            const auto& cm = model._cm;
+            const auto max_nbs = cm.neighbors_of(cm.cells().front()).size();
+
+            const auto coloring = color_cells(cm);
+            check_cell_coloring(cm, coloring, 1);
+            BOOST_TEST(coloring.num_colors() <= max_nbs + 1);
+
+            const auto coloring_d2 = color_cells(cm, 2);
+            check_cell_coloring(cm, coloring_d2, 2);
+            BOOST_TEST(coloring_d2.num_colors() > coloring.num_colors());
+            BOOST_TEST(coloring_d2.num_colors() <= max_nbs * max_nbs + 1);
+        }
+    }
+
+    ColoringTest model("Moore", cfg["Moore"]);
+    BOOST_CHECK_THROW(color_cells(model._cm, 3), std::invalid_argument);
+}
+
+/// Colorings of graph vertices separate adjacent vertices
+BOOST_AUTO_TEST_CASE(test_color_vertices)
+{
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS,
+                                        boost::undirectedS>;
+
+    // A star with five leaves
+    Graph star(6);
+    for (std::size_t leaf = 1; leaf < 6; ++leaf) {
+        boost::add_edge(0, leaf, star);
+    }
+
+    const auto coloring = color_vertices(star);
+    BOOST_TEST(coloring.num_colors() == 2u);
+    BOOST_TEST(coloring.size() == 6u);
+    BOOST_TEST(coloring[0].size() == 1u);
+
+    // With distance 2, the leaves share a neighbor and all are distinct
+    const auto coloring_d2 = color_vertices(star, 2);
+    BOOST_TEST(coloring_d2.num_colors() == 6u);
+
+    // Edge direction is disregarded
+    using DiGraph = boost::adjacency_list<boost::vecS, boost::vecS,
+                                          boost::directedS>;
+    DiGraph ring(5);
+    for (std::size_t v = 0; v < 5; ++v) {
+        boost::add_edge(v, (v + 1) % 5, ring);
+    }
+
+    const auto ring_coloring = color_vertices(ring);
+    BOOST_TEST(ring_coloring.num_colors() == 3u);
+    std::vector<std::size_t> color_of(5);
+    for (std::size_t c = 0; c < ring_coloring.num_colors(); ++c) {
+        for (const auto v : ring_coloring[c]) {
+            color_of[v] = c;
+        }
+    }
+    for (std::size_t v = 0; v < 5; ++v) {
+        BOOST_TEST(color_of[v] != color_of[(v + 1) % 5]);
+    }
+}
+
+/// Rules modifying the neighbors can be applied color by color
+BOOST_AUTO_TEST_CASE(test_apply_rule_colored)
+{
+    for (const auto name : {"vonNeumann", "Moore_odd", "hexagonal"}) {
+        BOOST_TEST_CONTEXT("Scenario: " << name) {
+            ColoringTest model(name, cfg[name]);
+            auto& cm = model._cm;
+            auto coloring = color_cells(cm, 2);
+
+            // Distribute a unit to each neighbor, like a toppling sandpile
+            auto topple = [&cm](const auto& cell){
+                for (auto& nb : cm.neighbors_of(cell)) {
+                    nb->state += 1;
+                }
+            };
+
+            apply_rule_colored<Shuffle::off>(ExecPolicy::par_unseq,
+                                             topple, coloring);
+            for (const auto& cell : cm.cells()) {
+                BOOST_TEST(std::size_t(cell->state)
+                           == cm.neighbors_of(cell).size());
+            }
+
+            // Shuffled, with a rule returning the new state
+            apply_rule_colored(ExecPolicy::par,
+                               [](const auto& cell){ return cell->state + 1; },
+                               coloring, *model.get_rng());
+            apply_rule_colored<Shuffle::on>(topple, coloring,
+                                            *model.get_rng());
+            for (const auto& cell : cm.cells()) {
+                BOOST_TEST(std::size_t(cell->state)
+                           == 2 * cm.neighbors_of(cell).size() + 1);
+            }
+            check_cell_coloring(cm, coloring, 2);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,326 @@
+#define BOOST_TEST_MODULE field test
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <utopia/core/field.hh>
+#include <utopia/core/rng.hh>
+#include <utopia/core/testtools.hh>
+
+#include "cell_manager_integration_test.hh"
+#include "cell_manager_test.hh"
+
+using namespace Utopia;
+
+
+// -- Types, Fixtures and Helpers ---------------------------------------------
+
+/// Cells with a manually updated continuous state
+using CellTraitsDouble = CellTraits<double, Update::manual, true>;
+
+/// A mock model holding a cell manager with continuous states
+using FieldTest = Test::CellManager::MockModel<CellTraitsDouble>;
+
+struct Infrastructure : public TestTools::BaseInfrastructure<> {
+    Infrastructure () : BaseInfrastructure<>("field_test.yml") {}
+};
+
+/// Fill a field with random values
+template<class RNG>
+void randomize (Field<double>& field, RNG& rng) {
+    std::uniform_real_distribution<double> dist(-1., 1.);
+    std::generate(field.begin(), field.end(), [&](){ return dist(rng); });
+}
+
+/// The value of a field at the neighbor of a cell in the given direction
+/** Evaluated via the grid, independently of the field's own boundary
+  * handling: beyond a non-periodic boundary, the boundary value is returned.
+  */
+template<class CellManager>
+double value_at (const Field<double>& field,
+                 const CellManager& cm,
+                 const IndexType id,
+                 const long dx,
+                 const long dy)
+{
+    const auto& grid = *cm.grid();
+    const auto shape = grid.shape();
+    const auto midx = grid.midx_of(id);
+    long x = long(midx[0]) + dx;
+    long y = long(midx[1]) + dy;
+
+    if (grid.is_periodic()) {
+        x = (x + long(shape[0])) % long(shape[0]);
+        y = (y + long(shape[1])) % long(shape[1]);
+    }
+    else if (x < 0 or y < 0 or x >= long(shape[0]) or y >= long(shape[1])) {
+        return field.boundary_value();
+    }
+    return field(x, y);
+}
+
+
+// -- Tests -------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_SUITE(test_field, Infrastructure)
+
+/// Fields take their shape and boundary condition from the grid
+BOOST_AUTO_TEST_CASE(test_construction)
+{
+    FieldTest periodic("periodic", cfg["periodic"]);
+    const Field<double> field(*periodic._cm.grid(), 1.5);
+    BOOST_TEST(field.shape()[0] == 16u);
+    BOOST_TEST(field.shape()[1] == 8u);
+    BOOST_TEST(field.size() == periodic._cm.cells().size());
+    BOOST_CHECK(field.boundary() == FieldBoundary::periodic);
+    BOOST_TEST(std::all_of(field.begin(), field.end(),
+                           [](const auto v){ return v == 1.5; }));
+
+    // Values are stored by cell ID
+    for (const auto& cell : periodic._cm.cells()) {
+        const auto midx = periodic._cm.grid()->midx_of(cell->id());
+        BOOST_TEST(&field(midx[0], midx[1]) == &field[cell->id()]);
+    }
+    BOOST_TEST(field.at(-1, 8) == field(15, 0));
+
+    FieldTest non_periodic("non_periodic", cfg["non_periodic"]);
+    Field<double> np_field(*non_periodic._cm.grid(), 0., -3.);
+    BOOST_CHECK(np_field.boundary() == FieldBoundary::fixed);
+    BOOST_TEST(np_field.at(-1, 0) == -3.);
+    BOOST_TEST(np_field.at(0, 15) == -3.);
+
+    np_field.set_boundary(FieldBoundary::periodic);
+    BOOST_TEST(np_field.at(-1, 0) == np_field(4, 0));
+
+    // Only two-dimensional square grids are supported
+    FieldTest hexagonal("hexagonal", cfg["hexagonal"]);
+    BOOST_CHECK_THROW(Field<double>(*hexagonal._cm.grid()),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(Field<double>({0, 4}), std::invalid_argument);
+}
+
+/// The stencil operations agree with the neighborhoods of the grid
+BOOST_AUTO_TEST_CASE(test_stencils)
+{
+    for (const auto name : {"periodic", "non_periodic"}) {
+        BOOST_TEST_CONTEXT("Scenario: " << name) {
+            FieldTest model(name, cfg[name]);
+            const auto& cm = model._cm;
+
+            Field<double> field(*cm.grid(), 0., 0.25);
+            randomize(field, *model.get_rng());
+            Field<double> lap(*cm.grid()), grad_x(*cm.grid()),
+                          grad_y(*cm.grid()), sum(*cm.grid()),
+                          sum_moore(*cm.grid()), min(*cm.grid()),
+                          max_moore(*cm.grid());
+
+            field.laplacian(lap);
+            field.gradient(ExecPolicy::par_unseq, grad_x, grad_y);
+            field.neighbor_sum(ExecPolicy::par, sum);
+            field.neighbor_sum(sum_moore, NBMode::Moore);
+            field.neighbor_min(min);
+            field.neighbor_max(ExecPolicy::unseq, max_moore, NBMode::Moore);
+
+            for (const auto& cell : cm.cells()) {
+                const auto id = cell->id();
+                auto nb = [&](const long dx, const long dy){
+                    return value_at(field, cm, id, dx, dy);
+                };
+                const double l = nb(-1, 0), r = nb(1, 0),
+                             d = nb(0, -1), u = nb(0, 1);
+                const double dl = nb(-1, -1), dr = nb(1, -1),
+                             ul = nb(-1, 1), ur = nb(1, 1);
+                const auto tol = boost::test_tools::tolerance(1.e-12);
+
+                BOOST_TEST(lap[id] == l + r + d + u - 4. * field[id], tol);
+                BOOST_TEST(grad_x[id] == (r - l) / 2., tol);
+                BOOST_TEST(grad_y[id] == (u - d) / 2., tol);
+                BOOST_TEST(sum[id] == l + r + d + u, tol);
+                BOOST_TEST(sum_moore[id] == l + r + d + u + dl + dr + ul + ur,
+                           tol);
+                BOOST_TEST(min[id] == std::min({l, r, d, u}));
+                BOOST_TEST(max_moore[id]
+                           == std::max({l, r, d, u, dl, dr, ul, ur}));
+            }
+        }
+    }
+}
+
+/// Stencil operations check their arguments
+BOOST_AUTO_TEST_CASE(test_invalid_arguments)
+{
+    FieldTest model("periodic", cfg["periodic"]);
+    Field<double> field(*model._cm.grid());
+    Field<double> other({4, 4});
+    BOOST_CHECK_THROW(field.laplacian(field), std::invalid_argument);
+    BOOST_CHECK_THROW(field.laplacian(other), std::invalid_argument);
+
+    Field<double> out(*model._cm.grid());
+    BOOST_CHECK_THROW(field.neighbor_sum(out, NBMode::empty),
+                      std::invalid_argument);
+}
+
+/// Fields that are a single cell wide are their own neighbors
+BOOST_AUTO_TEST_CASE(test_narrow)
+{
+    FieldTest model("narrow", cfg["narrow"]);
+    Field<double> field(*model._cm.grid());
+    BOOST_TEST(field.shape()[0] == 1u);
+    BOOST_TEST(field.shape()[1] == 4u);
+
+    field.values() = {1., 2., 3., 4.};
+    Field<double> sum(*model._cm.grid());
+    field.neighbor_sum(sum);
+    BOOST_TEST(sum.values() == (std::vector<double>{8., 8., 12., 12.}),
+               boost::test_tools::per_element());
+
+    field.set_boundary(FieldBoundary::fixed, 10.);
+    field.neighbor_sum(sum);
+    BOOST_TEST(sum.values() == (std::vector<double>{32., 24., 26., 33.}),
+               boost::test_tools::per_element());
+}
+
+/// Fields exchange values with cells and can be written as grid data
+BOOST_AUTO_TEST_CASE(test_cells_and_output)
+{
+    FieldTest model("periodic", cfg["periodic"]);
+    auto& cm = model._cm;
+
+    for (const auto& cell : cm.cells()) {
+        cell->state = cell->id();
+    }
+
+    Field<double> field(*cm.grid());
+    field.gather(cm.cells(), [](const auto& cell){ return cell->state; });
+    BOOST_TEST(field(3, 2) == 2. * 16. + 3.);
+
+    // A diffusion step conserves the total amount
+    const double total = std::accumulate(field.begin(), field.end(), 0.);
+    Field<double> lap(*cm.grid());
+    field.laplacian(lap);
+    std::transform(field.begin(), field.end(), lap.begin(), field.begin(),
+                   [](const auto v, const auto l){ return v + 0.2 * l; });
+    BOOST_TEST(std::accumulate(field.begin(), field.end(), 0.) == total,
+               boost::test_tools::tolerance(1.e-12));
+
+    field.scatter(cm.cells(), [](const auto& cell, const auto v){
+        cell->state = v;
+    });
+    for (const auto& cell : cm.cells()) {
+        BOOST_TEST(cell->state == field[cell->id()]);
+    }
+
+    Field<double> too_small({2, 2});
+    BOOST_CHECK_THROW(too_small.gather(cm.cells(),
+                                       [](const auto&){ return 0.; }),
+                      std::invalid_argument);
+
+    // The values can be written directly to a grid dataset of a model with
+    // the same grid
+    PseudoParent<> pp("field_test.yml");
+    Test::CMTest output_model("output", pp);
+    auto dset = output_model.create_cm_dset("field", output_model.cm);
+    dset->write(field.values());
+    dset->write(lap.values());
+}
+
+/// Replicas are stored interleaved and treated independently
+BOOST_AUTO_TEST_CASE(test_replicas)
+{
+    for (const auto name : {"periodic", "non_periodic"}) {
+        BOOST_TEST_CONTEXT("Scenario: " << name) {
+            FieldTest model(name, cfg[name]);
+            const auto& grid = *model._cm.grid();
+            constexpr std::size_t num_replicas = 3;
+
+            // Fill each replica with values of its own random number stream
+            auto rngs = split_rng(*model.get_rng(), num_replicas);
+            Field<double> ensemble(grid, 0., 0.5, num_replicas);
+            BOOST_TEST(ensemble.num_replicas() == num_replicas);
+            BOOST_TEST(ensemble.size() == num_replicas * ensemble.num_cells());
+
+            std::vector<Field<double>> replicas;
+            for (std::size_t r = 0; r < num_replicas; ++r) {
+                replicas.emplace_back(grid, 0., 0.5);
+                randomize(replicas.back(), rngs[r]);
+
+                for (std::size_t id = 0; id < ensemble.num_cells(); ++id) {
+                    ensemble[id * num_replicas + r] = replicas.back()[id];
+                }
+                BOOST_TEST(ensemble.replica_values(r)
+                           == replicas.back().values());
+            }
+
+            // A stencil operation on the ensemble equals one per replica
+            Field<double> lap(grid, 0., 0., num_replicas);
+            Field<double> max_moore(grid, 0., 0., num_replicas);
+            ensemble.laplacian(ExecPolicy::par, lap);
+            ensemble.neighbor_max(max_moore, NBMode::Moore);
+
+            for (std::size_t r = 0; r < num_replicas; ++r) {
+                Field<double> expected(grid), expected_max(grid);
+                replicas[r].laplacian(expected);
+                replicas[r].neighbor_max(expected_max, NBMode::Moore);
+                BOOST_TEST(lap.replica_values(r) == expected.values(),
+                           boost::test_tools::per_element());
+                BOOST_TEST(max_moore.replica_values(r)
+                           == expected_max.values(),
+                           boost::test_tools::per_element());
+            }
+
+            // Replicas of the output need to match
+            Field<double> single(grid);
+            BOOST_CHECK_THROW(ensemble.laplacian(single),
+                              std::invalid_argument);
+            BOOST_CHECK_THROW(ensemble.replica_values(num_replicas),
+                              std::invalid_argument);
+        }
+    }
+
+    BOOST_CHECK_THROW(Field<double>({2, 2}, 0., FieldBoundary::periodic, 0.,
+                                    0),
+                      std::invalid_argument);
+}
+
+/// Replicas exchange values with cells and are written to datasets each
+BOOST_AUTO_TEST_CASE(test_replicas_cells_and_output)
+{
+    FieldTest model("non_periodic", cfg["non_periodic"]);
+    auto& cm = model._cm;
+    for (const auto& cell : cm.cells()) {
+        cell->state = cell->id();
+    }
+
+    // All replicas start from the cell states ...
+    Field<double> ensemble(*cm.grid(), 0., 0., 4);
+    ensemble.gather(cm.cells(), [](const auto& cell){ return cell->state; });
+    for (std::size_t r = 0; r < 4; ++r) {
+        BOOST_TEST(ensemble(2, 1, r) == 5. + 2.);
+    }
+
+    // ... and may then diverge
+    ensemble(2, 1, 3) = -1.;
+    ensemble.scatter(cm.cells(), [](const auto& cell, const auto v){
+        cell->state = v;
+    }, 3);
+    BOOST_TEST(cm.cells()[7]->state == -1.);
+    BOOST_TEST(cm.cells()[8]->state == 8.);
+
+    PseudoParent<> pp("field_test.yml");
+    Test::CMTest output_model("replica_output", pp);
+    const auto dsets = output_model.create_cm_replica_dsets("ensemble",
+                                                            output_model.cm,
+                                                            4);
+    BOOST_TEST(dsets.size() == 4u);
+    for (std::size_t r = 0; r < dsets.size(); ++r) {
+        BOOST_CHECK(dsets[r]->get_float_precision()
+                    == DataIO::FloatPrecision::single);
+        dsets[r]->write(ensemble.replica_values(r));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
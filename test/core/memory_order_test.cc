@@ -0,0 +1,166 @@
+#define BOOST_TEST_MODULE memory order test
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <utopia/core/grids/memory_order.hh>
+#include <utopia/core/testtools.hh>
+
+#include "cell_manager_test.hh"
+
+using namespace Utopia;
+using Utopia::DataIO::Config;
+
+
+// -- Types, Fixtures and Helpers ---------------------------------------------
+
+/// A cell state drawing a random number upon construction
+struct RandomState {
+    double value;
+
+    template<class RNG>
+    RandomState (const Config&, const std::shared_ptr<RNG>& rng)
+    :
+        value(std::uniform_real_distribution<double>(0., 1.)(*rng))
+    {}
+};
+
+using CellTraitsRandom = CellTraits<RandomState, Update::manual>;
+
+/// A mock model holding a cell manager with random states
+using MemoryOrderTest = Test::CellManager::MockModel<CellTraitsRandom>;
+
+struct Infrastructure : public TestTools::BaseInfrastructure<> {
+    Infrastructure () : BaseInfrastructure<>("memory_order_test.yml") {}
+};
+
+/// Return the IDs of the cells in the order they reside in memory
+template<class CellManager>
+IndexContainer ids_by_address (const CellManager& cm) {
+    auto cells = cm.cells();
+    std::sort(cells.begin(), cells.end(),
+        [](const auto& a, const auto& b){ return a.get() < b.get(); }
+    );
+
+    IndexContainer ids;
+    for (const auto& cell : cells) {
+        ids.push_back(cell->id());
+    }
+    return ids;
+}
+
+/// Whether the container holds each of the IDs 0, ..., n-1 exactly once
+bool is_permutation (IndexContainer ids) {
+    std::sort(ids.begin(), ids.end());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (ids[i] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// -- Tests -------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_SUITE(test_memory_order, Infrastructure)
+
+/// The space-filling curves visit the cells in the expected order
+BOOST_AUTO_TEST_CASE(test_memory_order_of)
+{
+    MemoryOrderTest model("row_major", cfg["row_major"]);
+    const auto& grid = *model._cm.grid();
+    const auto num_cells = grid.num_cells();
+
+    const auto row_major = memory_order_of(grid, MemoryOrder::row_major);
+    BOOST_TEST(row_major.size() == num_cells);
+    BOOST_TEST(std::is_sorted(row_major.begin(), row_major.end()));
+
+    // The Z-order starts with the 2x2 block in the corner, then the next one
+    const auto morton = memory_order_of(grid, MemoryOrder::morton);
+    BOOST_TEST(is_permutation(morton));
+    BOOST_TEST((IndexContainer(morton.begin(), morton.begin() + 8))
+               == (IndexContainer{0, 1, 13, 14, 2, 3, 15, 16}));
+
+    // Tiles of 2x2 coincide with the Z-order at the beginning
+    const auto tiled = memory_order_of(grid, MemoryOrder::tiled, 2);
+    BOOST_TEST(is_permutation(tiled));
+    BOOST_TEST((IndexContainer(tiled.begin(), tiled.begin() + 4))
+               == (IndexContainer(morton.begin(), morton.begin() + 4)));
+    BOOST_CHECK_THROW(memory_order_of(grid, MemoryOrder::tiled, 0),
+                      std::invalid_argument);
+
+    // Along the Hilbert curve, consecutive cells are always neighbors
+    const auto hilbert = memory_order_of(grid, MemoryOrder::hilbert);
+    BOOST_TEST(is_permutation(hilbert));
+    BOOST_TEST(hilbert.front() == 0u);
+
+    std::size_t num_jumps = 0;
+    for (std::size_t i = 1; i < hilbert.size(); ++i) {
+        const auto a = grid.midx_of(hilbert[i-1]);
+        const auto b = grid.midx_of(hilbert[i]);
+        const auto dx = std::max(a[0], b[0]) - std::min(a[0], b[0]);
+        const auto dy = std::max(a[1], b[1]) - std::min(a[1], b[1]);
+        num_jumps += (dx + dy != 1);
+    }
+
+    // ... unless the curve leaves the 13x13 grid, which lies within 16x16
+    BOOST_TEST(num_jumps > 0u);
+    BOOST_TEST(num_jumps < num_cells / 10);
+}
+
+/// The memory order only changes the memory layout of the cells
+BOOST_AUTO_TEST_CASE(test_cell_manager_memory_order)
+{
+    MemoryOrderTest ref("row_major", cfg["row_major"]);
+    BOOST_TEST(ids_by_address(ref._cm)
+               == memory_order_of(*ref._cm.grid(), MemoryOrder::row_major));
+
+    for (const auto& [name, order, tile_size] :
+            {std::tuple{"morton", MemoryOrder::morton, 8u},
+             std::tuple{"hilbert", MemoryOrder::hilbert, 8u},
+             std::tuple{"tiled", MemoryOrder::tiled, 4u},
+             std::tuple{"hexagonal", MemoryOrder::hilbert, 8u}})
+    {
+        BOOST_TEST_CONTEXT("Scenario: " << name) {
+            // Each mock model has an RNG of its own with the same seed
+            MemoryOrderTest model(name, cfg[name]);
+            const auto& cm = model._cm;
+
+            // The cells are laid out in the memory order ...
+            BOOST_TEST(ids_by_address(cm)
+                       == memory_order_of(*cm.grid(), order, tile_size));
+
+            // ... but still accessible by ID
+            for (std::size_t i = 0; i < cm.cells().size(); ++i) {
+                BOOST_TEST(cm.cells()[i]->id() == i);
+            }
+
+            // Neighbors and states do not depend on the memory order
+            if (cm.grid()->structure() == GridStructure::square) {
+                for (std::size_t i = 0; i < cm.cells().size(); ++i) {
+                    const auto& cell = cm.cells()[i];
+                    BOOST_TEST(cell->state.value
+                               == ref._cm.cells()[i]->state.value);
+
+                    const auto nbs = cm.neighbors_of(cell);
+                    const auto ref_nbs = ref._cm.neighbors_of(
+                        ref._cm.cells()[i]);
+                    BOOST_TEST(nbs.size() == ref_nbs.size());
+                    for (std::size_t n = 0; n < nbs.size(); ++n) {
+                        BOOST_TEST(nbs[n]->id() == ref_nbs[n]->id());
+                    }
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(MemoryOrderTest("invalid", cfg["invalid"]),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
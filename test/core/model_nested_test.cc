@@ -38,6 +38,17 @@ struct TestNestedModels : public Utopia::TestTools::BaseInfrastructure<> {
         std::remove(pp_file->get_path().c_str());
 
         log->debug("Temporary files removed.");
+
+        // Remove the loggers created by the models
+        std::vector<std::string> model_loggers;
+        spdlog::apply_all([&](std::shared_ptr<spdlog::logger> l){
+            if (l->name().find("root.") == 0) {
+                model_loggers.push_back(l->name());
+            }
+        });
+        for (const auto& name : model_loggers) {
+            spdlog::drop(name);
+        }
     }
 };
 
@@ -175,4 +186,161 @@ BOOST_AUTO_TEST_CASE (test_iteration_order)
     log->info("Tests successful. :)");
 }
 
+BOOST_AUTO_TEST_CASE (test_sharded_output)
+{
+    const std::string shard_path = "model_nested_test_tmpfile_sharded.h5";
+    const std::string sub_shard_path =
+        "model_nested_test_tmpfile_sharded_sharded.lazy.h5";
+    auto file = pp.get_hdffile();
+
+    {
+        Utopia::OneModel sharded("sharded", pp);
+        sharded.run();
+
+        // Data is written to the shard files
+        BOOST_TEST(sharded._dset_state->get_current_extent()
+                   == std::vector<std::size_t>({10 + 1}),
+                   tt::per_element());
+        BOOST_TEST(Utopia::DataIO::get_file_path(
+                        sharded.get_hdfgrp()->get_C_id()) == shard_path);
+        BOOST_TEST(Utopia::DataIO::get_file_path(
+                        sharded.lazy.get_hdfgrp()->get_C_id())
+                   == sub_shard_path);
+
+        // The datasets created via create_dset are already linked into the
+        // parent's file; those of the nested shard only into its parent's
+        const auto fid = file->get_C_id();
+        BOOST_TEST(H5Lexists(fid, "/sharded/state", H5P_DEFAULT) > 0);
+        BOOST_TEST(not (H5Lexists(fid, "/sharded/lazy", H5P_DEFAULT) > 0));
+        BOOST_TEST(H5Lexists(sharded.get_hdfgrp()->get_C_id(), "lazy/state",
+                             H5P_DEFAULT) > 0);
+    }
+
+    // After destruction, the data is accessible via the parent's file, even
+    // if the shards are nested; attributes are available as well. As the
+    // virtual datasets were linked after the first write, this includes
+    // the data written afterwards.
+    for (const auto& [path, value] : std::vector<std::pair<std::string, int>>{
+            {"/sharded/state", 1}, {"/sharded/lazy/state", 0}})
+    {
+        auto dset = file->open_dataset(path);
+        auto [shape, data] = dset->read<std::vector<int>>();
+        BOOST_TEST(shape == std::vector<hsize_t>({10 + 1}),
+                   tt::per_element());
+        BOOST_TEST(data == std::vector<int>(10 + 1, value),
+                   tt::per_element());
+        BOOST_TEST(H5Aexists(dset->get_C_id(), "dim_name__0") > 0);
+    }
+    BOOST_TEST(H5Aexists(file->open_group("sharded")->get_C_id(),
+                         "write_mode") > 0);
+
+    // Submodels of the same name get shards of their own
+    {
+        Utopia::OneModel unsharded_a("unsharded_a", pp);
+        Utopia::OneModel unsharded_b("unsharded_b", pp);
+        unsharded_a.run();
+        unsharded_b.run();
+
+        BOOST_TEST(Utopia::DataIO::get_file_path(
+                        unsharded_a.lazy.get_hdfgrp()->get_C_id())
+                   != Utopia::DataIO::get_file_path(
+                        unsharded_b.lazy.get_hdfgrp()->get_C_id()));
+    }
+    for (const auto& path : {"/unsharded_a/lazy/state",
+                             "/unsharded_b/lazy/state"})
+    {
+        auto [shape, data] = file->open_dataset(path)
+                                 ->read<std::vector<int>>();
+        BOOST_TEST(shape == std::vector<hsize_t>({10 + 1}),
+                   tt::per_element());
+    }
+
+    for (const auto& path : {shard_path, sub_shard_path,
+                             std::string("model_nested_test_tmpfile_"
+                                         "unsharded_a.lazy.h5"),
+                             std::string("model_nested_test_tmpfile_"
+                                         "unsharded_b.lazy.h5")})
+    {
+        BOOST_TEST(std::remove(path.c_str()) == 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_parallel_submodels)
+{
+    Utopia::WalkersModel walkers("walkers", pp);
+    Utopia::WalkersModel walkers_seq("walkers_seq", pp);
+    BOOST_TEST(walkers.get_parallel_submodels());
+    BOOST_TEST(not walkers_seq.get_parallel_submodels());
+
+    // Concurrently iterated submodels have RNGs of their own
+    BOOST_TEST(walkers.walker_a.get_rng() != walkers.get_rng());
+    BOOST_TEST(walkers.walker_a.get_rng() != walkers.walker_b.get_rng());
+    BOOST_TEST(walkers_seq.walker_a.get_rng() == walkers_seq.get_rng());
+
+    // ... but share the output mutex
+    BOOST_TEST(walkers.walker_a.get_output_mutex() == pp.get_output_mutex());
+
+    walkers.run();
+    walkers_seq.run();
+
+    for (const auto walker : {&walkers.walker_a,
+                              &walkers.walker_b,
+                              &walkers.walker_c})
+    {
+        BOOST_TEST(walker->get_time() == 10);
+        BOOST_TEST(walker->_dset_position->get_current_extent()
+                   == std::vector<std::size_t>({10 + 1}),
+                   tt::per_element());
+    }
+    BOOST_TEST(walkers.walker_a._position != walkers.walker_b._position);
+
+    // The result does not depend on the scheduling of the threads
+    Utopia::DefaultRNG rng(Utopia::get_as<int>("seed", pp.get_cfg()));
+    Utopia::DefaultRNG rng_b((rng.discard(1), rng()));
+    std::normal_distribution<double> step(0., 1.);
+    double position = 0.;
+    for (unsigned int i = 0; i < 10 * 1000; ++i) {
+        position += step(rng_b);
+    }
+    BOOST_TEST(walkers.walker_b._position == position);
+
+    // Errors in submodels are passed on
+    Utopia::WalkersModel walkers_failing("walkers_failing", pp);
+    BOOST_CHECK_THROW(walkers_failing.run(), std::runtime_error);
+    BOOST_TEST(walkers_failing.walker_a.get_time() == 4);
+    BOOST_TEST(walkers_failing.walker_c.get_time() == 4);
+}
+
+BOOST_AUTO_TEST_CASE (test_parallel_submodels_task_pool)
+{
+    // With parallel execution enabled, the submodel steps are tasks in the
+    // thread pool of the backend, if it provides one
+    using Utopia::ParallelExecution;
+    ParallelExecution::set(ParallelExecution::Setting::enabled);
+
+    Utopia::WalkersModel walkers("walkers_pool", pp);
+    walkers.run();
+    ParallelExecution::set(ParallelExecution::Setting::disabled);
+
+    for (const auto walker : {&walkers.walker_a,
+                              &walkers.walker_b,
+                              &walkers.walker_c})
+    {
+        BOOST_TEST(walker->get_time() == 10);
+        BOOST_TEST(walker->_dset_position->get_current_extent()
+                   == std::vector<std::size_t>({10 + 1}),
+                   tt::per_element());
+    }
+
+    // The result is the same as with separate threads
+    Utopia::DefaultRNG rng(Utopia::get_as<int>("seed", pp.get_cfg()));
+    Utopia::DefaultRNG rng_b((rng.discard(1), rng()));
+    std::normal_distribution<double> step(0., 1.);
+    double position = 0.;
+    for (unsigned int i = 0; i < 10 * 1000; ++i) {
+        position += step(rng_b);
+    }
+    BOOST_TEST(walkers.walker_b._position == position);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
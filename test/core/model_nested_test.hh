@@ -1,6 +1,8 @@
 #ifndef UTOPIA_TEST_MODEL_NESTED_TEST_HH
 #define UTOPIA_TEST_MODEL_NESTED_TEST_HH
 
+#include <random>
+
 #include <utopia/core/model.hh>
 
 namespace Utopia {
@@ -393,6 +395,113 @@ public:
 };
 
 
+/// Test model performing a random walk, used for concurrent iteration
+class RandomWalkModel:
+    public Model<RandomWalkModel, CommonModelTypes>
+{
+public:
+    /// The base model class
+    using Base = Model<RandomWalkModel, CommonModelTypes>;
+
+    /// The current position
+    double _position;
+
+    /// The time at which to throw an error; no error if zero
+    Time _fail_at;
+
+    /// The position dataset
+    std::shared_ptr<DataSet> _dset_position;
+
+public:
+    /// Constructor
+    template<class ParentModel>
+    RandomWalkModel (const std::string name,
+                     const ParentModel &parent_model)
+    :
+        Base(name, parent_model),
+        _position(0.),
+        _fail_at(get_as<Time>("fail_at", this->_cfg, 0)),
+        _dset_position(this->create_dset("position", {}))
+    {}
+
+    /// Perform a number of random steps
+    void perform_step () {
+        if (this->_time + 1 == _fail_at) {
+            throw std::runtime_error("Failing as requested!");
+        }
+
+        std::normal_distribution<double> step(0., 1.);
+        for (unsigned int i = 0; i < 1000; ++i) {
+            _position += step(*this->_rng);
+        }
+    }
+
+    /// Provide the position to the monitor
+    void monitor () {
+        this->_monitor.set_entry("position", _position);
+    }
+
+    /// Write the position
+    void write_data () {
+        _dset_position->write(_position);
+    }
+};
+
+
+/// Model iterating its submodels via iterate_submodels
+class WalkersModel:
+    public Model<WalkersModel, CommonModelTypes>
+{
+public:
+    /// The base model class
+    using Base = Model<WalkersModel, CommonModelTypes>;
+
+    /// submodels: independent random walks
+    RandomWalkModel walker_a;
+    RandomWalkModel walker_b;
+    RandomWalkModel walker_c;
+
+public:
+    /// Constructor
+    template<class ParentModel>
+    WalkersModel (const std::string name,
+                  const ParentModel &parent_model)
+    :
+        Base(name, parent_model),
+        walker_a("a", *this),
+        walker_b("b", *this),
+        walker_c("c", *this)
+    {}
+
+    /// Iterate the submodels
+    void perform_step () {
+        this->iterate_submodels(walker_a, walker_b, walker_c);
+    }
+
+    /// Monitor data (do nothing here)
+    void monitor () {}
+
+    /// Data write method (do nothing here)
+    void write_data () {}
+
+    /// Prolog
+    void prolog () {
+        walker_a.prolog();
+        walker_b.prolog();
+        walker_c.prolog();
+        this->__prolog();
+    }
+
+    /// Epilog
+    void epilog () {
+        walker_a.epilog();
+        walker_b.epilog();
+        walker_c.epilog();
+        this->__epilog();
+    }
+};
+
+
 } // namespace Utopia
 
 #endif // UTOPIA_TEST_MODEL_NESTED_TEST_HH
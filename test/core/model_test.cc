@@ -118,6 +118,29 @@ BOOST_AUTO_TEST_CASE (test_model_iterate) {
 }
 
 
+/// Check that observables are cached within and invalidated between steps
+BOOST_AUTO_TEST_CASE (test_model_observables) {
+    TestModel model("test", pp, initial_state);
+
+    auto sum = model.get_observables().add("state_sum", [&model](){
+        return std::accumulate(model.state().begin(), model.state().end(),
+                               0.);
+    });
+    BOOST_TEST(model.get_observables().get<double>("state_sum") == 0.);
+
+    // Within a time step, the cached value is used
+    model.set_state(state_vec(SIZE, 1.0));
+    BOOST_TEST(model.get_observables().get<double>("state_sum") == 0.);
+    BOOST_TEST(sum->get_num_evaluations() == 1u);
+
+    // Iterating invalidates the value
+    model.iterate();
+    BOOST_TEST(not sum->is_cached());
+    BOOST_TEST(model.get_observables().get<double>("state_sum") == 2. * SIZE);
+    BOOST_TEST(sum->get_num_evaluations() == 2u);
+}
+
+
 /// Check model iteration with a custom iterate method
 /** \warning Overwriting the iterate method is NOT recommended. It should still
   *          be possible, that's why it's tested; but it should only be done if
@@ -0,0 +1,102 @@
+#define BOOST_TEST_MODULE observables test
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <utopia/core/logging.hh>
+#include <utopia/core/observables.hh>
+
+using namespace Utopia;
+
+/// Set up the loggers needed by the parallel facilities
+struct Fixture {
+    Fixture () {
+        setup_loggers();
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(observables, Fixture)
+
+/// Test that values are cached until the registry is invalidated
+BOOST_AUTO_TEST_CASE(caching)
+{
+    ObservableRegistry reg;
+    int source = 1;
+    std::size_t num_calls = 0;
+
+    auto obs = reg.add("twice", [&](){
+        ++num_calls;
+        return 2 * source;
+    });
+    BOOST_TEST(reg.contains("twice"));
+    BOOST_TEST(reg.size() == 1u);
+    BOOST_TEST(not obs->is_cached());
+
+    // Computed once, then taken from the cache
+    BOOST_TEST(reg.get<int>("twice") == 2);
+    source = 2;
+    BOOST_TEST(reg.get<int>("twice") == 2);
+    BOOST_TEST((*obs)() == 2);
+    BOOST_TEST(num_calls == 1u);
+    BOOST_TEST(obs->get_num_evaluations() == 1u);
+
+    // Invalidation leads to re-computation on the next access only
+    reg.invalidate();
+    BOOST_TEST(not obs->is_cached());
+    BOOST_TEST(num_calls == 1u);
+    BOOST_TEST(reg.get<int>("twice") == 4);
+    BOOST_TEST(num_calls == 2u);
+
+    // Observables may depend on other observables
+    reg.add("twice_plus_one", [&](){
+        return reg.get<int>("twice") + 1;
+    });
+    BOOST_TEST(reg.get<int>("twice_plus_one") == 5);
+    BOOST_TEST(num_calls == 2u);
+}
+
+/// Test the errors upon invalid names and types
+BOOST_AUTO_TEST_CASE(errors)
+{
+    ObservableRegistry reg;
+    reg.add("value", [](){ return 1.5; });
+
+    BOOST_CHECK_THROW(reg.add("value", [](){ return 1; }),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(reg.get<double>("missing"), std::invalid_argument);
+    BOOST_CHECK_THROW(reg.get<int>("value"), std::invalid_argument);
+    BOOST_TEST(reg.get<double>("value") == 1.5);
+}
+
+/// Test reductions over a container of entity pointers
+BOOST_AUTO_TEST_CASE(reduction)
+{
+    std::vector<std::shared_ptr<int>> entities;
+    for (int i = 0; i < 100; ++i) {
+        entities.push_back(std::make_shared<int>(i));
+    }
+
+    const auto num_even = make_reduction(
+        ExecPolicy::par_unseq, entities, std::size_t(0), std::plus<>(),
+        [](const auto& e) -> std::size_t { return *e % 2 == 0; }
+    );
+    BOOST_TEST(num_even() == 50u);
+
+    ObservableRegistry reg;
+    reg.add("sum", make_reduction(entities, 0, std::plus<>(),
+                                  [](const auto& e){ return *e; }));
+    BOOST_TEST(reg.get<int>("sum") == 4950);
+
+    // The container is referenced, such that changes become visible upon
+    // invalidation
+    *entities[0] = 50;
+    BOOST_TEST(reg.get<int>("sum") == 4950);
+    reg.invalidate();
+    BOOST_TEST(reg.get<int>("sum") == 5000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
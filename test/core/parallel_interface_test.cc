@@ -2,6 +2,9 @@
 #include <boost/test/included/unit_test.hpp> // for unit tests
 
 #include <type_traits>
+#include <vector>
+
+#include <tbb/task_arena.h>
 
 #include <utopia/core/parallel.hh>
 
@@ -83,3 +86,57 @@ BOOST_FIXTURE_TEST_CASE(parallel_select,
     BOOST_TEST(exec_parallel(ExecPolicy::par, is_par));
     BOOST_TEST(exec_parallel(ExecPolicy::par_unseq, is_par_unseq));
 }
+
+/// Test the thread and grain size settings of 'ParallelExecution'
+BOOST_FIXTURE_TEST_CASE(parallel_threads,
+                        logger_setup)
+{
+    namespace stdexc = std::execution;
+    using namespace Utopia;
+
+    const DataIO::Config cfg = YAML::LoadFile("parallel_stl_test.yml");
+    ParallelExecution::init(cfg["threads"]);
+    BOOST_TEST(ParallelExecution::is_enabled());
+    BOOST_TEST(ParallelExecution::get_num_threads() == 2u);
+    BOOST_TEST(ParallelExecution::get_pin_threads());
+    BOOST_TEST(ParallelExecution::get_grain_size() == 1000u);
+
+    // Parallel algorithms are executed in the arena with the set concurrency
+    auto concurrency = [](auto&&) {
+        return tbb::this_task_arena::max_concurrency();
+    };
+    BOOST_TEST(exec_parallel(ExecPolicy::par, concurrency) == 2);
+
+    // Small ranges are processed on the calling thread
+    auto policy_index = [](auto tpl) -> int {
+        using Policy = std::decay_t<std::tuple_element_t<0, decltype(tpl)>>;
+        if constexpr (std::is_same_v<Policy, stdexc::sequenced_policy>)
+            return 0;
+        else if constexpr (std::is_same_v<Policy, stdexc::unsequenced_policy>)
+            return 1;
+        else if constexpr (std::is_same_v<Policy, stdexc::parallel_policy>)
+            return 2;
+        else
+            return 3;
+    };
+    const std::vector<double> small(999), large(1000);
+    BOOST_TEST(exec_parallel(ExecPolicy::par,
+                             policy_index, small.begin(), small.end()) == 0);
+    BOOST_TEST(exec_parallel(ExecPolicy::par_unseq,
+                             policy_index, small.begin(), small.end()) == 1);
+    BOOST_TEST(exec_parallel(ExecPolicy::par,
+                             policy_index, large.begin(), large.end()) == 2);
+    BOOST_TEST(exec_parallel(ExecPolicy::par_unseq,
+                             policy_index, large.begin(), large.end()) == 3);
+
+    // Algorithms still work as expected
+    std::vector<double> values(1E5, 1.0);
+    BOOST_TEST(std::reduce(ExecPolicy::par, values.begin(), values.end())
+               == values.size());
+
+    // Reset to the defaults
+    ParallelExecution::init(cfg["default"]);
+    BOOST_TEST(ParallelExecution::get_num_threads() == 0u);
+    BOOST_TEST(not ParallelExecution::get_pin_threads());
+    BOOST_TEST(ParallelExecution::get_grain_size() == 0u);
+}
@@ -2,6 +2,9 @@
 #include <boost/test/included/unit_test.hpp> // for unit tests
 #include <boost/test/data/test_case.hpp>
 
+#include <functional>
+#include <numeric>
+
 // NOTE: Can (and should!) be performend independently from HAVE_XXX_PSTL
 //       using DISABLE_HAVE_PARALLEL_STL macro
 #ifdef DISABLE_HAVE_PARALLEL_STL
@@ -76,3 +79,193 @@ BOOST_DATA_TEST_CASE_F(
                    [](auto&& lhs, auto&& rhs) { return lhs + rhs; });
     BOOST_TEST(from == to, boost::test_tools::per_element());
 }
+
+/// Test reduce
+BOOST_DATA_TEST_CASE_F(
+    vectors,
+    reduce,
+    boost::unit_test::data::make({ Utopia::ExecPolicy::seq,
+                                   Utopia::ExecPolicy::unseq,
+                                   Utopia::ExecPolicy::par,
+                                   Utopia::ExecPolicy::par_unseq }),
+    policy)
+{
+    BOOST_TEST(std::reduce(policy, begin(to), end(to)) == to.size());
+    BOOST_TEST(std::reduce(policy, begin(to), end(to), 1.0) == to.size() + 1);
+    BOOST_TEST(std::reduce(policy,
+                           begin(to),
+                           end(to),
+                           0.0,
+                           [](auto&& lhs, auto&& rhs) { return lhs + rhs; })
+               == to.size());
+}
+
+/// Test transform_reduce
+BOOST_DATA_TEST_CASE_F(
+    vectors,
+    transform_reduce,
+    boost::unit_test::data::make({ Utopia::ExecPolicy::seq,
+                                   Utopia::ExecPolicy::unseq,
+                                   Utopia::ExecPolicy::par,
+                                   Utopia::ExecPolicy::par_unseq }),
+    policy)
+{
+    // Inner product
+    BOOST_TEST(
+      std::transform_reduce(policy, begin(to), end(to), begin(to), 0.0)
+      == to.size());
+    BOOST_TEST(std::transform_reduce(policy,
+                                     begin(to),
+                                     end(to),
+                                     begin(from),
+                                     0.0,
+                                     std::plus<>(),
+                                     std::plus<>())
+               == to.size());
+
+    // Unary transform
+    BOOST_TEST(std::transform_reduce(policy,
+                                     begin(to),
+                                     end(to),
+                                     0.0,
+                                     std::plus<>(),
+                                     [](auto&& val) { return 2 * val; })
+               == 2 * to.size());
+}
+
+/// Test count_if
+BOOST_DATA_TEST_CASE_F(
+    vectors,
+    count_if,
+    boost::unit_test::data::make({ Utopia::ExecPolicy::seq,
+                                   Utopia::ExecPolicy::unseq,
+                                   Utopia::ExecPolicy::par,
+                                   Utopia::ExecPolicy::par_unseq }),
+    policy)
+{
+    from[3] = 1.0;
+    from[42] = 1.0;
+    BOOST_TEST(std::count_if(policy,
+                             begin(from),
+                             end(from),
+                             [](auto&& val) { return val > 0.5; })
+               == 2);
+}
+
+/// Test copy_if
+BOOST_DATA_TEST_CASE_F(
+    vectors,
+    copy_if,
+    boost::unit_test::data::make({ Utopia::ExecPolicy::seq,
+                                   Utopia::ExecPolicy::unseq,
+                                   Utopia::ExecPolicy::par,
+                                   Utopia::ExecPolicy::par_unseq }),
+    policy)
+{
+    from[3] = 1.0;
+    from[42] = 1.0;
+    std::vector<double> selected(from.size());
+    const auto selected_end =
+      std::copy_if(policy,
+                   begin(from),
+                   end(from),
+                   begin(selected),
+                   [](auto&& val) { return val > 0.5; });
+    BOOST_TEST(std::distance(begin(selected), selected_end) == 2);
+    BOOST_TEST(selected[0] == 1.0);
+    BOOST_TEST(selected[1] == 1.0);
+}
+
+/// Test sort
+BOOST_DATA_TEST_CASE_F(
+    vectors,
+    sort,
+    boost::unit_test::data::make({ Utopia::ExecPolicy::seq,
+                                   Utopia::ExecPolicy::unseq,
+                                   Utopia::ExecPolicy::par,
+                                   Utopia::ExecPolicy::par_unseq }),
+    policy)
+{
+    std::iota(begin(from), end(from), 0.0);
+    std::sort(policy, begin(from), end(from), std::greater<>());
+    BOOST_TEST(std::is_sorted(begin(from), end(from), std::greater<>()));
+    std::sort(policy, begin(from), end(from));
+    BOOST_TEST(std::is_sorted(begin(from), end(from)));
+}
+
+/// Test inclusive_scan and exclusive_scan
+BOOST_DATA_TEST_CASE_F(
+    vectors,
+    scan,
+    boost::unit_test::data::make({ Utopia::ExecPolicy::seq,
+                                   Utopia::ExecPolicy::unseq,
+                                   Utopia::ExecPolicy::par,
+                                   Utopia::ExecPolicy::par_unseq }),
+    policy)
+{
+    std::inclusive_scan(policy, begin(to), end(to), begin(from));
+    BOOST_TEST(from.front() == 1.0);
+    BOOST_TEST(from.back() == to.size());
+
+    std::inclusive_scan(policy, begin(to), end(to), begin(from), std::plus<>());
+    BOOST_TEST(from.back() == to.size());
+
+    std::exclusive_scan(policy, begin(to), end(to), begin(from), 0.0);
+    BOOST_TEST(from.front() == 0.0);
+    BOOST_TEST(from.back() == to.size() - 1);
+
+    std::exclusive_scan(
+      policy, begin(to), end(to), begin(from), 1.0, std::plus<>());
+    BOOST_TEST(from.back() == to.size());
+}
+
+/// Test min_element and max_element
+BOOST_DATA_TEST_CASE_F(
+    vectors,
+    min_max_element,
+    boost::unit_test::data::make({ Utopia::ExecPolicy::seq,
+                                   Utopia::ExecPolicy::unseq,
+                                   Utopia::ExecPolicy::par,
+                                   Utopia::ExecPolicy::par_unseq }),
+    policy)
+{
+    from[3] = -1.0;
+    from[42] = 1.0;
+    const auto pos = [&](auto&& it) { return std::distance(begin(from), it); };
+    BOOST_TEST(pos(std::min_element(policy, begin(from), end(from))) == 3);
+    BOOST_TEST(pos(std::max_element(policy, begin(from), end(from))) == 42);
+    BOOST_TEST(
+      pos(std::min_element(policy, begin(from), end(from), std::greater<>()))
+      == 42);
+    BOOST_TEST(
+      pos(std::max_element(policy, begin(from), end(from), std::greater<>()))
+      == 3);
+}
+
+/// Test fill
+BOOST_DATA_TEST_CASE_F(
+    vectors,
+    fill,
+    boost::unit_test::data::make({ Utopia::ExecPolicy::seq,
+                                   Utopia::ExecPolicy::unseq,
+                                   Utopia::ExecPolicy::par,
+                                   Utopia::ExecPolicy::par_unseq }),
+    policy)
+{
+    std::fill(policy, begin(from), end(from), 1.0);
+    BOOST_TEST(from == to, boost::test_tools::per_element());
+}
+
+/// Test generate
+BOOST_DATA_TEST_CASE_F(
+    vectors,
+    generate,
+    boost::unit_test::data::make({ Utopia::ExecPolicy::seq,
+                                   Utopia::ExecPolicy::unseq,
+                                   Utopia::ExecPolicy::par,
+                                   Utopia::ExecPolicy::par_unseq }),
+    policy)
+{
+    std::generate(policy, begin(from), end(from), []() { return 1.0; });
+    BOOST_TEST(from == to, boost::test_tools::per_element());
+}
@@ -0,0 +1,208 @@
+#define BOOST_TEST_MODULE rng test
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <boost/mpl/vector.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <utopia/core/rng.hh>
+
+using Utopia::Xoshiro256PlusPlus;
+using Utopia::PCG64;
+using Utopia::BernoulliThreshold;
+using Utopia::BernoulliUniform;
+using Utopia::BernoulliTrial;
+
+/// The engines to test the generic functionality with
+using Engines = boost::mpl::vector<Xoshiro256PlusPlus, PCG64, std::mt19937>;
+
+/// A seed sequence that generates a fixed sequence of words
+struct FixedSeedSeq {
+    std::vector<std::uint32_t> words;
+
+    template<class It>
+    void generate (It first, It last) const {
+        for (std::size_t i = 0; first != last; ++first, ++i) {
+            *first = words.at(i);
+        }
+    }
+};
+
+
+/// Compare xoshiro256++ against the reference implementation
+BOOST_AUTO_TEST_CASE(xoshiro_reference)
+{
+    // State {1, 2, 3, 4}; the first output is rotl(1 + 4, 23) + 1
+    FixedSeedSeq seq{{0, 1, 0, 2, 0, 3, 0, 4}};
+    Xoshiro256PlusPlus rng(seq);
+    BOOST_TEST(rng() == 41943041u);
+
+    // The all-zero state is invalid and replaced by the default seed
+    FixedSeedSeq zeros{std::vector<std::uint32_t>(8, 0)};
+    Xoshiro256PlusPlus rng_zero(zeros);
+    BOOST_TEST((rng_zero == Xoshiro256PlusPlus{}));
+}
+
+/// Seeding, copying and discarding behaves like for the standard engines
+BOOST_AUTO_TEST_CASE_TEMPLATE(engine_interface, RNG, Engines)
+{
+    RNG rng(42), rng_same(42), rng_other(43);
+    BOOST_TEST((rng == rng_same));
+    BOOST_TEST((rng != rng_other));
+
+    std::vector<typename RNG::result_type> draws;
+    for (unsigned i = 0; i < 10; i++) {
+        draws.push_back(rng());
+    }
+    for (const auto draw : draws) {
+        BOOST_TEST(rng_same() == draw);
+    }
+
+    // Discarding is equivalent to drawing
+    RNG rng_discard(42);
+    rng_discard.discard(10);
+    BOOST_TEST((rng_discard == rng));
+
+    // Re-seeding restores the initial state
+    rng.seed(42);
+    BOOST_TEST(rng() == draws[0]);
+
+    // Seed sequences lead to different states for different seeds
+    std::seed_seq seq1{1, 2, 3}, seq2{1, 2, 4};
+    RNG rng_seq1(seq1), rng_seq2(seq2);
+    BOOST_TEST((rng_seq1 != rng_seq2));
+
+    // Usable with the standard distributions
+    std::uniform_int_distribution<int> dist(0, 5);
+    const auto value = dist(rng);
+    BOOST_TEST(value >= 0);
+    BOOST_TEST(value <= 5);
+}
+
+/// Bernoulli trials via integer thresholds have the expected statistics
+BOOST_AUTO_TEST_CASE_TEMPLATE(bernoulli_threshold, RNG, Engines)
+{
+    RNG rng(42);
+    const std::size_t n = 200000;
+
+    for (const double p : {0., .001, .3, .5, 1.}) {
+        const BernoulliThreshold<RNG> trial(p);
+        std::size_t num_successes = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            num_successes += trial(rng);
+        }
+
+        const double mean = double(num_successes) / n;
+        BOOST_TEST(std::abs(mean - p) < .005);
+        if (p == 0.) {
+            BOOST_TEST(num_successes == 0u);
+        }
+        else if (p == 1.) {
+            BOOST_TEST(num_successes == n);
+        }
+    }
+
+    BOOST_CHECK_THROW(BernoulliThreshold<RNG>(-.1), std::invalid_argument);
+    BOOST_CHECK_THROW(BernoulliThreshold<RNG>(1.1), std::invalid_argument);
+}
+
+/// Bernoulli trials via uniform real numbers draw like the distribution
+BOOST_AUTO_TEST_CASE_TEMPLATE(bernoulli_uniform, RNG, Engines)
+{
+    RNG rng(42), rng_ref(42);
+    std::uniform_real_distribution<double> distr(0., 1.);
+
+    for (const double p : {0., .2, .5, 1.}) {
+        const BernoulliUniform<RNG> trial(p);
+        for (std::size_t i = 0; i < 10000; i++) {
+            BOOST_TEST_REQUIRE(trial(rng) == (distr(rng_ref) < p));
+        }
+    }
+
+    BOOST_CHECK_THROW(BernoulliUniform<RNG>(-.1), std::invalid_argument);
+    BOOST_CHECK_THROW(BernoulliUniform<RNG>(1.1), std::invalid_argument);
+
+    // Only the default engine uses this type of trial
+    BOOST_TEST((std::is_same_v<BernoulliTrial<Utopia::DefaultRNG>,
+                               BernoulliUniform<Utopia::DefaultRNG>>));
+    BOOST_TEST((std::is_same_v<BernoulliTrial<Xoshiro256PlusPlus>,
+                               BernoulliThreshold<Xoshiro256PlusPlus>>));
+}
+
+/// Batched sampling of uniform numbers and Bernoulli outcomes
+BOOST_AUTO_TEST_CASE_TEMPLATE(batched_sampling, RNG, Engines)
+{
+    RNG rng(42), rng_ref(42);
+
+    // Use a size that is not a multiple of the internal block size
+    std::vector<double> uniform(100003, -1.);
+    Utopia::fill_uniform(rng, uniform.begin(), uniform.end());
+
+    double sum = 0.;
+    for (const auto u : uniform) {
+        BOOST_TEST_REQUIRE(u >= 0.);
+        BOOST_TEST_REQUIRE(u < 1.);
+        sum += u;
+    }
+    BOOST_TEST(sum / uniform.size() == .5,
+               boost::test_tools::tolerance(.01));
+
+    // Each number takes a single engine invocation
+    rng_ref.discard(uniform.size());
+    BOOST_TEST((rng == rng_ref));
+
+    std::vector<char> outcomes(100003, 2);
+    for (const double p : {0., .2, 1.}) {
+        Utopia::fill_bernoulli(rng, p, outcomes.begin(), outcomes.end());
+
+        std::size_t num_successes = 0;
+        for (const auto o : outcomes) {
+            BOOST_TEST_REQUIRE((o == 0 or o == 1));
+            num_successes += o;
+        }
+        const double mean = double(num_successes) / outcomes.size();
+        BOOST_TEST(std::abs(mean - p) < .005);
+    }
+
+    // The outcomes are those of the equivalent single trials
+    RNG rng_batch(43), rng_single(43);
+    const BernoulliThreshold<RNG> trial(.3);
+    Utopia::fill_bernoulli(rng_batch, .3, outcomes.begin(), outcomes.end());
+    for (const auto o : outcomes) {
+        BOOST_TEST_REQUIRE(bool(o) == trial(rng_single));
+    }
+
+    BOOST_CHECK_THROW(Utopia::fill_bernoulli(rng, 1.5, outcomes.begin(),
+                                             outcomes.end()),
+                      std::invalid_argument);
+}
+
+/// Split engines are reproducible and draw different sequences
+BOOST_AUTO_TEST_CASE_TEMPLATE(split_rng, RNG, Engines)
+{
+    RNG rng(42), rng_again(42);
+    auto rngs = Utopia::split_rng(rng, 4);
+    auto rngs_again = Utopia::split_rng(rng_again, 4);
+    BOOST_TEST(rngs.size() == 4u);
+    BOOST_TEST((rng == rng_again));
+
+    std::vector<std::vector<typename RNG::result_type>> draws;
+    for (std::size_t i = 0; i < rngs.size(); ++i) {
+        BOOST_TEST((rngs[i] == rngs_again[i]));
+
+        draws.emplace_back();
+        for (std::size_t n = 0; n < 16; ++n) {
+            draws.back().push_back(rngs[i]());
+        }
+    }
+    for (std::size_t i = 0; i < draws.size(); ++i) {
+        for (std::size_t j = i + 1; j < draws.size(); ++j) {
+            BOOST_TEST((draws[i] != draws[j]));
+        }
+    }
+
+    BOOST_TEST(Utopia::split_rng(rng, 0).empty());
+}
@@ -68,6 +68,14 @@ BOOST_FIXTURE_TEST_CASE(interface, ModelFixture)
 
     auto a3 = select_entities<SelectionMode::condition>(am, always_true);
     BOOST_TEST(a3.size() == am.entities().size());
+
+    // With an execution policy, the same entities are selected, in order
+    auto has_odd_id = [](const auto& e){ return e->id() % 2 == 1; };
+    auto c4 = select_entities<SelectionMode::condition>(cm, has_odd_id);
+    auto c5 = cm.select_cells<SelectionMode::condition>(has_odd_id,
+                                                        ExecPolicy::par);
+    BOOST_TEST(c5.size() == cm.entities().size() / 2);
+    BOOST_TEST(c4 == c5, boost::test_tools::per_element());
 }
 
 // -- Selection Mode Tests (on AgentManager) ----------------------------------
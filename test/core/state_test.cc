@@ -54,6 +54,26 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(synchronous, Fix, StateList, Fix)
     BOOST_TEST(sc.state() == Fix::state_2);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(synchronous_swap, Fix, StateList, Fix)
+{
+    Utopia::StateContainer<typename Fix::StateType,
+                           Utopia::Update::sync> sc(Fix::state_1);
+    sc.state_new() = Fix::state_2;
+
+    // Swapping makes the cache the current state ...
+    sc.swap_buffers();
+    BOOST_TEST(sc.state() == Fix::state_2);
+
+    // ... and the previous state the cache
+    BOOST_TEST(sc.state_new() == Fix::state_1);
+
+    // Copy-updates still work afterwards
+    sc.state_new() = Fix::state_2;
+    sc.update();
+    BOOST_TEST(sc.state() == Fix::state_2);
+    BOOST_TEST(sc.state_new() == Fix::state_2);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(manual, Fix, StateList, Fix)
 {
     // Check initialization
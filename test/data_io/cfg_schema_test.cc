@@ -0,0 +1,119 @@
+#define BOOST_TEST_MODULE test cfg_schema
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <utopia/data_io/cfg_schema.hh>
+#include <utopia/core/testtools.hh>
+
+
+using namespace Utopia;
+using namespace Utopia::TestTools;
+
+
+// -- Types -------------------------------------------------------------------
+
+struct SpeciesParams {
+    double init_resources;
+    unsigned num_offspring;
+};
+
+struct TestParams {
+    double p_growth;
+    int some_int;
+    std::string mode;
+    double temperature;
+    SpeciesParams species;
+};
+
+/// Construct the schema used in the tests below
+ConfigSchema<TestParams> make_schema () {
+    const auto species_schema = ConfigSchema<SpeciesParams>("species")
+        .required("init_resources", &SpeciesParams::init_resources,
+                  is_non_negative<double>())
+        .optional("num_offspring", &SpeciesParams::num_offspring, 1u);
+
+    return ConfigSchema<TestParams>("test parameters")
+        .required("p_growth", &TestParams::p_growth, is_probability())
+        .required("some_int", &TestParams::some_int, in_interval(-3, 3))
+        .required("mode", &TestParams::mode)
+        .optional("temperature", &TestParams::temperature, 20.,
+                  is_positive<double>())
+        .nested("species", &TestParams::species, species_schema);
+}
+
+
+// -- Test cases --------------------------------------------------------------
+
+/// Test that a valid configuration is parsed into the struct
+BOOST_AUTO_TEST_CASE(test_parse) {
+    const auto schema = make_schema();
+
+    const auto params = schema.parse(YAML::Load(
+        "{p_growth: 0.1, some_int: -2, mode: foo, "
+        " species: {init_resources: 2.5, num_offspring: 3}}"
+    ));
+    BOOST_TEST(params.p_growth == 0.1);
+    BOOST_TEST(params.some_int == -2);
+    BOOST_TEST(params.mode == "foo");
+    BOOST_TEST(params.temperature == 20.);
+    BOOST_TEST(params.species.init_resources == 2.5);
+    BOOST_TEST(params.species.num_offspring == 3u);
+
+    // Optional values are taken from the config, if given
+    const auto shared = schema.parse_shared(YAML::Load(
+        "{p_growth: 1., some_int: 3, mode: bar, temperature: 1.5, "
+        " species: {init_resources: 0.}}"
+    ));
+    BOOST_TEST(shared->temperature == 1.5);
+    BOOST_TEST(shared->species.num_offspring == 1u);
+}
+
+/// Test that all errors of a configuration are reported at once
+BOOST_AUTO_TEST_CASE(test_errors) {
+    const auto schema = make_schema();
+
+    // Missing, invalid, and unconvertible entries, also in nested structs
+    check_exception<std::invalid_argument>(
+        [&](){
+            schema.parse(YAML::Load(
+                "{p_growth: 1.5, some_int: foo, temperature: -1., "
+                " species: {num_offspring: 2}}"
+            ));
+        },
+        "Invalid test parameters configuration:\n"
+        "  - Entry 'p_growth' needs to be a probability, i.e. in interval "
+        "[0, 1], but was '1.5'\n"
+        "  - Could not convert entry 'some_int' with value 'foo' to type "
+        "int\n"
+        "  - Missing required entry 'mode'\n"
+        "  - Entry 'temperature' needs to be positive, but was '-1.'\n"
+        "  - Missing required entry 'species.init_resources'"
+    );
+
+    check_exception<std::invalid_argument>(
+        [&](){
+            schema.parse(YAML::Load(
+                "{p_growth: 0., some_int: 4, mode: foo, species: 42}"
+            ));
+        },
+        "Entry 'some_int' needs to be in interval [-3, 3], but was '4'"
+    );
+    check_exception<std::invalid_argument>(
+        [&](){
+            schema.parse(YAML::Load(
+                "{p_growth: 0., some_int: 0, mode: foo, species: 42}"
+            ));
+        },
+        "Expected a mapping for 'species', but got:\n42"
+    );
+
+    // Not a mapping at all
+    check_exception<std::invalid_argument>(
+        [&](){
+            schema.parse(YAML::Load("[1, 2, 3]"));
+        },
+        "Expected a mapping, but got"
+    );
+}
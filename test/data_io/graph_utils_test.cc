@@ -3,6 +3,10 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/vector.hpp>
 
+#include <map>
+#include <random>
+#include <tuple>
+
 #include <utopia/data_io/graph_utils.hh>
 #include <utopia/data_io/hdfgroup.hh>
 #include <utopia/data_io/hdffile.hh>
@@ -536,3 +540,143 @@ BOOST_AUTO_TEST_CASE(test_attribute_writing_save_graph_entity_properties) {
     // Remove the graph testsfile
     std::remove("graph_testfile.h5");
 }
+
+/// Test the GraphDeltaWriter by replaying the written edge deltas
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_graph_delta_writer, G,
+                                SmallGraphsVecSFixtures, G)
+{
+    using Utopia::DataIO::GraphDeltaWriter;
+    using Utopia::DataIO::load_graph_delta_edges;
+
+    // Create a test HDFFile and a HDFGroup
+    auto hdf = Utopia::DataIO::HDFFile("graph_testfile.h5","w");
+    auto grp = hdf.open_group("testgroup");
+    auto ggrp = create_graph_group(G::g, grp, "testgraph");
+
+    // Write a keyframe every three write operations
+    GraphDeltaWriter writer(G::g, ggrp, 3);
+
+    // Rewire the graph, keeping the expected edge list of each time
+    std::mt19937 rng(42);
+    std::map<std::size_t, std::vector<std::pair<std::size_t, std::size_t>>>
+        expected;
+
+    for (std::size_t t = 0; t < 10; ++t) {
+        if (t > 0) {
+            // Remove a random edge and add two new ones
+            remove_edge(random_edge(G::g, rng), G::g);
+            add_edge(random_vertex(G::g, rng), random_vertex(G::g, rng),
+                     Edge{0.f}, G::g);
+            add_edge(random_vertex(G::g, rng), random_vertex(G::g, rng),
+                     Edge{0.f}, G::g);
+        }
+
+        // Skip a write operation to check lookup between written times
+        if (t == 5) {
+            continue;
+        }
+
+        writer.write(G::g, t);
+        expected[t] = writer.edges();
+    }
+    BOOST_TEST(writer.num_writes() == 9);
+
+    // Replay and compare to the edge lists kept by the writer
+    for (const auto& [t, edges] : expected) {
+        BOOST_TEST(load_graph_delta_edges(ggrp, t) == edges);
+    }
+
+    // Times without write operation return the preceding edge list
+    BOOST_TEST(load_graph_delta_edges(ggrp, 5) == expected[4]);
+    BOOST_TEST(load_graph_delta_edges(ggrp, 42) == expected[9]);
+
+    // Keyframes are written at the first, fourth and seventh write operation
+    auto kf_times = std::get<1>(
+        ggrp->open_group("_edge_delta")->open_dataset("keyframe_times")
+            ->template read<std::vector<std::size_t>>()
+    );
+    BOOST_TEST(kf_times == (std::vector<std::size_t>{0, 3, 7}));
+
+    // Keyframes have the same layout as full edge lists
+    auto kf_shape = std::get<0>(
+        ggrp->open_group("_edges")->open_dataset("7")
+            ->template read<std::vector<std::size_t>>()
+    );
+    BOOST_TEST(kf_shape == (std::vector<hsize_t>{2, expected[7].size()}));
+
+    // Remove the graph testsfile
+    std::remove("graph_testfile.h5");
+}
+
+/// Edge properties written in the order of the GraphDeltaWriter's edge
+/// descriptors can be associated with the reconstructed edge lists
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_graph_delta_writer_edge_properties, G,
+                                SmallGraphsVecSFixtures, G)
+{
+    using Utopia::DataIO::GraphDeltaWriter;
+    using Utopia::DataIO::load_graph_delta_edges;
+    using Triple = std::tuple<std::size_t, std::size_t, float>;
+
+    auto hdf = Utopia::DataIO::HDFFile("graph_testfile.h5","w");
+    auto grp = hdf.open_group("testgroup");
+    auto ggrp = create_graph_group(G::g, grp, "testgraph");
+
+    GraphDeltaWriter writer(G::g, ggrp, 4);
+    const auto num_edges = boost::num_edges(G::g);
+    auto dset_weights = ggrp->open_dataset("edge_weights",
+                                           {10, num_edges});
+
+    // Rewire the graph and change all weights, keeping the expected
+    // (source, target, weight) triples of each time
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    std::vector<std::vector<Triple>> expected;
+
+    for (std::size_t t = 0; t < 10; ++t) {
+        if (t > 0) {
+            remove_edge(random_edge(G::g, rng), G::g);
+            add_edge(random_vertex(G::g, rng), random_vertex(G::g, rng),
+                     Edge{dist(rng)}, G::g);
+        }
+        for (auto [e, e_end] = edges(G::g); e != e_end; ++e) {
+            G::g[*e].weight = dist(rng);
+        }
+
+        writer.write(G::g, t);
+        const auto& eds = writer.edge_descriptors();
+        dset_weights->write(eds.begin(), eds.end(),
+                            [&](auto ed){ return G::g[ed].weight; });
+
+        expected.emplace_back();
+        for (auto [e, e_end] = edges(G::g); e != e_end; ++e) {
+            std::size_t s = source(*e, G::g), u = target(*e, G::g);
+            if (not boost::is_directed(G::g) and u < s) {
+                std::swap(s, u);
+            }
+            expected.back().emplace_back(s, u, G::g[*e].weight);
+        }
+        std::sort(expected.back().begin(), expected.back().end());
+    }
+
+    // Rebuild the triples from the reconstructed edges and the weights
+    const auto weights = std::get<1>(
+        dset_weights->template read<std::vector<float>>()
+    );
+    BOOST_TEST(weights.size() == 10 * num_edges);
+
+    for (std::size_t t = 0; t < 10; ++t) {
+        const auto edge_list = load_graph_delta_edges(ggrp, t);
+        BOOST_TEST_REQUIRE(edge_list.size() == num_edges);
+
+        std::vector<Triple> rebuilt;
+        for (std::size_t i = 0; i < num_edges; ++i) {
+            rebuilt.emplace_back(edge_list[i].first, edge_list[i].second,
+                                 weights[t * num_edges + i]);
+        }
+        std::sort(rebuilt.begin(), rebuilt.end());
+        BOOST_TEST((rebuilt == expected[t]));
+    }
+
+    std::remove("graph_testfile.h5");
+}
+
@@ -1,6 +1,8 @@
 #define BOOST_TEST_MODULE dataset_functionality_test
 
+#include <cmath>
 #include <iostream>
+#include <map>
 
 #include <utopia/data_io/hdfdataset.hh>
 #include <utopia/data_io/hdffile.hh>
@@ -923,3 +925,237 @@ BOOST_AUTO_TEST_CASE(dataset_read_test)
         BOOST_TEST(std::abs(fithdata[i] - 3.14) < 1e-16);
     }
 }
+
+BOOST_AUTO_TEST_CASE(dataset_write_buffer_test)
+{
+    Utopia::setup_loggers();
+
+    HDFFile file("dataset_buffer_testfile.h5", "w");
+    auto dset = file.open_dataset("/buffered", { H5S_UNLIMITED, 4 }, { 4, 4 });
+
+    BOOST_TEST(dset->get_write_buffer_size() == 1);
+    dset->set_write_buffer_size(3);
+    BOOST_TEST(dset->get_write_buffer_size() == 3);
+
+    // The first two rows are only buffered, the third one flushes the buffer
+    dset->write(std::vector< double >(4, 0.));
+    dset->write(std::vector< double >(4, 1.));
+    BOOST_TEST(dset->get_num_buffered_slices() == 2);
+    BOOST_TEST(H5Lexists(file.get_C_id(), "/buffered", H5P_DEFAULT) == 0);
+
+    dset->write(std::vector< double >(4, 2.));
+    BOOST_TEST(dset->get_num_buffered_slices() == 0);
+    BOOST_TEST(dset->get_current_extent() == (hsizevec{ 3, 4 }));
+
+    // Further rows are appended as a block once the buffer is full again
+    for (std::size_t i = 3; i < 7; ++i)
+    {
+        dset->write(std::vector< double >(4, i));
+    }
+    BOOST_TEST(dset->get_num_buffered_slices() == 1);
+    BOOST_TEST(dset->get_current_extent() == (hsizevec{ 6, 4 }));
+
+    // An explicit flush writes the remaining rows
+    dset->flush();
+    BOOST_TEST(dset->get_num_buffered_slices() == 0);
+    BOOST_TEST(dset->get_current_extent() == (hsizevec{ 7, 4 }));
+
+    // Writes that cannot be buffered flush the buffer first
+    dset->write(std::vector< double >(4, 7.));
+    BOOST_TEST(dset->get_num_buffered_slices() == 1);
+    boost::multi_array< double, 2 > block(boost::extents[1][4]);
+    std::fill(block.data(), block.data() + block.num_elements(), 8.);
+    dset->write_nd(block);
+    BOOST_TEST(dset->get_num_buffered_slices() == 0);
+    BOOST_TEST(dset->get_current_extent() == (hsizevec{ 9, 4 }));
+
+    // Closing the dataset flushes the buffer as well
+    dset->write(std::vector< double >(4, 9.));
+    dset->close();
+
+    dset = file.open_dataset("/buffered");
+    auto [shape, data] = dset->read< std::vector< double > >();
+    BOOST_TEST(shape == (hsizevec{ 10, 4 }));
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        BOOST_TEST(data[i] == double(i / 4));
+    }
+
+    // A buffer size of zero disables buffering
+    dset->set_write_buffer_size(0);
+    dset->write(std::vector< double >(4, 10.));
+    BOOST_TEST(dset->get_num_buffered_slices() == 0);
+    BOOST_TEST(dset->get_current_extent() == (hsizevec{ 11, 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(dataset_direct_chunk_write_test)
+{
+    Utopia::setup_loggers();
+
+    HDFFile file("dataset_chunk_testfile.h5", "w");
+
+    // Rows of the test data; compressible, but not trivially so
+    auto row = [](std::size_t i) {
+        std::vector< int > data(10);
+        for (std::size_t j = 0; j < data.size(); ++j)
+        {
+            data[j] = (i * 7 + j * j) % 13;
+        }
+        return data;
+    };
+
+    // Chunks that do not align with the buffer and do not divide the width;
+    // both with compression, without, and with a fixed capacity
+    const std::vector< std::pair< std::string, std::size_t > > cases{
+        { "/compressed", 5 }, { "/uncompressed", 0 }, { "/fixed", 3 }
+    };
+
+    for (const auto& [path, level] : cases)
+    {
+        const hsize_t capacity = (path == "/fixed") ? 22 : H5S_UNLIMITED;
+        auto dset = file.open_dataset(path, { capacity, 10 }, { 4, 3 }, level);
+        dset->set_write_buffer_size(6);
+        dset->set_direct_chunk_write(true);
+        BOOST_TEST(dset->get_direct_chunk_write());
+
+        for (std::size_t i = 0; i < 22; ++i)
+        {
+            dset->write(row(i));
+        }
+        BOOST_TEST(dset->get_current_extent() == (hsizevec{ 18, 10 }));
+        dset->close();
+
+        dset = file.open_dataset(path);
+        auto [shape, data] = dset->read< std::vector< int > >();
+        BOOST_TEST(shape == (hsizevec{ 22, 10 }));
+        for (std::size_t i = 0; i < 22; ++i)
+        {
+            const auto expected = row(i);
+            BOOST_TEST(std::equal(expected.begin(), expected.end(),
+                                  data.begin() + i * 10));
+        }
+
+        // The chunks were compressed, if requested
+        const auto storage_size = H5Dget_storage_size(dset->get_C_id());
+        if (level > 0)
+        {
+            BOOST_TEST(storage_size < 22 * 10 * sizeof(int));
+        }
+        else
+        {
+            BOOST_TEST(storage_size >= 22 * 10 * sizeof(int));
+        }
+    }
+
+    // Single slices are written directly if chunks span a single slice
+    auto dset = file.open_dataset("/single", { H5S_UNLIMITED, 10 }, { 1, 10 },
+                                  9);
+    dset->set_direct_chunk_write(true);
+    dset->write(row(0));
+    BOOST_TEST(dset->get_num_buffered_slices() == 0);
+    BOOST_TEST(dset->get_current_extent() == (hsizevec{ 1, 10 }));
+}
+
+BOOST_AUTO_TEST_CASE(dataset_float_precision_test)
+{
+    Utopia::setup_loggers();
+
+    HDFFile file("dataset_precision_testfile.h5", "w");
+
+    // Rows of smoothly varying values
+    auto row = [](std::size_t i) {
+        std::vector< double > data(500);
+        for (std::size_t j = 0; j < data.size(); ++j)
+        {
+            data[j] = 100. * std::sin(0.01 * j + 0.1 * i) + 1. / (j + 1);
+        }
+        return data;
+    };
+
+    // Rounding the mantissa
+    std::vector< double > values{ 1.2345678, -987.654321, 0., 1e-300 };
+    round_mantissa(values.data(), values.size(), 3);
+    BOOST_TEST(values[0] == 1.2345678, boost::test_tools::tolerance(1e-3));
+    BOOST_TEST(values[1] == -987.654321, boost::test_tools::tolerance(1e-3));
+    BOOST_TEST(values[2] == 0.);
+
+    BOOST_CHECK_THROW(float_precision_from_string("half"),
+                      std::invalid_argument);
+
+    const std::vector< std::pair< std::string, unsigned int > > modes{
+        { "full", 0 }, { "float32", 0 }, { "scale_offset", 3 },
+        { "bit_round", 4 }
+    };
+
+    std::map< std::string, hsize_t > storage_sizes;
+    for (const auto& [mode, digits] : modes)
+    {
+        auto dset = file.open_dataset("/" + mode, { 20, 500 }, {}, 1);
+        dset->set_float_precision(float_precision_from_string(mode), digits);
+        BOOST_TEST(dset->get_float_digits() == digits);
+
+        for (std::size_t i = 0; i < 20; ++i)
+        {
+            dset->write(row(i));
+        }
+        dset->close();
+        dset = file.open_dataset("/" + mode);
+        storage_sizes[mode] = H5Dget_storage_size(dset->get_C_id());
+
+        // Values are retained to the given precision
+        std::vector< double > data;
+        if (mode == "float32")
+        {
+            const auto [shape, fdata] = dset->read< std::vector< float > >();
+            data.assign(fdata.begin(), fdata.end());
+        }
+        else
+        {
+            data = std::get< 1 >(dset->read< std::vector< double > >());
+        }
+        BOOST_TEST(data.size() == 20u * 500u);
+
+        const double tolerance = (mode == "full")         ? 0.
+                                 : (mode == "float32")    ? 1e-5
+                                 : (mode == "scale_offset") ? 1e-3
+                                                            : 1e-2;
+        for (std::size_t i = 0; i < 20; ++i)
+        {
+            const auto expected = row(i);
+            for (std::size_t j = 0; j < 500; ++j)
+            {
+                BOOST_TEST(std::abs(data[i * 500 + j] - expected[j]) <=
+                           tolerance * std::max(1., std::abs(expected[j])));
+            }
+        }
+    }
+
+    // All reduced modes take less space
+    BOOST_TEST(storage_sizes["float32"] < storage_sizes["full"]);
+    BOOST_TEST(storage_sizes["scale_offset"] < storage_sizes["full"]);
+    BOOST_TEST(storage_sizes["bit_round"] < storage_sizes["full"] / 2);
+
+    // One-dimensional datasets are rounded as well, be it when writing
+    // containers or scalars
+    auto dset_1d = file.open_dataset("/bit_round_1d", { 504 });
+    dset_1d->set_float_precision(FloatPrecision::bit_round, 4);
+    dset_1d->write(row(0));
+    for (const double value : values)
+    {
+        dset_1d->write(100. * std::sin(value) + 1. / 3.);
+    }
+    dset_1d->close();
+
+    auto expected_1d = row(0);
+    for (const double value : values)
+    {
+        expected_1d.push_back(100. * std::sin(value) + 1. / 3.);
+    }
+    round_mantissa(expected_1d.data(), expected_1d.size(), 4);
+
+    dset_1d = file.open_dataset("/bit_round_1d");
+    const auto [shape_1d, data_1d] =
+        dset_1d->read< std::vector< double > >();
+    BOOST_TEST(shape_1d == std::vector< hsize_t >{ 504 });
+    BOOST_TEST(data_1d == expected_1d, boost::test_tools::per_element());
+}
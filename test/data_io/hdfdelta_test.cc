@@ -0,0 +1,148 @@
+#define BOOST_TEST_MODULE hdfdelta_test
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <utopia/core/logging.hh>
+#include <utopia/data_io/hdfdelta.hh>
+#include <utopia/data_io/hdffile.hh>
+
+using namespace Utopia::DataIO;
+
+struct Fix
+{
+    void
+    setup()
+    {
+        Utopia::setup_loggers();
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(Suite, *boost::unit_test::fixture< Fix >())
+
+/// Test that the frames are reconstructed as they were written
+BOOST_AUTO_TEST_CASE(delta_write_and_read)
+{
+    const std::size_t num_entries = 1000;
+    const std::size_t num_frames = 23;
+
+    std::mt19937                             rng(42);
+    std::uniform_int_distribution< std::size_t > pick(0, num_entries - 1);
+
+    // Change a few entries per frame; leave one frame unchanged
+    std::vector< std::vector< int > > frames;
+    std::vector< int >                frame(num_entries, 0);
+    for (std::size_t f = 0; f < num_frames; ++f)
+    {
+        if (f != 6)
+        {
+            for (int c = 0; c < 10; ++c)
+            {
+                frame[pick(rng)] = f * 10 + c;
+            }
+        }
+        frames.push_back(frame);
+    }
+
+    // Write at times 0, 2, 4, ...
+    {
+        HDFFile            file("delta_test.h5", "w");
+        DeltaWriter< int > writer(*file.get_basegroup(), "data", num_entries, 5);
+
+        for (std::size_t f = 0; f < num_frames; ++f)
+        {
+            writer.write(
+                frames[f].begin(), frames[f].end(), [](auto v) { return v; },
+                2 * f);
+        }
+        BOOST_TEST(writer.get_num_frames() == num_frames);
+        BOOST_TEST(writer.get_keyframe_interval() == 5u);
+        BOOST_TEST(writer.get_num_changes() > 0u);
+        BOOST_TEST(writer.get_num_changes() <= 10 * num_frames);
+
+        BOOST_CHECK_THROW(writer.write(std::vector< int >(3), 2 * num_frames),
+                          std::invalid_argument);
+    }
+
+    HDFFile file("delta_test.h5", "r");
+    auto    base      = file.get_basegroup();
+    auto    delta_grp = file.open_group("data_delta");
+
+    // 5 keyframes, each stored as a dataset named by its time ...
+    auto [kft_shape, keyframe_times] =
+        delta_grp->open_dataset("keyframe_times")
+            ->read< std::vector< std::size_t > >();
+    BOOST_TEST(keyframe_times ==
+               (std::vector< std::size_t >{ 0, 10, 20, 30, 40 }));
+
+    auto [kf_shape, keyframe] = file.open_group("data")
+                                    ->open_dataset("10")
+                                    ->read< std::vector< int > >();
+    BOOST_TEST(kf_shape == (std::vector< hsize_t >{ num_entries }));
+    BOOST_TEST(keyframe == frames[5]);
+
+    // ... all others are stored as changes
+    auto [nc_shape, num_changes] =
+        delta_grp->open_dataset("num_changes")
+            ->read< std::vector< std::size_t > >();
+    BOOST_TEST(nc_shape == (std::vector< hsize_t >{ num_frames - 5 }));
+    BOOST_TEST(num_changes[4] == 0u); // frame 6, after keyframe 5
+
+    for (std::size_t f = 0; f < num_frames; ++f)
+    {
+        BOOST_TEST(load_delta_frame< int >(base, "data", 2 * f) == frames[f]);
+    }
+
+    // Times in between yield the latest frame before them
+    BOOST_TEST(load_delta_frame< int >(base, "data", 13) == frames[6]);
+    BOOST_TEST(load_delta_frame< int >(base, "data", 1000) == frames.back());
+
+    file.close();
+    std::remove("delta_test.h5");
+}
+
+/// Test frames without any changes and only a single keyframe
+BOOST_AUTO_TEST_CASE(delta_edge_cases)
+{
+    {
+        HDFFile               file("delta_test_edge.h5", "w");
+        DeltaWriter< double > writer(*file.get_basegroup(), "data", 4, 0);
+        for (std::size_t t = 1; t < 4; ++t)
+        {
+            writer.write(std::vector< double >{ 1., 2., 3., 4. }, t);
+        }
+        BOOST_TEST(writer.get_num_changes() == 0u);
+
+        for (std::size_t t = 4; t < 20; ++t)
+        {
+            writer.write(std::vector< double >{ 1., 2., double(t), 4. }, t);
+        }
+    }
+
+    HDFFile file("delta_test_edge.h5", "r");
+    auto    base      = file.get_basegroup();
+    auto    delta_grp = file.open_group("data_delta");
+
+    // With an interval of 0, only the first frame is a keyframe
+    auto [kft_shape, keyframe_times] =
+        delta_grp->open_dataset("keyframe_times")
+            ->read< std::vector< std::size_t > >();
+    BOOST_TEST(keyframe_times == (std::vector< std::size_t >{ 1 }));
+
+    BOOST_TEST(load_delta_frame< double >(base, "data", 3) ==
+               (std::vector< double >{ 1., 2., 3., 4. }));
+    BOOST_TEST(load_delta_frame< double >(base, "data", 19) ==
+               (std::vector< double >{ 1., 2., 19., 4. }));
+
+    // There is no frame before the first write
+    BOOST_CHECK_THROW(load_delta_frame< double >(base, "data", 0),
+                      std::invalid_argument);
+
+    file.close();
+    std::remove("delta_test_edge.h5");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -132,4 +132,63 @@ BOOST_AUTO_TEST_CASE(file_functionality)
     std::remove("filetest_functionality.h5");
 }
 
+BOOST_AUTO_TEST_CASE(file_swmr)
+{
+    HDFFile file("filetest_swmr.h5", "w", true);
+    BOOST_TEST(file.is_valid());
+    BOOST_TEST(not file.is_swmr_write());
+
+    // all datasets and attributes need to exist before switching to SWMR
+    auto dataset = file.open_dataset("/swmr/dset", { H5S_UNLIMITED, 3 });
+    dataset->add_attribute("some attribute", 42);
+    dataset->write(std::vector< int >{ 1, 2, 3 });
+
+    // objects may only be referenced by a single identifier when switching
+    {
+        HDFDataset copy(*dataset);
+        BOOST_CHECK_THROW(file.start_swmr_write(), std::runtime_error);
+        BOOST_TEST(not file.is_swmr_write());
+    }
+
+    file.start_swmr_write();
+    BOOST_TEST(file.is_swmr_write());
+
+    // datasets opened beforehand need to be told to flush their data ...
+    BOOST_TEST(not dataset->get_swmr_flush());
+    dataset->set_swmr_flush(true);
+
+    // ... while those opened afterwards notice on their own
+    BOOST_TEST(file.open_dataset("/swmr/dset")->get_swmr_flush());
+
+    // datasets can still be extended
+    dataset->write(std::vector< int >{ 4, 5, 6 });
+    dataset->write(std::vector< int >{ 7, 8, 9 });
+    dataset->close();
+
+    file.close();
+    BOOST_TEST(not file.is_valid());
+
+    // switching a file without SWMR support fails
+    HDFFile other("filetest_swmr_other.h5", "w");
+    BOOST_CHECK_THROW(other.start_swmr_write(), std::runtime_error);
+    other.close();
+
+    // read the data back in SWMR reading mode
+    file.open("filetest_swmr.h5", "r", true);
+    BOOST_TEST(file.is_valid());
+
+    auto [shape, data] =
+        file.open_dataset("/swmr/dset")->read< std::vector< int > >();
+    BOOST_TEST(shape == (std::vector< hsize_t >{ 3, 3 }));
+    BOOST_TEST(data == (std::vector< int >{ 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+    auto attr = HDFAttribute(*file.open_dataset("/swmr/dset"),
+                             "some attribute");
+    BOOST_TEST(std::get< 1 >(attr.read< int >()) == 42);
+
+    file.close();
+    std::remove("filetest_swmr.h5");
+    std::remove("filetest_swmr_other.h5");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
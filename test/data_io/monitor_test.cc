@@ -198,3 +198,71 @@ BOOST_FIXTURE_TEST_CASE(test_monitoring_nested, Infrastructure) {
     const auto output = sbuf.str();
     BOOST_TEST(output == expected_output);
 }
+
+
+/// Test emission in JSON format, asynchronously, and via entry handles
+BOOST_FIXTURE_TEST_CASE(test_monitoring_json_async, Infrastructure) {
+    using namespace std::chrono_literals;
+
+    BOOST_TEST((monitor_format_from_string("json") == MonitorFormat::json));
+    check_exception<std::invalid_argument>(
+        [](){ monitor_format_from_string("xml"); },
+        "Invalid monitor format 'xml'"
+    );
+
+    // JSON lines come without the YAML tag, such that they are valid JSON
+    BOOST_TEST(monitor_emit_prefix(MonitorFormat::yaml) == "!!map ");
+    BOOST_TEST(monitor_emit_prefix(MonitorFormat::json) == "");
+
+    auto sbuf = replace_cout();
+    {
+        auto rm = std::make_shared<MonitorManager>(
+            0.002, monitor_emit_prefix(MonitorFormat::json), "",
+            MonitorFormat::json, true
+        );
+        BOOST_TEST((rm->get_format() == MonitorFormat::json));
+
+        // Entries are emitted in the order of their registration
+        rm->set_time_entries(2, 4);
+
+        Monitor m("m", rm);
+        Monitor mm("mm", m);
+        auto counter = mm.register_entry("counter");
+
+        m.set_entry("a_string", "with \"quotes\"");
+        m.set_entry("a_bool", true);
+        m.set_entry("an_array", std::array<double, 2>{0.5, 1.25});
+        counter.set(1u);
+        m.set_entry("a_double", [](){ return 0.1; });
+
+        rm->emit_if_enabled();
+        rm->wait_for_emissions();
+        BOOST_TEST(sbuf.str() ==
+            "{\"time\":2,\"progress\":0.5,\"m\":{\"mm\":{\"counter\":1},"
+            "\"a_string\":\"with \\\"quotes\\\"\",\"a_bool\":true,"
+            "\"an_array\":[0.5,1.25],\"a_double\":0.1}}\n"
+        );
+
+        // Entries keep their position when set again
+        std::this_thread::sleep_for(5ms);
+        rm->check_timer();
+        counter.set(2u);
+        m.set_entry("a_double", std::numeric_limits<double>::infinity());
+        rm->emit_if_enabled();
+
+        // The last emission is performed when the manager is destructed
+    }
+    reinstate_cout();
+
+    BOOST_TEST(sbuf.str().substr(sbuf.str().find('\n') + 1) ==
+        "{\"time\":2,\"progress\":0.5,\"m\":{\"mm\":{\"counter\":2},"
+        "\"a_string\":\"with \\\"quotes\\\"\",\"a_bool\":true,"
+        "\"an_array\":[0.5,1.25],\"a_double\":null}}\n"
+    );
+
+    // The entries are also available as YAML
+    auto rm = std::make_shared<MonitorManager>(0.002);
+    Monitor m("m", rm);
+    m.set_entry("an_int", 3);
+    BOOST_TEST(rm->get_entries()["m"]["an_int"].as<int>() == 3);
+}